@@ -0,0 +1,159 @@
+#include "engine/hal/fiber.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+namespace ze::hal
+{
+
+struct Fiber
+{
+#if defined(__x86_64__)
+	void* stack_pointer = nullptr;
+#else
+	ucontext_t context;
+#endif
+	std::unique_ptr<uint8_t[]> stack;
+	FiberEntry entry = nullptr;
+	void* userdata = nullptr;
+};
+
+}
+
+#if defined(__x86_64__)
+
+/**
+ * Hand-written System V x86-64 context switch, only callee-saved registers and the FPU/SSE control words
+ * need to be preserved since it is a regular function call for the compiler
+ * Unlike swapcontext, this never saves/restores the signal mask which would cost two syscalls per switch
+ */
+extern "C" void ze_hal_switch_context(void** out_from_stack_pointer, void* in_to_stack_pointer);
+extern "C" void ze_hal_fiber_start();
+
+extern "C" void ze_hal_fiber_entry(ze::hal::Fiber* in_fiber)
+{
+	in_fiber->entry(in_fiber->userdata);
+	std::abort();
+}
+
+asm(R"(
+	.text
+	.globl ze_hal_switch_context
+	.type ze_hal_switch_context, @function
+ze_hal_switch_context:
+	pushq %rbp
+	pushq %rbx
+	pushq %r12
+	pushq %r13
+	pushq %r14
+	pushq %r15
+	subq $16, %rsp
+	stmxcsr 8(%rsp)
+	fnstcw 12(%rsp)
+	movq %rsp, (%rdi)
+	movq %rsi, %rsp
+	ldmxcsr 8(%rsp)
+	fldcw 12(%rsp)
+	addq $16, %rsp
+	popq %r15
+	popq %r14
+	popq %r13
+	popq %r12
+	popq %rbx
+	popq %rbp
+	ret
+	.size ze_hal_switch_context, .-ze_hal_switch_context
+
+	.globl ze_hal_fiber_start
+	.type ze_hal_fiber_start, @function
+ze_hal_fiber_start:
+	movq %rbx, %rdi
+	call ze_hal_fiber_entry@PLT
+	ud2
+	.size ze_hal_fiber_start, .-ze_hal_fiber_start
+)");
+
+#endif
+
+namespace ze::hal
+{
+
+#if !defined(__x86_64__)
+/** makecontext only forwards ints, so the fiber pointer is split in two halves */
+void fiber_trampoline(unsigned int in_low, unsigned int in_high)
+{
+	const Fiber* fiber = reinterpret_cast<Fiber*>(static_cast<uintptr_t>(in_high) << 32 | static_cast<uintptr_t>(in_low));
+	fiber->entry(fiber->userdata);
+	std::abort();
+}
+#endif
+
+Fiber* convert_thread_to_fiber()
+{
+	/** The context is filled by the first switch_to_fiber */
+	return new Fiber;
+}
+
+void convert_fiber_to_thread(Fiber* in_fiber)
+{
+	delete in_fiber;
+}
+
+Fiber* create_fiber(size_t in_stack_size, FiberEntry in_entry, void* in_userdata)
+{
+	Fiber* fiber = new Fiber;
+	fiber->stack = std::make_unique<uint8_t[]>(in_stack_size);
+	fiber->entry = in_entry;
+	fiber->userdata = in_userdata;
+
+#if defined(__x86_64__)
+	/**
+	 * Build the frame ze_hal_switch_context will pop: control words, callee-saved registers
+	 * (rbx holding the fiber) and ze_hal_fiber_start as return address
+	 * The stack is 16-byte aligned once the return address has been popped, as the ABI expects before a call
+	 */
+	const uintptr_t stack_top = (reinterpret_cast<uintptr_t>(fiber->stack.get()) + in_stack_size) & ~uintptr_t(15);
+	uint64_t* frame = reinterpret_cast<uint64_t*>(stack_top - 16 - 9 * sizeof(uint64_t));
+	frame[0] = 0;
+	frame[1] = uint64_t(0x037F) << 32 | 0x1F80; /** Default FPU control word and MXCSR */
+	frame[2] = 0; /** r15 */
+	frame[3] = 0; /** r14 */
+	frame[4] = 0; /** r13 */
+	frame[5] = 0; /** r12 */
+	frame[6] = reinterpret_cast<uint64_t>(fiber); /** rbx */
+	frame[7] = 0; /** rbp */
+	frame[8] = reinterpret_cast<uint64_t>(&ze_hal_fiber_start);
+	fiber->stack_pointer = frame;
+#else
+	getcontext(&fiber->context);
+	fiber->context.uc_stack.ss_sp = fiber->stack.get();
+	fiber->context.uc_stack.ss_size = in_stack_size;
+	fiber->context.uc_link = nullptr;
+
+	const uintptr_t address = reinterpret_cast<uintptr_t>(fiber);
+	makecontext(&fiber->context, reinterpret_cast<void(*)()>(&fiber_trampoline), 2,
+		static_cast<unsigned int>(address & 0xFFFFFFFF),
+		static_cast<unsigned int>(address >> 32));
+#endif
+
+	return fiber;
+}
+
+void destroy_fiber(Fiber* in_fiber)
+{
+	delete in_fiber;
+}
+
+void switch_to_fiber(Fiber* in_from, Fiber* in_to)
+{
+#if defined(__x86_64__)
+	ze_hal_switch_context(&in_from->stack_pointer, in_to->stack_pointer);
+#else
+	swapcontext(&in_from->context, &in_to->context);
+#endif
+}
+
+}
@@ -0,0 +1,77 @@
+#include "engine/hal/thread.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ze::hal
+{
+
+std::mutex thread_names_mutex;
+std::unordered_map<std::thread::id, std::string> thread_names;
+
+std::string get_thread_name(std::thread::id id)
+{
+	std::scoped_lock lock(thread_names_mutex);
+	if (auto it = thread_names.find(id); it != thread_names.end())
+		return it->second;
+
+	return "";
+}
+
+void set_thread_name(std::thread::id id, const std::string& in_name)
+{
+	{
+		std::scoped_lock lock(thread_names_mutex);
+		thread_names[id] = in_name;
+	}
+
+	if (id == std::this_thread::get_id())
+		pthread_setname_np(pthread_self(), in_name.substr(0, 15).c_str());
+}
+
+uint32_t get_logical_core_count()
+{
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? static_cast<uint32_t>(count) : 1;
+}
+
+bool set_current_thread_affinity(uint64_t in_mask)
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (uint32_t i = 0; i < 64; ++i)
+		if (in_mask & (uint64_t(1) << i))
+			CPU_SET(i, &set);
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool set_current_thread_priority(ThreadPriority in_priority)
+{
+	int nice_value = 0;
+	switch (in_priority)
+	{
+	case ThreadPriority::Low:
+		nice_value = 10;
+		break;
+	case ThreadPriority::Normal:
+		nice_value = 0;
+		break;
+	case ThreadPriority::High:
+		nice_value = -5;
+		break;
+	case ThreadPriority::Highest:
+		nice_value = -10;
+		break;
+	}
+
+	/** On Linux, the nice value is per-thread when targeting a thread id */
+	const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+	return setpriority(PRIO_PROCESS, tid, nice_value) == 0;
+}
+
+}
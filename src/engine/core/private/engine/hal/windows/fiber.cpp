@@ -0,0 +1,55 @@
+#include "engine/core.hpp"
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include "engine/hal/fiber.hpp"
+
+namespace ze::hal
+{
+
+struct Fiber
+{
+	LPVOID handle;
+	FiberEntry entry;
+	void* userdata;
+};
+
+VOID CALLBACK fiber_proc(LPVOID in_parameter)
+{
+	const Fiber* fiber = static_cast<Fiber*>(in_parameter);
+	fiber->entry(fiber->userdata);
+	std::abort();
+}
+
+Fiber* convert_thread_to_fiber()
+{
+	Fiber* fiber = new Fiber { nullptr, nullptr, nullptr };
+	fiber->handle = ::ConvertThreadToFiber(fiber);
+	return fiber;
+}
+
+void convert_fiber_to_thread(Fiber* in_fiber)
+{
+	::ConvertFiberToThread();
+	delete in_fiber;
+}
+
+Fiber* create_fiber(size_t in_stack_size, FiberEntry in_entry, void* in_userdata)
+{
+	Fiber* fiber = new Fiber { nullptr, in_entry, in_userdata };
+	fiber->handle = ::CreateFiber(in_stack_size, &fiber_proc, fiber);
+	return fiber;
+}
+
+void destroy_fiber(Fiber* in_fiber)
+{
+	::DeleteFiber(in_fiber->handle);
+	delete in_fiber;
+}
+
+void switch_to_fiber(Fiber* in_from, Fiber* in_to)
+{
+	(void)(in_from);
+	::SwitchToFiber(in_to->handle);
+}
+
+}
@@ -29,4 +29,36 @@ void set_thread_name(std::thread::id id, const std::string& in_name)
 	::SetThreadDescription(handle, wide_name.data());
 }
 
+uint32_t get_logical_core_count()
+{
+	return ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+}
+
+bool set_current_thread_affinity(uint64_t in_mask)
+{
+	return ::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(in_mask)) != 0;
+}
+
+bool set_current_thread_priority(ThreadPriority in_priority)
+{
+	int priority = THREAD_PRIORITY_NORMAL;
+	switch (in_priority)
+	{
+	case ThreadPriority::Low:
+		priority = THREAD_PRIORITY_BELOW_NORMAL;
+		break;
+	case ThreadPriority::Normal:
+		priority = THREAD_PRIORITY_NORMAL;
+		break;
+	case ThreadPriority::High:
+		priority = THREAD_PRIORITY_ABOVE_NORMAL;
+		break;
+	case ThreadPriority::Highest:
+		priority = THREAD_PRIORITY_HIGHEST;
+		break;
+	}
+
+	return ::SetThreadPriority(::GetCurrentThread(), priority) != 0;
+}
+
 }
\ No newline at end of file
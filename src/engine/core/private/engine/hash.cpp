@@ -0,0 +1,64 @@
+#include "engine/hash.hpp"
+#include <new>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace ze
+{
+
+static_assert(sizeof(XXH3_state_t) <= 576 && alignof(XXH3_state_t) <= 64, "Hasher state is too small for XXH3_state_t");
+
+uint64_t hash_bytes(const void* in_data, size_t in_size, uint64_t in_seed)
+{
+	return XXH3_64bits_withSeed(in_data, in_size, in_seed);
+}
+
+Hash128 hash_bytes_128(const void* in_data, size_t in_size, uint64_t in_seed)
+{
+	const XXH128_hash_t hash = XXH3_128bits_withSeed(in_data, in_size, in_seed);
+	return { hash.low64, hash.high64 };
+}
+
+void Hasher::update_state(const void* in_data, size_t in_size)
+{
+	auto* xxh_state = reinterpret_cast<XXH3_state_t*>(state);
+	if (!has_state)
+	{
+		new (state) XXH3_state_t;
+		XXH3_INITSTATE(xxh_state);
+		XXH3_128bits_reset_withSeed(xxh_state, seed);
+		has_state = true;
+	}
+
+	XXH3_128bits_update(xxh_state, buffer, buffer_size);
+	XXH3_128bits_update(xxh_state, in_data, in_size);
+	buffer_size = 0;
+}
+
+/**
+ * The 64-bit and 128-bit variants share the same streaming state, only the digest differs
+ * The state is copied so the buffer can be appended without modifying the hasher
+ */
+uint64_t Hasher::finish() const
+{
+	if (!has_state)
+		return hash_bytes(buffer, buffer_size, seed);
+
+	XXH3_state_t xxh_state = *reinterpret_cast<const XXH3_state_t*>(state);
+	XXH3_128bits_update(&xxh_state, buffer, buffer_size);
+	return XXH3_64bits_digest(&xxh_state);
+}
+
+Hash128 Hasher::finish_128() const
+{
+	if (!has_state)
+		return hash_bytes_128(buffer, buffer_size, seed);
+
+	XXH3_state_t xxh_state = *reinterpret_cast<const XXH3_state_t*>(state);
+	XXH3_128bits_update(&xxh_state, buffer, buffer_size);
+	const XXH128_hash_t hash = XXH3_128bits_digest(&xxh_state);
+	return { hash.low64, hash.high64 };
+}
+
+}
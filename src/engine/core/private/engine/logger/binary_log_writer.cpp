@@ -0,0 +1,93 @@
+#include "engine/logger/binary_log_writer.hpp"
+
+namespace ze::logger::detail
+{
+
+bool BinaryLogWriter::open(const std::string& in_path)
+{
+	close();
+
+	file.open(in_path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	write_bytes(binary_log_magic, sizeof(binary_log_magic));
+	write(binary_log_version);
+	flush();
+	return true;
+}
+
+void BinaryLogWriter::close()
+{
+	if (!file.is_open())
+		return;
+
+	flush();
+	file.close();
+	buffer.clear();
+	format_ids.clear();
+	thread_ids.clear();
+}
+
+void BinaryLogWriter::write_record(const DeferredRecord& in_record, std::string_view in_thread_name)
+{
+	const uint32_t format_id = get_format_id(*in_record.format);
+	const uint32_t thread_id = get_thread_id(in_record.thread, in_thread_name);
+
+	write(BinaryLogEntryKind::Record);
+	write(format_id);
+	write(thread_id);
+	write(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		in_record.time.time_since_epoch()).count()));
+	write(static_cast<uint32_t>(in_record.data.size()));
+	write_bytes(in_record.data.data(), in_record.data.size());
+}
+
+void BinaryLogWriter::flush()
+{
+	if (buffer.empty())
+		return;
+
+	file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	file.flush();
+	buffer.clear();
+}
+
+uint32_t BinaryLogWriter::get_format_id(const DeferredFormat& in_format)
+{
+	if (auto it = format_ids.find(&in_format); it != format_ids.end())
+		return it->second;
+
+	const uint32_t id = static_cast<uint32_t>(format_ids.size());
+	format_ids.emplace(&in_format, id);
+
+	write(BinaryLogEntryKind::Format);
+	write(id);
+	write(in_format.severity);
+	write(static_cast<uint16_t>(in_format.category.name.size()));
+	write_bytes(in_format.category.name.data(), in_format.category.name.size());
+	write(static_cast<uint32_t>(in_format.format.size()));
+	write_bytes(in_format.format.data(), in_format.format.size());
+	write(static_cast<uint8_t>(in_format.arg_types.size()));
+	write_bytes(in_format.arg_types.data(), in_format.arg_types.size());
+
+	return id;
+}
+
+uint32_t BinaryLogWriter::get_thread_id(const std::thread::id& in_thread, std::string_view in_name)
+{
+	if (auto it = thread_ids.find(in_thread); it != thread_ids.end())
+		return it->second;
+
+	const uint32_t id = static_cast<uint32_t>(thread_ids.size());
+	thread_ids.emplace(in_thread, id);
+
+	write(BinaryLogEntryKind::Thread);
+	write(id);
+	write(static_cast<uint16_t>(in_name.size()));
+	write_bytes(in_name.data(), in_name.size());
+
+	return id;
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "engine/logger/binary_log.hpp"
+#include "engine/logger/deferred_buffer.hpp"
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace ze::logger::detail
+{
+
+/**
+ * Writes deferred records to a binary log, formats and thread names are written the first time they are seen
+ * Only used by the logger thread (or with the logger drain lock held)
+ */
+class BinaryLogWriter
+{
+public:
+	bool open(const std::string& in_path);
+	void close();
+
+	void write_record(const DeferredRecord& in_record, std::string_view in_thread_name);
+
+	/** Write buffered entries to the file */
+	void flush();
+
+	[[nodiscard]] bool is_open() const { return file.is_open(); }
+private:
+	uint32_t get_format_id(const DeferredFormat& in_format);
+	uint32_t get_thread_id(const std::thread::id& in_thread, std::string_view in_name);
+
+	template<typename T>
+	void write(const T& in_value)
+	{
+		const auto* bytes = reinterpret_cast<const uint8_t*>(&in_value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	void write_bytes(const void* in_data, size_t in_size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(in_data);
+		buffer.insert(buffer.end(), bytes, bytes + in_size);
+	}
+private:
+	std::ofstream file;
+	std::vector<uint8_t> buffer;
+	std::unordered_map<const DeferredFormat*, uint32_t> format_ids;
+	std::unordered_map<std::thread::id, uint32_t> thread_ids;
+};
+
+}
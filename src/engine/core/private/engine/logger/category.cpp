@@ -0,0 +1,105 @@
+#include "engine/logger/logger.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ze::logger
+{
+
+namespace
+{
+
+struct CategoryRegistry
+{
+	std::mutex mutex;
+	std::vector<CategoryLevel*> categories;
+
+	/** Levels set by name, kept for categories of modules loaded later */
+	std::unordered_map<std::string, SeverityFlagBits> levels;
+	SeverityFlagBits default_level = SeverityFlagBits::Verbose;
+
+	SeverityFlagBits get_level(std::string_view in_name) const
+	{
+		if (auto it = levels.find(std::string(in_name)); it != levels.end())
+			return it->second;
+
+		return default_level;
+	}
+};
+
+CategoryRegistry& get_registry()
+{
+	static CategoryRegistry registry;
+	return registry;
+}
+
+}
+
+CategoryLevel::CategoryLevel(const std::string_view& in_name) : name(in_name)
+{
+	CategoryRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	min_severity.store(registry.get_level(name), std::memory_order_relaxed);
+	registry.categories.emplace_back(this);
+}
+
+CategoryLevel::~CategoryLevel()
+{
+	CategoryRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	std::erase(registry.categories, this);
+}
+
+void set_category_level(std::string_view in_name, SeverityFlagBits in_severity)
+{
+	CategoryRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	registry.levels[std::string(in_name)] = in_severity;
+	for (CategoryLevel* category : registry.categories)
+		if (category->get_name() == in_name)
+			category->set_min_severity(in_severity);
+}
+
+void set_default_level(SeverityFlagBits in_severity)
+{
+	CategoryRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	registry.default_level = in_severity;
+	for (CategoryLevel* category : registry.categories)
+		category->set_min_severity(registry.get_level(category->get_name()));
+}
+
+bool parse_levels(std::string_view in_levels)
+{
+	bool valid = true;
+	while (!in_levels.empty())
+	{
+		const size_t comma = in_levels.find(',');
+		const std::string_view entry = in_levels.substr(0, comma);
+		in_levels = comma == std::string_view::npos ? std::string_view() : in_levels.substr(comma + 1);
+
+		if (entry.empty())
+			continue;
+
+		const size_t equal = entry.find('=');
+		SeverityFlagBits severity = SeverityFlagBits::Verbose;
+		if (equal == std::string_view::npos)
+		{
+			if (detail::string_to_severity(entry, severity))
+				set_default_level(severity);
+			else
+				valid = false;
+		}
+		else
+		{
+			if (equal != 0 && detail::string_to_severity(entry.substr(equal + 1), severity))
+				set_category_level(entry.substr(0, equal), severity);
+			else
+				valid = false;
+		}
+	}
+
+	return valid;
+}
+
+}
@@ -0,0 +1,242 @@
+#include "engine/logger/deferred_buffer.hpp"
+#include "engine/memory/tracking.hpp"
+#include <mutex>
+#include <vector>
+#include <fmt/args.h>
+
+namespace ze::logger::detail
+{
+
+namespace
+{
+
+struct DeferredBufferRegistry
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<DeferredBuffer>> buffers;
+};
+
+DeferredBufferRegistry& get_registry()
+{
+	static DeferredBufferRegistry registry;
+	return registry;
+}
+
+/** The buffer is kept alive until the logger thread has drained it */
+struct DeferredBufferReleaser
+{
+	DeferredBuffer* buffer = nullptr;
+
+	~DeferredBufferReleaser()
+	{
+		if (buffer)
+			buffer->orphaned.store(true, std::memory_order_release);
+		buffer = nullptr;
+	}
+};
+
+thread_local DeferredBufferReleaser thread_buffer;
+
+DeferredBuffer& get_thread_buffer()
+{
+	if (!thread_buffer.buffer) [[unlikely]]
+	{
+		memory::ScopedTag tag(MemoryTag::Logger);
+		auto buffer = std::make_unique<DeferredBuffer>();
+		thread_buffer.buffer = buffer.get();
+
+		DeferredBufferRegistry& registry = get_registry();
+		std::scoped_lock lock(registry.mutex);
+		registry.buffers.emplace_back(std::move(buffer));
+	}
+
+	return *thread_buffer.buffer;
+}
+
+constexpr size_t align_record_size(const size_t in_size)
+{
+	return (in_size + 7) & ~size_t(7);
+}
+
+}
+
+uint8_t* DeferredBuffer::begin_record(const DeferredFormat& in_format, size_t in_arg_size)
+{
+	const size_t size = align_record_size(sizeof(DeferredRecordHeader) + in_arg_size);
+	if (size > capacity / 2)
+		return nullptr;
+
+	size_t position = write_position.load(std::memory_order_relaxed);
+	const size_t offset = position & (capacity - 1);
+	const size_t padding = capacity - offset < size ? capacity - offset : 0;
+
+	if (position + padding + size - cached_read_position > capacity)
+	{
+		cached_read_position = read_position.load(std::memory_order_acquire);
+		if (position + padding + size - cached_read_position > capacity)
+			return nullptr;
+	}
+
+	/** The reader skips the end of the buffer by itself when a header doesn't fit */
+	if (padding >= sizeof(DeferredRecordHeader))
+	{
+		auto* header = reinterpret_cast<DeferredRecordHeader*>(get_data() + offset);
+		header->format = nullptr;
+		header->size = static_cast<uint32_t>(padding);
+	}
+
+	position += padding;
+	auto* header = reinterpret_cast<DeferredRecordHeader*>(get_data() + (position & (capacity - 1)));
+	header->format = &in_format;
+	header->time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+	header->size = static_cast<uint32_t>(size);
+	header->arg_size = static_cast<uint32_t>(in_arg_size);
+
+	pending_write_position = position + size;
+	return reinterpret_cast<uint8_t*>(header + 1);
+}
+
+void DeferredBuffer::end_record()
+{
+	write_position.store(pending_write_position, std::memory_order_release);
+}
+
+uint8_t* begin_deferred_record(const DeferredFormat& in_format, size_t in_size)
+{
+	uint8_t* data = get_thread_buffer().begin_record(in_format, in_size);
+	if (!data)
+		notify_dropped_message();
+
+	return data;
+}
+
+void end_deferred_record()
+{
+	get_thread_buffer().end_record();
+	notify_deferred_record();
+}
+
+void drain_deferred_buffers(const std::function<void(const DeferredRecord&)>& in_function)
+{
+	DeferredBufferRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+
+	for (auto it = registry.buffers.begin(); it != registry.buffers.end();)
+	{
+		DeferredBuffer& buffer = **it;
+
+		/** Checked before draining so records written right before the thread exited are not lost */
+		const bool orphaned = buffer.orphaned.load(std::memory_order_acquire);
+		buffer.drain(in_function);
+
+		if (orphaned)
+			it = registry.buffers.erase(it);
+		else
+			++it;
+	}
+}
+
+bool has_deferred_records()
+{
+	DeferredBufferRegistry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+
+	for (const auto& buffer : registry.buffers)
+		if (!buffer->is_empty() || buffer->orphaned.load(std::memory_order_relaxed))
+			return true;
+
+	return false;
+}
+
+bool format_deferred(std::string_view in_format, std::span<const DeferredArgType> in_arg_types,
+	std::span<const uint8_t> in_data, std::string& out_message)
+{
+	fmt::dynamic_format_arg_store<fmt::format_context> args;
+	args.reserve(in_arg_types.size(), 0);
+
+	size_t offset = 0;
+	const auto read = [&]<typename T>(T& out_value)
+	{
+		if (in_data.size() - offset < sizeof(T))
+			return false;
+
+		std::memcpy(&out_value, in_data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	};
+
+	for (const DeferredArgType type : in_arg_types)
+	{
+		switch (type)
+		{
+		case DeferredArgType::Bool:
+		{
+			uint8_t value = 0;
+			if (!read(value))
+				return false;
+			args.push_back(value != 0);
+			break;
+		}
+		case DeferredArgType::Char:
+		{
+			char value = 0;
+			if (!read(value))
+				return false;
+			args.push_back(value);
+			break;
+		}
+		case DeferredArgType::Int:
+		{
+			int64_t value = 0;
+			if (!read(value))
+				return false;
+			args.push_back(value);
+			break;
+		}
+		case DeferredArgType::UInt:
+		{
+			uint64_t value = 0;
+			if (!read(value))
+				return false;
+			args.push_back(value);
+			break;
+		}
+		case DeferredArgType::Double:
+		{
+			double value = 0.0;
+			if (!read(value))
+				return false;
+			args.push_back(value);
+			break;
+		}
+		case DeferredArgType::String:
+		{
+			uint32_t size = 0;
+			if (!read(size) || in_data.size() - offset < size)
+				return false;
+
+			/** in_data outlives the formatting, no need to copy the string */
+			args.push_back(std::string_view(reinterpret_cast<const char*>(in_data.data() + offset), size));
+			offset += size;
+			break;
+		}
+		case DeferredArgType::Pointer:
+		{
+			uint64_t value = 0;
+			if (!read(value))
+				return false;
+			args.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+
+	out_message.clear();
+	fmt::vformat_to(std::back_inserter(out_message), fmt::string_view(in_format.data(), in_format.size()), args);
+	return true;
+}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "engine/logger/deferred.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace ze::logger::detail
+{
+
+struct DeferredRecordHeader
+{
+	/** nullptr marks padding up to the end of the buffer */
+	const DeferredFormat* format;
+	int64_t time_ns;
+
+	/** Header and arguments, rounded up to a multiple of 8 */
+	uint32_t size;
+	uint32_t arg_size;
+};
+
+struct DeferredRecord
+{
+	const DeferredFormat* format;
+	std::chrono::system_clock::time_point time;
+	std::thread::id thread;
+	std::span<const uint8_t> data;
+};
+
+/**
+ * SPSC ring of deferred records, written by its thread and read by the logger thread
+ * Records never wrap around, the space left at the end of the buffer is skipped instead
+ */
+class DeferredBuffer
+{
+public:
+	static constexpr size_t capacity = 64 * 1024;
+
+	DeferredBuffer() : thread(std::this_thread::get_id()), orphaned(false),
+		data(std::make_unique<uint64_t[]>(capacity / sizeof(uint64_t))),
+		write_position(0), pending_write_position(0), cached_read_position(0), read_position(0) {}
+
+	/** Called by the buffer thread */
+	uint8_t* begin_record(const DeferredFormat& in_format, size_t in_arg_size);
+	void end_record();
+
+	/** Called by the logger thread */
+	template<typename F>
+	void drain(F&& in_function)
+	{
+		size_t position = read_position.load(std::memory_order_relaxed);
+		const size_t end = write_position.load(std::memory_order_acquire);
+		while (position != end)
+		{
+			const size_t offset = position & (capacity - 1);
+			if (capacity - offset < sizeof(DeferredRecordHeader))
+			{
+				position += capacity - offset;
+				continue;
+			}
+
+			const auto* header = reinterpret_cast<const DeferredRecordHeader*>(get_data() + offset);
+			if (header->format)
+			{
+				in_function(DeferredRecord { header->format,
+					std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+						std::chrono::nanoseconds(header->time_ns))),
+					thread,
+					std::span<const uint8_t>(get_data() + offset + sizeof(DeferredRecordHeader), header->arg_size) });
+			}
+
+			position += header->size;
+		}
+
+		read_position.store(position, std::memory_order_release);
+	}
+
+	[[nodiscard]] bool is_empty() const
+	{
+		return read_position.load(std::memory_order_relaxed) == write_position.load(std::memory_order_acquire);
+	}
+
+	const std::thread::id thread;
+
+	/** Set once the thread has exited, the buffer is freed after being drained */
+	std::atomic_bool orphaned;
+private:
+	uint8_t* get_data() const { return reinterpret_cast<uint8_t*>(data.get()); }
+private:
+	std::unique_ptr<uint64_t[]> data;
+
+	alignas(std::hardware_destructive_interference_size) std::atomic_size_t write_position;
+	size_t pending_write_position;
+	size_t cached_read_position;
+
+	alignas(std::hardware_destructive_interference_size) std::atomic_size_t read_position;
+};
+
+/**
+ * Drain the buffers of every thread, only called by the thread holding the logger drain lock
+ */
+void drain_deferred_buffers(const std::function<void(const DeferredRecord&)>& in_function);
+[[nodiscard]] bool has_deferred_records();
+
+/** Implemented by the logger */
+void notify_deferred_record();
+void notify_dropped_message();
+
+}
@@ -1,10 +1,17 @@
 #include "engine/logger/logger.hpp"
 #include "engine/platform_macros.hpp"
 #include "engine/logger/sink.hpp"
+#include "engine/logger/binary_log_writer.hpp"
+#include "engine/logger/deferred_buffer.hpp"
+#include "engine/memory/tracking.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <thread>
 #include <iomanip>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <fmt/format-inl.h>
 #include "engine/hal/thread.hpp"
 #if ZE_PLATFORM(WINDOWS)
@@ -15,8 +22,6 @@
 namespace ze::logger
 {
 
-std::mutex log_mutex;
-
 namespace detail
 {
 
@@ -38,6 +43,21 @@ std::string_view severity_to_string(SeverityFlagBits in_severity)
 	}
 }
 
+bool string_to_severity(std::string_view in_string, SeverityFlagBits& out_severity)
+{
+	for (const SeverityFlagBits severity : { SeverityFlagBits::Verbose, SeverityFlagBits::Info, SeverityFlagBits::Warn,
+		SeverityFlagBits::Error, SeverityFlagBits::Fatal })
+	{
+		if (severity_to_string(severity) == in_string)
+		{
+			out_severity = severity;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 std::string format_message(const std::string& in_pattern, const Message& in_message)
 {
 	const std::time_t time = std::chrono::system_clock::to_time_t(in_message.time);
@@ -55,48 +75,510 @@ std::string format_message(const std::string& in_pattern, const Message& in_mess
 
 	return fmt::format(fmt::runtime(in_pattern), fmt::arg("time", time_str),
 		fmt::arg("severity", severity_to_string(in_message.severity)),
-		fmt::arg("thread", hal::get_thread_name(in_message.thread)),
+		fmt::arg("thread", in_message.thread_name),
 		fmt::arg("category", in_message.category.name),
 		fmt::arg("message", in_message.message));
 }
 
 }
 
-std::vector<std::unique_ptr<Sink>> sinks;
-std::string pattern;
+namespace
+{
 
-void add_sink(std::unique_ptr<Sink>&& in_sink)
+/** Power of two so a position maps to a record with a mask */
+static constexpr size_t queue_capacity = 4096;
+
+static constexpr size_t record_size = 256;
+
+struct RecordHeader
 {
-	in_sink->set_pattern(pattern);
-	sinks.emplace_back(std::move(in_sink));
-}
+	/**
+	 * Tells who owns the record:
+	 * - sequence == position: free, the producer that claims position may write it
+	 * - sequence == position + 1: written, the logger thread may read it
+	 */
+	std::atomic_size_t sequence;
+	std::chrono::system_clock::time_point time;
+	Category category;
 
-void set_pattern(const std::string& in_pattern)
+	/** Messages that don't fit in the record are copied on the heap */
+	char* heap_text;
+	std::thread::id thread;
+	uint32_t length;
+	SeverityFlagBits severity;
+};
+
+/** A queued message, filling a whole number of cache lines */
+struct alignas(std::hardware_destructive_interference_size) Record : RecordHeader
 {
-	pattern = in_pattern;
-	for(const auto& sink : sinks)
-		sink->set_pattern(pattern);
-}
+	static constexpr size_t inline_text_size = record_size - sizeof(RecordHeader);
+	char inline_text[inline_text_size];
+
+	[[nodiscard]] std::string_view get_text() const
+	{
+		return { heap_text ? heap_text : inline_text, length };
+	}
+};
 
-void log(SeverityFlagBits in_severity, const Category& in_category, const std::string& in_message)
+enum class WorkerState : uint8_t
 {
-	Message message;
-	message.time = std::chrono::system_clock::now();
-	message.thread = std::this_thread::get_id();
-	message.severity = in_severity;
-	message.category = in_category;
-	message.message = in_message;
+	Running,
+	Sleeping,
+	Notified,
+};
+
+/**
+ * Bounded MPSC queue (a Vyukov ring) drained by a dedicated thread
+ * Producers only claim a position with a CAS and publish the record, sinks are only called from the logger thread
+ * (or synchronously once it is stopped) so workers never serialize on a lock to log
+ */
+class Logger
+{
+public:
+	Logger() : records(std::make_unique<Record[]>(queue_capacity)),
+		enqueue_position(0), dequeue_position(0), written_position(0), flush_requests(0), completed_flush_requests(0),
+		drain_count(0), flush_waiters(0), dropped_messages(0),
+		worker_state(WorkerState::Running), started(false), stop_requested(false)
+	{
+		for (size_t i = 0; i < queue_capacity; ++i)
+			records[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~Logger()
+	{
+		shutdown();
+	}
+
+	void log(SeverityFlagBits in_severity, const Category& in_category, std::string_view in_message)
+	{
+		const auto time = std::chrono::system_clock::now();
+
+		if (in_severity == SeverityFlagBits::Fatal)
+		{
+			/** Everything logged before must be visible before the program dies */
+			flush();
+			write_fatal(time, in_category, in_message);
+		}
+
+		if (!ensure_worker())
+		{
+			std::scoped_lock lock(drain_mutex);
+			write(time, std::this_thread::get_id(), in_severity, in_category, in_message);
+			return;
+		}
 
-	std::scoped_lock lock(log_mutex);
-	for(const auto& sink : sinks)
+		if (!enqueue(time, in_severity, in_category, in_message))
+		{
+			dropped_messages.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		wake_worker();
+	}
+
+	void notify_deferred_record()
 	{
-		sink->log(message);
-		if(in_severity == SeverityFlagBits::Fatal)
+		if (ensure_worker())
+		{
+			wake_worker();
+		}
+		else
 		{
-			MessageBoxA(nullptr, in_message.c_str(), "Fatal Error", MB_OK | MB_ICONERROR);
-			std::terminate();
+			std::scoped_lock lock(drain_mutex);
+			drain_deferred();
 		}
 	}
+
+	void notify_dropped_message()
+	{
+		dropped_messages.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void flush()
+	{
+		if (!started.load(std::memory_order_acquire) || std::this_thread::get_id() == worker.get_id())
+			return;
+
+		/** Positions before this one are either written or being written by producers that already claimed them */
+		const size_t target = enqueue_position.load(std::memory_order_acquire);
+
+		/** Deferred buffers are drained entirely by the first drain starting after the request */
+		const uint64_t request = flush_requests.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+		flush_waiters.fetch_add(1, std::memory_order_seq_cst);
+		wake_worker();
+		while (started.load(std::memory_order_acquire))
+		{
+			const uint64_t count = drain_count.load(std::memory_order_acquire);
+			if (written_position.load(std::memory_order_acquire) >= target &&
+				completed_flush_requests.load(std::memory_order_acquire) >= request)
+				break;
+
+			drain_count.wait(count, std::memory_order_acquire);
+		}
+		flush_waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void shutdown()
+	{
+		std::scoped_lock lock(lifecycle_mutex);
+		if (!worker.joinable())
+			return;
+
+		stop_requested.store(true, std::memory_order_seq_cst);
+		wake_worker();
+		worker.join();
+		started.store(false, std::memory_order_release);
+
+		/** Catch records of producers that checked the logger was running just before it stopped */
+		drain();
+		drain_count.fetch_add(1, std::memory_order_release);
+		drain_count.notify_all();
+
+		std::scoped_lock drain_lock(drain_mutex);
+		binary_log.close();
+	}
+
+	bool open_binary_log(const std::string& in_path)
+	{
+		std::scoped_lock lock(drain_mutex);
+		drain_deferred();
+		return binary_log.open(in_path);
+	}
+
+	void close_binary_log()
+	{
+		std::scoped_lock lock(drain_mutex);
+		drain_deferred();
+		binary_log.close();
+	}
+
+	void add_sink(std::unique_ptr<Sink>&& in_sink)
+	{
+		std::scoped_lock lock(drain_mutex);
+		in_sink->set_pattern(pattern);
+		sinks.emplace_back(std::move(in_sink));
+	}
+
+	void set_pattern(const std::string& in_pattern)
+	{
+		std::scoped_lock lock(drain_mutex);
+		pattern = in_pattern;
+		for(const auto& sink : sinks)
+			sink->set_pattern(pattern);
+	}
+
+	[[nodiscard]] uint64_t get_dropped_message_count() const
+	{
+		return dropped_messages.load(std::memory_order_relaxed);
+	}
+private:
+	/**
+	 * Start the logger thread on first use
+	 * \return False once the logger has been shut down
+	 */
+	bool ensure_worker()
+	{
+		if (started.load(std::memory_order_acquire)) [[likely]]
+			return true;
+
+		std::scoped_lock lock(lifecycle_mutex);
+		if (stop_requested.load(std::memory_order_relaxed))
+			return false;
+
+		if (!started.load(std::memory_order_relaxed))
+		{
+			worker = std::thread([this]() { run(); });
+			started.store(true, std::memory_order_release);
+		}
+
+		return true;
+	}
+
+	bool enqueue(const std::chrono::system_clock::time_point& in_time, SeverityFlagBits in_severity,
+		const Category& in_category, std::string_view in_message)
+	{
+		size_t position = enqueue_position.load(std::memory_order_relaxed);
+		Record* record = nullptr;
+		while (true)
+		{
+			record = &records[position & (queue_capacity - 1)];
+			const size_t sequence = record->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+			if (diff == 0)
+			{
+				if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				/** The logger thread hasn't consumed this record yet, the queue is full */
+				return false;
+			}
+			else
+			{
+				position = enqueue_position.load(std::memory_order_relaxed);
+			}
+		}
+
+		record->time = in_time;
+		record->thread = std::this_thread::get_id();
+		record->severity = in_severity;
+		record->category = in_category;
+		record->length = static_cast<uint32_t>(in_message.size());
+		record->heap_text = nullptr;
+		if (in_message.size() > Record::inline_text_size)
+		{
+			memory::ScopedTag tag(MemoryTag::Logger);
+			record->heap_text = new char[in_message.size()];
+		}
+		std::memcpy(record->heap_text ? record->heap_text : record->inline_text, in_message.data(), in_message.size());
+
+		record->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Same handshake as the job system parker: the seq_cst fences pair with the one in run() */
+	void wake_worker()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		WorkerState expected = WorkerState::Sleeping;
+		if (worker_state.load(std::memory_order_relaxed) == WorkerState::Sleeping &&
+			worker_state.compare_exchange_strong(expected, WorkerState::Notified))
+			worker_state.notify_one();
+	}
+
+	[[nodiscard]] bool has_pending_records() const
+	{
+		const Record& record = records[dequeue_position & (queue_capacity - 1)];
+		return record.sequence.load(std::memory_order_acquire) == dequeue_position + 1;
+	}
+
+	void run()
+	{
+		hal::set_thread_name(std::this_thread::get_id(), "Logger");
+		memory::ScopedTag tag(MemoryTag::Logger);
+
+		while (true)
+		{
+			drain();
+
+			if (stop_requested.load(std::memory_order_acquire))
+			{
+				/** Producers that claimed a position before the stop will publish it shortly */
+				while (dequeue_position != enqueue_position.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+					drain();
+				}
+				return;
+			}
+
+			worker_state.store(WorkerState::Sleeping, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (has_pending_records() || detail::has_deferred_records() ||
+				flush_requests.load(std::memory_order_relaxed) != completed_flush_requests.load(std::memory_order_relaxed) ||
+				stop_requested.load(std::memory_order_relaxed))
+			{
+				worker_state.store(WorkerState::Running, std::memory_order_relaxed);
+				continue;
+			}
+
+			worker_state.wait(WorkerState::Sleeping, std::memory_order_acquire);
+			worker_state.store(WorkerState::Running, std::memory_order_relaxed);
+		}
+	}
+
+	void drain()
+	{
+		std::scoped_lock lock(drain_mutex);
+		const uint64_t requested_flushes = flush_requests.load(std::memory_order_acquire);
+
+		while (has_pending_records())
+		{
+			Record& record = records[dequeue_position & (queue_capacity - 1)];
+			write(record.time, record.thread, record.severity, record.category, record.get_text());
+			delete[] record.heap_text;
+
+			record.sequence.store(dequeue_position + queue_capacity, std::memory_order_release);
+			dequeue_position++;
+		}
+
+		drain_deferred();
+
+		written_position.store(dequeue_position, std::memory_order_release);
+		completed_flush_requests.store(requested_flushes, std::memory_order_release);
+		drain_count.fetch_add(1, std::memory_order_seq_cst);
+		if (flush_waiters.load(std::memory_order_relaxed) != 0)
+			drain_count.notify_all();
+	}
+
+	/**
+	 * Format deferred records, or write them to the binary log when it is open
+	 * drain_mutex must be held
+	 */
+	void drain_deferred()
+	{
+		detail::drain_deferred_buffers([&](const detail::DeferredRecord& in_record)
+		{
+			if (binary_log.is_open())
+			{
+				binary_log.write_record(in_record, get_thread_name(in_record.thread));
+			}
+			else if (detail::format_deferred(in_record.format->format, in_record.format->arg_types, in_record.data,
+				deferred_text))
+			{
+				write(in_record.time, in_record.thread, in_record.format->severity, in_record.format->category,
+					deferred_text);
+			}
+		});
+
+		binary_log.flush();
+	}
+
+	/** drain_mutex must be held */
+	void write(const std::chrono::system_clock::time_point& in_time, const std::thread::id& in_thread,
+		SeverityFlagBits in_severity, const Category& in_category, std::string_view in_text)
+	{
+		message.time = in_time;
+		message.thread = in_thread;
+		message.thread_name = get_thread_name(in_thread);
+		message.severity = in_severity;
+		message.category = in_category;
+		message.message.assign(in_text);
+
+		for(const auto& sink : sinks)
+			sink->log(message);
+	}
+
+	[[noreturn]] void write_fatal(const std::chrono::system_clock::time_point& in_time, const Category& in_category,
+		std::string_view in_message)
+	{
+		/** A sink logging a fatal error already holds the lock */
+		if (std::this_thread::get_id() == worker.get_id())
+		{
+			write(in_time, std::this_thread::get_id(), SeverityFlagBits::Fatal, in_category, in_message);
+		}
+		else
+		{
+			std::scoped_lock lock(drain_mutex);
+			write(in_time, std::this_thread::get_id(), SeverityFlagBits::Fatal, in_category, in_message);
+			binary_log.close();
+		}
+
+#if ZE_PLATFORM(WINDOWS)
+		const std::string text(in_message);
+		MessageBoxA(nullptr, text.c_str(), "Fatal Error", MB_OK | MB_ICONERROR);
+#endif
+		std::terminate();
+	}
+
+	/**
+	 * Thread names are only queried once per thread, querying them is a system call on some platforms
+	 * drain_mutex must be held
+	 */
+	std::string_view get_thread_name(const std::thread::id& in_thread)
+	{
+		auto it = thread_names.find(in_thread);
+		if (it == thread_names.end())
+			it = thread_names.emplace(in_thread, hal::get_thread_name(in_thread)).first;
+
+		return it->second;
+	}
+private:
+	std::unique_ptr<Record[]> records;
+	alignas(std::hardware_destructive_interference_size) std::atomic_size_t enqueue_position;
+
+	/** Only accessed by the thread holding drain_mutex */
+	alignas(std::hardware_destructive_interference_size) size_t dequeue_position;
+	std::atomic_size_t written_position;
+	std::atomic_uint64_t flush_requests;
+	std::atomic_uint64_t completed_flush_requests;
+
+	/** Incremented after every drain, flush waits on it */
+	std::atomic_uint64_t drain_count;
+	std::atomic_uint32_t flush_waiters;
+	std::atomic_uint64_t dropped_messages;
+	std::atomic<WorkerState> worker_state;
+
+	std::mutex lifecycle_mutex;
+	std::thread worker;
+	std::atomic_bool started;
+	std::atomic_bool stop_requested;
+
+	std::mutex drain_mutex;
+	std::vector<std::unique_ptr<Sink>> sinks;
+	std::string pattern;
+	Message message;
+	std::unordered_map<std::thread::id, std::string> thread_names;
+	std::string deferred_text;
+	detail::BinaryLogWriter binary_log;
+};
+
+static_assert(sizeof(Record) == record_size);
+
+Logger& get_logger()
+{
+	static Logger logger;
+	return logger;
+}
+
+}
+
+void add_sink(std::unique_ptr<Sink>&& in_sink)
+{
+	get_logger().add_sink(std::move(in_sink));
+}
+
+void set_pattern(const std::string& in_pattern)
+{
+	get_logger().set_pattern(in_pattern);
+}
+
+void log(SeverityFlagBits in_severity, const Category& in_category, std::string_view in_message)
+{
+	get_logger().log(in_severity, in_category, in_message);
+}
+
+void flush()
+{
+	get_logger().flush();
+}
+
+void shutdown()
+{
+	get_logger().shutdown();
+}
+
+uint64_t get_dropped_message_count()
+{
+	return get_logger().get_dropped_message_count();
+}
+
+bool open_binary_log(const std::string& in_path)
+{
+	return get_logger().open_binary_log(in_path);
+}
+
+void close_binary_log()
+{
+	get_logger().close_binary_log();
+}
+
+namespace detail
+{
+
+void notify_deferred_record()
+{
+	get_logger().notify_deferred_record();
+}
+
+void notify_dropped_message()
+{
+	get_logger().notify_dropped_message();
+}
+
+}
+
 }
-	
-}
\ No newline at end of file
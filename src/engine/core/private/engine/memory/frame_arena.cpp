@@ -0,0 +1,124 @@
+#include "engine/memory/frame_arena.hpp"
+#include "engine/util/thread_index.hpp"
+#include <algorithm>
+
+namespace ze
+{
+
+static constexpr size_t block_alignment = std::hardware_destructive_interference_size;
+
+FrameArena::FrameArena(const size_t in_block_size, const MemoryTag in_tag) : block_size(in_block_size), tag(in_tag), epoch(1),
+	block_allocation_count(0), thread_states(std::make_unique<ThreadState[]>(max_thread_states)) {}
+
+FrameArena::~FrameArena()
+{
+	auto free_blocks = [&](ThreadState& in_state)
+	{
+		for (const Block& block : in_state.blocks)
+			memory::deallocate(block.memory, block.size, block_alignment, tag);
+	};
+
+	for (uint32_t i = 0; i < max_thread_states; ++i)
+		free_blocks(thread_states[i]);
+
+	free_blocks(shared_state);
+}
+
+void* FrameArena::allocate(const size_t in_size, const size_t in_alignment)
+{
+	const uint32_t thread_idx = get_thread_index();
+	if (thread_idx < max_thread_states) [[likely]]
+		return allocate_from(thread_states[thread_idx], in_size, in_alignment);
+
+	std::scoped_lock lock(shared_state_mutex);
+	return allocate_from(shared_state, in_size, in_alignment);
+}
+
+void* FrameArena::allocate_from(ThreadState& in_state, const size_t in_size, const size_t in_alignment)
+{
+	const uint64_t current_epoch = epoch.load(std::memory_order_acquire);
+	if (in_state.epoch.load(std::memory_order_relaxed) != current_epoch)
+		rewind(in_state, current_epoch);
+
+	while (true)
+	{
+		const uintptr_t address = (reinterpret_cast<uintptr_t>(in_state.cursor) + in_alignment - 1) & ~(in_alignment - 1);
+		uint8_t* memory = reinterpret_cast<uint8_t*>(address);
+		if (in_state.cursor && memory + in_size <= in_state.end)
+		{
+			in_state.cursor = memory + in_size;
+			in_state.used_bytes.store(in_state.used_bytes.load(std::memory_order_relaxed) + in_size,
+				std::memory_order_relaxed);
+			return memory;
+		}
+
+		next_block(in_state, in_size + in_alignment);
+	}
+}
+
+void FrameArena::rewind(ThreadState& in_state, const uint64_t in_epoch)
+{
+	in_state.epoch.store(in_epoch, std::memory_order_relaxed);
+	in_state.block_idx = 0;
+	in_state.cursor = in_state.blocks.empty() ? nullptr : in_state.blocks[0].memory;
+	in_state.end = in_state.blocks.empty() ? nullptr : in_state.blocks[0].memory + in_state.blocks[0].size;
+	in_state.used_bytes.store(0, std::memory_order_relaxed);
+}
+
+/** Move to the next block able to hold in_min_size bytes, allocating it if the thread has none left */
+void FrameArena::next_block(ThreadState& in_state, const size_t in_min_size)
+{
+	size_t next_idx = in_state.cursor ? in_state.block_idx + 1 : 0;
+	while (next_idx < in_state.blocks.size() && in_state.blocks[next_idx].size < in_min_size)
+		next_idx++;
+
+	if (next_idx == in_state.blocks.size())
+	{
+		const size_t size = std::max(block_size, in_min_size);
+		uint8_t* block_memory = static_cast<uint8_t*>(memory::allocate(size, block_alignment, tag));
+		ZE_ASSERTF(block_memory, "Out of memory while allocating a frame arena block of {} bytes", size);
+		in_state.blocks.push_back({ block_memory, size });
+		block_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	in_state.block_idx = next_idx;
+	in_state.cursor = in_state.blocks[next_idx].memory;
+	in_state.end = in_state.cursor + in_state.blocks[next_idx].size;
+}
+
+void FrameArena::reset()
+{
+	epoch.fetch_add(1, std::memory_order_release);
+}
+
+size_t FrameArena::get_used_bytes() const
+{
+	const uint64_t current_epoch = epoch.load(std::memory_order_acquire);
+
+	size_t bytes = 0;
+	auto add_state = [&](const ThreadState& in_state)
+	{
+		if (in_state.epoch.load(std::memory_order_relaxed) == current_epoch)
+			bytes += in_state.used_bytes.load(std::memory_order_relaxed);
+	};
+
+	for (uint32_t i = 0; i < max_thread_states; ++i)
+		add_state(thread_states[i]);
+
+	add_state(shared_state);
+	return bytes;
+}
+
+FrameArena& get_frame_arena()
+{
+	static FrameArena arena;
+	return arena;
+}
+
+std::pmr::memory_resource* get_frame_memory_resource()
+{
+	static FrameMemoryResource resource(get_frame_arena());
+	return &resource;
+}
+
+}
@@ -0,0 +1,112 @@
+#include "engine/memory/tracking.hpp"
+
+#if ZE_FEATURE(MEMORY_TRACKING)
+
+#include "engine/memory/platform_allocator.hpp"
+#include <cstdlib>
+#include <new>
+#if ZE_FEATURE(MEMORY_PROFILING)
+#include <Tracy.hpp>
+#endif
+
+/**
+ * Global new/delete accounting every allocation to the current tag of the allocating thread
+ * The size and tag are stored in a header before the returned pointer, so the free goes to the same tag
+ */
+
+namespace
+{
+
+struct AllocationHeader
+{
+	size_t size;
+	ze::MemoryTag tag;
+};
+
+static constexpr size_t header_size = 16;
+static_assert(sizeof(AllocationHeader) <= header_size);
+
+size_t get_header_offset(const size_t in_alignment)
+{
+	return std::max(header_size, in_alignment);
+}
+
+AllocationHeader* get_header(void* in_ptr)
+{
+	return reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(in_ptr) - header_size);
+}
+
+void* tracked_allocate(const size_t in_size, const size_t in_alignment)
+{
+	const size_t offset = get_header_offset(in_alignment);
+	void* base = ze::memory::detail::platform_allocate(in_size + offset, std::max(in_alignment, header_size));
+	if (!base)
+		return nullptr;
+
+	void* ptr = static_cast<uint8_t*>(base) + offset;
+	AllocationHeader* header = get_header(ptr);
+	header->size = in_size;
+	header->tag = ze::memory::get_current_tag();
+	ze::memory::track_allocation(header->tag, in_size);
+#if ZE_FEATURE(MEMORY_PROFILING)
+	TracyAllocN(ptr, in_size, std::to_string(header->tag).data());
+#endif
+	return ptr;
+}
+
+void* tracked_allocate_or_abort(const size_t in_size, const size_t in_alignment)
+{
+	/** Exceptions are disabled, so there is no bad_alloc to throw */
+	while (true)
+	{
+		if (void* ptr = tracked_allocate(in_size, in_alignment))
+			return ptr;
+
+		std::new_handler handler = std::get_new_handler();
+		if (!handler)
+			std::abort();
+
+		handler();
+	}
+}
+
+void tracked_free(void* in_ptr, const size_t in_alignment)
+{
+	if (!in_ptr)
+		return;
+
+	const AllocationHeader* header = get_header(in_ptr);
+#if ZE_FEATURE(MEMORY_PROFILING)
+	TracyFreeN(in_ptr, std::to_string(header->tag).data());
+#endif
+	ze::memory::track_free(header->tag, header->size);
+	ze::memory::detail::platform_free(static_cast<uint8_t*>(in_ptr) - get_header_offset(in_alignment), in_alignment);
+}
+
+static constexpr size_t default_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+}
+
+void* operator new(size_t in_size) { return tracked_allocate_or_abort(in_size, default_alignment); }
+void* operator new[](size_t in_size) { return tracked_allocate_or_abort(in_size, default_alignment); }
+void* operator new(size_t in_size, const std::nothrow_t&) noexcept { return tracked_allocate(in_size, default_alignment); }
+void* operator new[](size_t in_size, const std::nothrow_t&) noexcept { return tracked_allocate(in_size, default_alignment); }
+void* operator new(size_t in_size, std::align_val_t in_alignment) { return tracked_allocate_or_abort(in_size, static_cast<size_t>(in_alignment)); }
+void* operator new[](size_t in_size, std::align_val_t in_alignment) { return tracked_allocate_or_abort(in_size, static_cast<size_t>(in_alignment)); }
+void* operator new(size_t in_size, std::align_val_t in_alignment, const std::nothrow_t&) noexcept { return tracked_allocate(in_size, static_cast<size_t>(in_alignment)); }
+void* operator new[](size_t in_size, std::align_val_t in_alignment, const std::nothrow_t&) noexcept { return tracked_allocate(in_size, static_cast<size_t>(in_alignment)); }
+
+void operator delete(void* in_ptr) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete[](void* in_ptr) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete(void* in_ptr, size_t) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete[](void* in_ptr, size_t) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete(void* in_ptr, const std::nothrow_t&) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete[](void* in_ptr, const std::nothrow_t&) noexcept { tracked_free(in_ptr, default_alignment); }
+void operator delete(void* in_ptr, std::align_val_t in_alignment) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+void operator delete[](void* in_ptr, std::align_val_t in_alignment) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+void operator delete(void* in_ptr, size_t, std::align_val_t in_alignment) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+void operator delete[](void* in_ptr, size_t, std::align_val_t in_alignment) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+void operator delete(void* in_ptr, std::align_val_t in_alignment, const std::nothrow_t&) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+void operator delete[](void* in_ptr, std::align_val_t in_alignment, const std::nothrow_t&) noexcept { tracked_free(in_ptr, static_cast<size_t>(in_alignment)); }
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "engine/core.hpp"
+#include <algorithm>
+#include <cstdlib>
+#if ZE_PLATFORM(WINDOWS)
+#include <malloc.h>
+#endif
+
+namespace ze::memory::detail
+{
+
+/**
+ * Allocations that bypass the global new, so tagged allocations aren't accounted twice when it is tracked
+ */
+inline void* platform_allocate(const size_t in_size, const size_t in_alignment)
+{
+	const size_t alignment = std::max(in_alignment, sizeof(void*));
+#if ZE_PLATFORM(WINDOWS)
+	return _aligned_malloc(in_size, alignment);
+#else
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, alignment, in_size) != 0)
+		return nullptr;
+	return ptr;
+#endif
+}
+
+inline void platform_free(void* in_ptr, [[maybe_unused]] const size_t in_alignment)
+{
+#if ZE_PLATFORM(WINDOWS)
+	_aligned_free(in_ptr);
+#else
+	free(in_ptr);
+#endif
+}
+
+}
@@ -0,0 +1,243 @@
+#include "engine/memory/tracking.hpp"
+#include "engine/memory/platform_allocator.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <new>
+#include <utility>
+#if ZE_FEATURE(MEMORY_PROFILING)
+#include <Tracy.hpp>
+#endif
+
+namespace ze::memory
+{
+
+ZE_DEFINE_LOG_CATEGORY(memory);
+
+namespace
+{
+
+/** A thread publishes its counters of a tag once they moved by this much */
+static constexpr int64_t batch_bytes = 64 * 1024;
+static constexpr uint32_t batch_operations = 1024;
+
+struct alignas(std::hardware_destructive_interference_size) TagCounters
+{
+	/** Can be briefly negative when frees are published before the allocations of another thread */
+	std::atomic_int64_t current_bytes;
+	std::atomic_int64_t peak_bytes;
+	std::atomic_uint64_t allocation_count;
+	std::atomic_uint64_t free_count;
+	std::atomic_size_t budget_bytes;
+	std::atomic_bool over_budget;
+};
+
+/** Constant-initialized as the global new can run before any dynamic initialization */
+constinit std::array<TagCounters, tag_count> tag_counters {};
+
+/** Trivially destructible so it stays usable while other thread_local objects get destroyed */
+struct ThreadCounters
+{
+	std::array<int64_t, tag_count> pending_bytes;
+	std::array<uint32_t, tag_count> pending_allocations;
+	std::array<uint32_t, tag_count> pending_frees;
+	MemoryTag current_tag;
+	bool registered;
+
+	/** Once the thread is exiting every operation is published right away */
+	bool exiting;
+	bool warning;
+};
+
+constinit thread_local ThreadCounters thread_counters {};
+
+void warn_over_budget(const MemoryTag in_tag, const int64_t in_current_bytes, const size_t in_budget_bytes)
+{
+	/** Logging may allocate, don't warn again from these allocations */
+	if (thread_counters.warning)
+		return;
+
+	thread_counters.warning = true;
+	logger::warn(log_memory, "Memory tag {} is over budget: {} KiB used, budget is {} KiB",
+		std::to_string(in_tag), in_current_bytes / 1024, in_budget_bytes / 1024);
+	thread_counters.warning = false;
+}
+
+void flush_tag(ThreadCounters& in_thread_counters, const size_t in_tag_idx)
+{
+	TagCounters& counters = tag_counters[in_tag_idx];
+	const int64_t bytes = std::exchange(in_thread_counters.pending_bytes[in_tag_idx], 0);
+	const uint32_t allocations = std::exchange(in_thread_counters.pending_allocations[in_tag_idx], 0);
+	const uint32_t frees = std::exchange(in_thread_counters.pending_frees[in_tag_idx], 0);
+
+	const int64_t current_bytes = counters.current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	if (allocations != 0)
+		counters.allocation_count.fetch_add(allocations, std::memory_order_relaxed);
+	if (frees != 0)
+		counters.free_count.fetch_add(frees, std::memory_order_relaxed);
+
+	int64_t peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+	while (current_bytes > peak_bytes &&
+		!counters.peak_bytes.compare_exchange_weak(peak_bytes, current_bytes, std::memory_order_relaxed)) {}
+
+	const size_t budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed);
+	if (budget_bytes == 0)
+		return;
+
+	if (current_bytes > static_cast<int64_t>(budget_bytes))
+	{
+		if (!counters.over_budget.exchange(true, std::memory_order_relaxed))
+			warn_over_budget(static_cast<MemoryTag>(in_tag_idx), current_bytes, budget_bytes);
+	}
+	else if (counters.over_budget.load(std::memory_order_relaxed))
+	{
+		counters.over_budget.store(false, std::memory_order_relaxed);
+	}
+}
+
+void flush_all(ThreadCounters& in_thread_counters)
+{
+	for (size_t i = 0; i < tag_count; ++i)
+	{
+		if (in_thread_counters.pending_bytes[i] != 0 ||
+			in_thread_counters.pending_allocations[i] != 0 ||
+			in_thread_counters.pending_frees[i] != 0)
+			flush_tag(in_thread_counters, i);
+	}
+}
+
+struct ThreadExitFlusher
+{
+	~ThreadExitFlusher()
+	{
+		thread_counters.exiting = true;
+		flush_all(thread_counters);
+	}
+};
+
+thread_local ThreadExitFlusher thread_exit_flusher;
+
+void register_thread(ThreadCounters& in_thread_counters)
+{
+	in_thread_counters.registered = true;
+
+	/** Odr-use the flusher so it gets constructed, and destroyed when the thread exits */
+	[[maybe_unused]] volatile void* flusher = &thread_exit_flusher;
+}
+
+}
+
+void track_allocation(const MemoryTag in_tag, const size_t in_size)
+{
+	ThreadCounters& counters = thread_counters;
+	if (!counters.registered) [[unlikely]]
+		register_thread(counters);
+
+	const size_t tag_idx = static_cast<size_t>(in_tag);
+	counters.pending_bytes[tag_idx] += static_cast<int64_t>(in_size);
+	counters.pending_allocations[tag_idx]++;
+	if (counters.pending_bytes[tag_idx] >= batch_bytes ||
+		counters.pending_allocations[tag_idx] >= batch_operations ||
+		counters.exiting)
+		flush_tag(counters, tag_idx);
+}
+
+void track_free(const MemoryTag in_tag, const size_t in_size)
+{
+	ThreadCounters& counters = thread_counters;
+	if (!counters.registered) [[unlikely]]
+		register_thread(counters);
+
+	const size_t tag_idx = static_cast<size_t>(in_tag);
+	counters.pending_bytes[tag_idx] -= static_cast<int64_t>(in_size);
+	counters.pending_frees[tag_idx]++;
+	if (counters.pending_bytes[tag_idx] <= -batch_bytes ||
+		counters.pending_frees[tag_idx] >= batch_operations ||
+		counters.exiting)
+		flush_tag(counters, tag_idx);
+}
+
+void flush_thread_stats()
+{
+	flush_all(thread_counters);
+}
+
+void* allocate(const size_t in_size, const size_t in_alignment, const MemoryTag in_tag)
+{
+	void* ptr = detail::platform_allocate(in_size, in_alignment);
+	if (!ptr)
+		return nullptr;
+
+	track_allocation(in_tag, in_size);
+#if ZE_FEATURE(MEMORY_PROFILING)
+	TracyAllocN(ptr, in_size, std::to_string(in_tag).data());
+#endif
+	return ptr;
+}
+
+void deallocate(void* in_ptr, const size_t in_size, const size_t in_alignment, const MemoryTag in_tag)
+{
+	if (!in_ptr)
+		return;
+
+#if ZE_FEATURE(MEMORY_PROFILING)
+	TracyFreeN(in_ptr, std::to_string(in_tag).data());
+#endif
+	track_free(in_tag, in_size);
+	detail::platform_free(in_ptr, in_alignment);
+}
+
+MemoryTag get_current_tag()
+{
+	return thread_counters.current_tag;
+}
+
+ScopedTag::ScopedTag(const MemoryTag in_tag) : previous_tag(std::exchange(thread_counters.current_tag, in_tag)) {}
+
+ScopedTag::~ScopedTag()
+{
+	thread_counters.current_tag = previous_tag;
+}
+
+TagStats get_stats(const MemoryTag in_tag)
+{
+	const TagCounters& counters = tag_counters[static_cast<size_t>(in_tag)];
+	return
+	{
+		static_cast<size_t>(std::max<int64_t>(counters.current_bytes.load(std::memory_order_relaxed), 0)),
+		static_cast<size_t>(counters.peak_bytes.load(std::memory_order_relaxed)),
+		counters.allocation_count.load(std::memory_order_relaxed),
+		counters.free_count.load(std::memory_order_relaxed),
+		counters.budget_bytes.load(std::memory_order_relaxed),
+	};
+}
+
+void set_budget(const MemoryTag in_tag, const size_t in_bytes)
+{
+	TagCounters& counters = tag_counters[static_cast<size_t>(in_tag)];
+	counters.budget_bytes.store(in_bytes, std::memory_order_relaxed);
+	counters.over_budget.store(false, std::memory_order_relaxed);
+}
+
+void log_stats()
+{
+	flush_thread_stats();
+
+	logger::info(log_memory, "{:<12} {:>12} {:>12} {:>12} {:>12}", "Tag", "Current KiB", "Peak KiB", "Live allocs", "Budget KiB");
+	for (size_t i = 0; i < tag_count; ++i)
+	{
+		const MemoryTag tag = static_cast<MemoryTag>(i);
+		const TagStats stats = get_stats(tag);
+		if (stats.allocation_count == 0)
+			continue;
+
+		logger::info(log_memory, "{:<12} {:>12} {:>12} {:>12} {:>12}",
+			std::to_string(tag),
+			stats.current_bytes / 1024,
+			stats.peak_bytes / 1024,
+			stats.allocation_count - std::min(stats.free_count, stats.allocation_count),
+			stats.budget_bytes / 1024);
+	}
+}
+
+}
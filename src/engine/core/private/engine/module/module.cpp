@@ -1,14 +1,8 @@
 #include "engine/module/module.hpp"
-#include <boost/locale.hpp>
 
 namespace ze
 {
 
-Module::Module() : handle(nullptr)
-{
-    const boost::locale::generator generator;
-    const std::locale locale = generator.generate(std::locale(), "");
-    std::locale::global(locale);
-}
+Module::Module() : handle(nullptr) {}
 
-}
\ No newline at end of file
+}
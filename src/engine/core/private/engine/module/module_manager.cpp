@@ -2,7 +2,15 @@
 #include "engine/module/module.hpp"
 #include "engine/module/module_manager.hpp"
 #include "engine/hal/library.hpp"
-#include <boost/locale.hpp>
+#include "engine/profiling/profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <robin_hood.h>
 
 namespace ze
 {
@@ -11,13 +19,65 @@ ZE_DEFINE_LOG_CATEGORY(module_manager);
 
 using InstantiateModuleFunc = Module*(*)();
 
-std::vector<std::unique_ptr<Module>> modules;
-std::vector<std::string> loaded_module_names;
+namespace
+{
+
+struct ModuleEntry
+{
+	/** Null while the module is being loaded */
+	std::unique_ptr<Module> module;
+	double load_ms = 0.0;
+};
+
+/**
+ * Entries are indexed by their lowercase name and by every spelling they were requested with,
+ * so lookups of an already loaded module don't have to lowercase the name
+ */
+struct ModuleRegistry
+{
+	std::shared_mutex mutex;
+	std::condition_variable_any loaded_condition;
+	robin_hood::unordered_map<Name, ModuleEntry*> entries_by_name;
+
+	/** In the order modules finished loading, so a module loading another one from its constructor comes after it */
+	std::vector<std::unique_ptr<ModuleEntry>> entries;
+};
+
+ModuleRegistry& get_registry()
+{
+	static ModuleRegistry registry;
+	return registry;
+}
+
+constinit std::atomic_uint64_t module_generation = 0;
+constinit std::atomic<ModuleLoadWaitFunc> module_load_wait_func = nullptr;
+
+/** Module names are ASCII, so this is enough to match the lowercase library names */
+std::string to_lower(const std::string_view& in_string)
+{
+	std::string string(in_string);
+	std::transform(string.begin(), string.end(), string.begin(),
+		[](const char in_char) { return in_char >= 'A' && in_char <= 'Z' ? static_cast<char>(in_char - 'A' + 'a') : in_char; });
+	return string;
+}
+
+/** Expects the registry to be locked */
+ModuleEntry* find_entry(ModuleRegistry& in_registry, const Name& in_name, const Name& in_lowercase_name)
+{
+	if (auto it = in_registry.entries_by_name.find(in_name); it != in_registry.entries_by_name.end())
+		return it->second;
+
+	if (auto it = in_registry.entries_by_name.find(in_lowercase_name); it != in_registry.entries_by_name.end())
+		return it->second;
+
+	return nullptr;
+}
 
-Result<Module*, ModuleLoadError> load_shared(const std::string_view& name)
+Result<Module*, ModuleLoadError> load_shared(const std::string_view& name, const std::string_view& lowercase_name)
 {
-	std::string corrected_path = fmt::format("ze-{}.{}", name, hal::get_dynamic_library_ext());
-	corrected_path = boost::locale::to_lower(corrected_path);
+	ZE_PROFILE_SCOPE("Load module");
+
+	const std::string corrected_path = fmt::format("ze-{}.{}", lowercase_name, hal::get_dynamic_library_ext());
 
 	void* module = hal::load_library(corrected_path.c_str());
 	if (!module)
@@ -36,47 +96,284 @@ Result<Module*, ModuleLoadError> load_shared(const std::string_view& name)
 	return make_result(module_class);
 }
 
+void erase_entry_names(ModuleRegistry& in_registry, const ModuleEntry* in_entry)
+{
+	for (auto it = in_registry.entries_by_name.begin(); it != in_registry.entries_by_name.end();)
+	{
+		if (it->second == in_entry)
+			it = in_registry.entries_by_name.erase(it);
+		else
+			++it;
+	}
+}
+
+bool is_module_loaded(const std::string_view& in_name)
+{
+	ModuleRegistry& registry = get_registry();
+	std::shared_lock lock(registry.mutex);
+	const ModuleEntry* entry = find_entry(registry, Name(in_name), Name(to_lower(in_name)));
+	return entry && entry->module;
+}
+
+}
+
+namespace detail
+{
+
+uint64_t get_module_generation()
+{
+	return module_generation.load(std::memory_order_acquire);
+}
+
+}
+
 Result<Module*, ModuleLoadError> load_module(const std::string_view& name)
 {
+	ModuleRegistry& registry = get_registry();
+	const Name module_name(name);
+
 	/** Return module ptr if already exists */
-	for (const auto& module : modules)
-		if (module->get_name() == name)
-			return make_result(module.get());
+	{
+		std::shared_lock lock(registry.mutex);
+		if (auto it = registry.entries_by_name.find(module_name); it != registry.entries_by_name.end() && it->second->module)
+			return make_result(it->second->module.get());
+	}
+
+	const std::string lowercase_name = to_lower(name);
+	const Name module_lowercase_name(lowercase_name);
+
+	ModuleEntry* entry = nullptr;
+	{
+		std::unique_lock lock(registry.mutex);
+		while (true)
+		{
+			ModuleEntry* existing_entry = find_entry(registry, module_name, module_lowercase_name);
+			if (!existing_entry)
+				break;
+
+			if (existing_entry->module)
+			{
+				registry.entries_by_name.try_emplace(module_name, existing_entry);
+				return make_result(existing_entry->module.get());
+			}
+
+			/** Being loaded by another thread, that may also fail */
+			const ModuleLoadWaitFunc wait_func = module_load_wait_func.load(std::memory_order_acquire);
+			if (!wait_func)
+			{
+				registry.loaded_condition.wait(lock);
+				continue;
+			}
+
+			lock.unlock();
+			const bool did_work = wait_func();
+			lock.lock();
+			if (!did_work)
+				registry.loaded_condition.wait_for(lock, std::chrono::microseconds(100));
+		}
+
+		entry = registry.entries.emplace_back(std::make_unique<ModuleEntry>()).get();
+		registry.entries_by_name.try_emplace(module_name, entry);
+		registry.entries_by_name.try_emplace(module_lowercase_name, entry);
+	}
+
+	/** Loaded without holding the lock, so modules loading other modules and independent modules don't block */
+	const uint64_t start_ns = profiler::get_time_ns();
+	auto result = load_shared(name, lowercase_name);
+	const double load_ms = static_cast<double>(profiler::get_time_ns() - start_ns) / 1e6;
+
+	{
+		std::unique_lock lock(registry.mutex);
+		auto it = std::find_if(registry.entries.begin(), registry.entries.end(),
+			[&](const auto& in_entry) { return in_entry.get() == entry; });
+		if (result)
+		{
+			entry->module.reset(result.get_value());
+			entry->load_ms = load_ms;
+			std::rotate(it, it + 1, registry.entries.end());
+		}
+		else
+		{
+			erase_entry_names(registry, entry);
+			registry.entries.erase(it);
+		}
+	}
+	registry.loaded_condition.notify_all();
 
-	auto result = load_shared(name);
 	if (result)
 	{
-		Module* module = result.get_value();
-		modules.emplace_back(module);
-		logger::info(log_module_manager, "Loaded module {}", name);
-		return make_result(module);
+		logger::info(log_module_manager, "Loaded module {} ({:.2f} ms)", name, load_ms);
+		return make_result(result.get_value());
 	}
 
 	return make_error(result.get_error());
 }
 
+ModuleLoadWaitFunc set_module_load_wait_func(const ModuleLoadWaitFunc in_func)
+{
+	return module_load_wait_func.exchange(in_func, std::memory_order_acq_rel);
+}
+
 void unload_module(const std::string_view& name)
 {
-	for(auto it = modules.begin(); it != modules.end(); ++it)
+	ModuleRegistry& registry = get_registry();
+	std::unique_ptr<ModuleEntry> unloaded_entry;
 	{
-		const auto& module = *it;
+		std::unique_lock lock(registry.mutex);
+		ModuleEntry* entry = find_entry(registry, Name(name), Name(to_lower(name)));
+		if (!entry || !entry->module)
+			return;
 
-		if(module->get_name() == name)
-		{
-			modules.erase(it);
-		}
+		erase_entry_names(registry, entry);
+		auto it = std::find_if(registry.entries.begin(), registry.entries.end(),
+			[&](const auto& in_entry) { return in_entry.get() == entry; });
+		unloaded_entry = std::move(*it);
+		registry.entries.erase(it);
+		module_generation.fetch_add(1, std::memory_order_acq_rel);
 	}
+
+	/** Queued messages may reference categories defined in the module */
+	logger::flush();
 }
 
 void unload_all_modules()
 {
+	ModuleRegistry& registry = get_registry();
+	std::vector<std::unique_ptr<ModuleEntry>> entries;
+	{
+		std::unique_lock lock(registry.mutex);
+		entries = std::move(registry.entries);
+		registry.entries.clear();
+		registry.entries_by_name.clear();
+		module_generation.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	logger::flush();
+
 	/** We remove one by one reversed since some modules may depend on another modules */
-	for (auto& module : modules)
+	while (!entries.empty())
+		entries.pop_back();
+}
+
+Result<std::vector<std::vector<size_t>>, ModuleLoadError> resolve_module_dependencies(
+	const std::span<const ModuleDesc>& in_modules)
+{
+	robin_hood::unordered_map<Name, size_t> indices;
+	for (size_t i = 0; i < in_modules.size(); ++i)
+		indices.try_emplace(Name(to_lower(in_modules[i].name)), i);
+
+	std::vector<std::vector<size_t>> dependencies(in_modules.size());
+	std::vector<std::vector<size_t>> dependents(in_modules.size());
+	for (size_t i = 0; i < in_modules.size(); ++i)
+	{
+		for (const std::string_view& dependency : in_modules[i].dependencies)
+		{
+			if (auto it = indices.find(Name(to_lower(dependency))); it != indices.end())
+			{
+				dependencies[i].emplace_back(it->second);
+				dependents[it->second].emplace_back(i);
+			}
+			else if (!is_module_loaded(dependency))
+			{
+				logger::error(log_module_manager, "Module {} depends on {} which isn't loaded nor loaded with it",
+					in_modules[i].name, dependency);
+				return make_error(ModuleLoadError::UnknownDependency);
+			}
+		}
+	}
+
+	/** Kahn's algorithm, modules left with dependencies are part of a cycle */
+	std::vector<size_t> remaining_dependency_counts(in_modules.size());
+	std::vector<size_t> ready;
+	for (size_t i = 0; i < in_modules.size(); ++i)
+	{
+		remaining_dependency_counts[i] = dependencies[i].size();
+		if (remaining_dependency_counts[i] == 0)
+			ready.emplace_back(i);
+	}
+
+	size_t visited_count = 0;
+	while (!ready.empty())
+	{
+		const size_t module = ready.back();
+		ready.pop_back();
+		visited_count++;
+
+		for (const size_t dependent : dependents[module])
+			if (--remaining_dependency_counts[dependent] == 0)
+				ready.emplace_back(dependent);
+	}
+
+	if (visited_count != in_modules.size())
 	{
-		module.reset();
+		for (size_t i = 0; i < in_modules.size(); ++i)
+			if (remaining_dependency_counts[i] != 0)
+				logger::error(log_module_manager, "Module {} is part of a dependency cycle", in_modules[i].name);
+
+		return make_error(ModuleLoadError::DependencyCycle);
 	}
 
-	modules.clear();
+	return make_result(std::move(dependencies));
 }
 
-}
\ No newline at end of file
+bool load_modules(const std::span<const ModuleDesc>& in_modules)
+{
+	auto dependencies = resolve_module_dependencies(in_modules);
+	if (!dependencies)
+	{
+		UnusedParameters{ dependencies.get_error() };
+		return false;
+	}
+
+	std::vector<bool> visited(in_modules.size(), false);
+	bool succeeded = true;
+	auto load = [&](auto& in_self, const size_t in_index) -> void
+	{
+		if (visited[in_index])
+			return;
+
+		visited[in_index] = true;
+		for (const size_t dependency : dependencies.get_value()[in_index])
+			in_self(in_self, dependency);
+
+		if (auto result = load_module(in_modules[in_index].name); !result)
+		{
+			logger::error(log_module_manager, "Failed to load module {}", in_modules[in_index].name);
+			UnusedParameters{ result.get_error() };
+			succeeded = false;
+		}
+	};
+
+	for (size_t i = 0; i < in_modules.size(); ++i)
+		load(load, i);
+
+	return succeeded;
+}
+
+std::vector<ModuleLoadTime> get_module_load_times()
+{
+	ModuleRegistry& registry = get_registry();
+	std::shared_lock lock(registry.mutex);
+
+	std::vector<ModuleLoadTime> load_times;
+	load_times.reserve(registry.entries.size());
+	for (const auto& entry : registry.entries)
+		if (entry->module)
+			load_times.push_back({ entry->module->get_name(), entry->load_ms });
+
+	return load_times;
+}
+
+void log_module_load_times()
+{
+	double total_ms = 0.0;
+	for (const ModuleLoadTime& load_time : get_module_load_times())
+	{
+		logger::info(log_module_manager, "{:<24} {:>8.2f} ms", load_time.name, load_time.load_ms);
+		total_ms += load_time.load_ms;
+	}
+
+	logger::info(log_module_manager, "{:<24} {:>8.2f} ms", "Sum", total_ms);
+}
+
+}
@@ -0,0 +1,173 @@
+#include "engine/name.hpp"
+#include "engine/debug/assertions.hpp"
+#include "engine/memory/tracking.hpp"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <vector>
+
+namespace ze
+{
+
+namespace
+{
+
+struct NameEntry
+{
+	std::string_view string;
+	uint32_t hash;
+};
+
+struct NameKey
+{
+	std::string_view string;
+	uint64_t hash;
+
+	bool operator==(const NameKey& in_other) const { return string == in_other.string; }
+};
+
+struct NameKeyHash
+{
+	size_t operator()(const NameKey& in_key) const noexcept { return static_cast<size_t>(in_key.hash); }
+};
+
+/**
+ * Lookups are split in shards by hash so concurrent lookups rarely touch the same lock, and only take it shared
+ * Entries are stored in fixed pages that are never freed, so get_string never locks
+ */
+class NameTable
+{
+	static constexpr size_t shard_count = 16;
+	static constexpr size_t page_size = 4096;
+	static constexpr size_t max_pages = 1024;
+	static constexpr size_t string_block_size = 64 * 1024;
+
+	struct alignas(std::hardware_destructive_interference_size) Shard
+	{
+		std::shared_mutex mutex;
+		robin_hood::unordered_flat_map<NameKey, uint32_t, NameKeyHash> ids;
+	};
+public:
+	NameTable() : pages(), next_id(1), string_block_used(string_block_size)
+	{
+		/** Id 0 is the empty name */
+		allocate_entry(0, { {}, 0 });
+	}
+
+	uint32_t find_or_add(std::string_view in_string, uint64_t in_hash)
+	{
+		if (in_string.empty())
+			return 0;
+
+		const NameKey key { in_string, in_hash };
+		Shard& shard = shards[(in_hash >> 32) % shard_count];
+		{
+			std::shared_lock lock(shard.mutex);
+			if (auto it = shard.ids.find(key); it != shard.ids.end())
+				return it->second;
+		}
+
+		std::unique_lock lock(shard.mutex);
+		if (auto it = shard.ids.find(key); it != shard.ids.end())
+			return it->second;
+
+		memory::ScopedTag tag(MemoryTag::Core);
+
+		const std::string_view string = store_string(in_string);
+		const uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+		allocate_entry(id, { string, fold_hash(in_hash) });
+		shard.ids.emplace(NameKey { string, in_hash }, id);
+		return id;
+	}
+
+	const NameEntry& get_entry(uint32_t in_id) const
+	{
+		/** The id comes from a Name, whose creation synchronized with the page publication */
+		return pages[in_id / page_size].load(std::memory_order_acquire)[in_id % page_size];
+	}
+
+	static uint32_t fold_hash(uint64_t in_hash)
+	{
+		return static_cast<uint32_t>(in_hash ^ (in_hash >> 32));
+	}
+private:
+	void allocate_entry(uint32_t in_id, const NameEntry& in_entry)
+	{
+		const size_t page_index = in_id / page_size;
+		ZE_ASSERTF(page_index < max_pages, "Too many names, max is {}", max_pages * page_size);
+
+		NameEntry* page = pages[page_index].load(std::memory_order_acquire);
+		if (!page)
+		{
+			std::scoped_lock lock(storage_mutex);
+			page = pages[page_index].load(std::memory_order_relaxed);
+			if (!page)
+			{
+				page = owned_pages.emplace_back(std::make_unique<NameEntry[]>(page_size)).get();
+				pages[page_index].store(page, std::memory_order_release);
+			}
+		}
+
+		page[in_id % page_size] = in_entry;
+	}
+
+	std::string_view store_string(std::string_view in_string)
+	{
+		std::scoped_lock lock(storage_mutex);
+
+		char* data = nullptr;
+		if (in_string.size() > string_block_size / 4)
+		{
+			data = owned_strings.emplace_back(std::make_unique<char[]>(in_string.size())).get();
+		}
+		else
+		{
+			if (string_block_used + in_string.size() > string_block_size)
+			{
+				owned_strings.emplace_back(std::make_unique<char[]>(string_block_size));
+				string_block_used = 0;
+				string_block = owned_strings.back().get();
+			}
+
+			data = string_block + string_block_used;
+			string_block_used += in_string.size();
+		}
+
+		std::memcpy(data, in_string.data(), in_string.size());
+		return { data, in_string.size() };
+	}
+private:
+	std::array<Shard, shard_count> shards;
+	std::array<std::atomic<NameEntry*>, max_pages> pages;
+	std::atomic_uint32_t next_id;
+
+	std::mutex storage_mutex;
+	std::vector<std::unique_ptr<NameEntry[]>> owned_pages;
+	std::vector<std::unique_ptr<char[]>> owned_strings;
+	char* string_block = nullptr;
+	size_t string_block_used;
+};
+
+/** Never destroyed so names stay valid during static destruction */
+NameTable& get_name_table()
+{
+	static NameTable* table = new NameTable;
+	return *table;
+}
+
+}
+
+Name::Name(const detail::HashedString& in_string)
+	: id(get_name_table().find_or_add(in_string.string, in_string.hash)),
+	hash(in_string.string.empty() ? 0 : NameTable::fold_hash(in_string.hash)) {}
+
+std::string_view Name::get_string() const
+{
+	return get_name_table().get_entry(id).string;
+}
+
+}
@@ -0,0 +1,176 @@
+#include "engine/profiling/boot_timeline.hpp"
+#include "engine/profiling/json.hpp"
+#include "engine/hal/thread.hpp"
+#include "engine/logger/logger.hpp"
+#include "engine/module/module_manager.hpp"
+#include "engine/util/thread_index.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <fmt/format.h>
+
+namespace ze::boot
+{
+
+ZE_DEFINE_LOG_CATEGORY(boot);
+
+namespace
+{
+
+struct Timeline
+{
+	std::mutex mutex;
+	uint64_t start_ns = 0;
+	std::vector<Phase> phases;
+	std::string report_path;
+};
+
+Timeline& get_timeline()
+{
+	static Timeline timeline;
+	return timeline;
+}
+
+/** Set once, then read without locking */
+constinit std::atomic_uint64_t time_to_first_frame_ns = 0;
+
+double to_ms(const uint64_t in_ns)
+{
+	return static_cast<double>(in_ns) / 1e6;
+}
+
+}
+
+void begin()
+{
+	Timeline& timeline = get_timeline();
+	std::scoped_lock lock(timeline.mutex);
+	timeline.start_ns = profiler::get_time_ns();
+}
+
+void add_phase(const std::string_view& in_name, const uint64_t in_start_ns, const uint64_t in_end_ns)
+{
+	std::string thread = hal::get_thread_name(std::this_thread::get_id());
+	if (thread.empty())
+		thread = fmt::format("Thread {}", get_thread_index());
+
+	Timeline& timeline = get_timeline();
+	std::scoped_lock lock(timeline.mutex);
+
+	/** Phases recorded before begin are clamped to the boot start */
+	const uint64_t start_ns = timeline.start_ns != 0 ? timeline.start_ns : in_start_ns;
+	timeline.phases.push_back({ std::string(in_name),
+		std::move(thread),
+		in_start_ns > start_ns ? in_start_ns - start_ns : 0,
+		in_end_ns > start_ns ? in_end_ns - start_ns : 0 });
+}
+
+void set_report_path(const std::string& in_path)
+{
+	Timeline& timeline = get_timeline();
+	std::scoped_lock lock(timeline.mutex);
+	timeline.report_path = in_path;
+}
+
+void mark_first_frame()
+{
+	if (time_to_first_frame_ns.load(std::memory_order_relaxed) != 0)
+		return;
+
+	std::string report_path;
+	{
+		Timeline& timeline = get_timeline();
+		std::scoped_lock lock(timeline.mutex);
+		time_to_first_frame_ns.store(std::max<uint64_t>(profiler::get_time_ns() - timeline.start_ns, 1),
+			std::memory_order_relaxed);
+		report_path = timeline.report_path;
+	}
+
+	for (const Phase& phase : get_phases())
+	{
+		logger::info(log_boot, "{:<32} {:>9.2f} ms -> {:>9.2f} ms ({:.2f} ms, {})",
+			phase.name, to_ms(phase.start_ns), to_ms(phase.end_ns), to_ms(phase.end_ns - phase.start_ns), phase.thread);
+	}
+
+	logger::info(log_boot, "Time to first frame: {:.2f} ms", to_ms(time_to_first_frame_ns.load(std::memory_order_relaxed)));
+
+	if (!report_path.empty())
+	{
+		if (write_report(report_path))
+			logger::info(log_boot, "Boot report written to {}", report_path);
+		else
+			logger::error(log_boot, "Failed to write the boot report to {}", report_path);
+	}
+}
+
+std::optional<uint64_t> get_time_to_first_frame_ns()
+{
+	const uint64_t time_ns = time_to_first_frame_ns.load(std::memory_order_relaxed);
+	if (time_ns == 0)
+		return std::nullopt;
+
+	return time_ns;
+}
+
+std::vector<Phase> get_phases()
+{
+	std::vector<Phase> phases;
+	{
+		Timeline& timeline = get_timeline();
+		std::scoped_lock lock(timeline.mutex);
+		phases = timeline.phases;
+	}
+
+	std::stable_sort(phases.begin(), phases.end(),
+		[](const Phase& in_left, const Phase& in_right) { return in_left.start_ns < in_right.start_ns; });
+	return phases;
+}
+
+bool write_report(const std::string& in_path)
+{
+	std::ofstream file(in_path, std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	std::string json = "{\n\"time_to_first_frame_ms\": ";
+	if (const auto time_to_first_frame = get_time_to_first_frame_ns())
+		fmt::format_to(std::back_inserter(json), "{:.3f}", to_ms(*time_to_first_frame));
+	else
+		json.append("null");
+
+	json.append(",\n\"phases\": [");
+	bool first = true;
+	for (const Phase& phase : get_phases())
+	{
+		json.append(first ? "\n" : ",\n");
+		first = false;
+
+		json.append("{\"name\":");
+		profiler::append_json_string(json, phase.name);
+		json.append(",\"thread\":");
+		profiler::append_json_string(json, phase.thread);
+		fmt::format_to(std::back_inserter(json), ",\"start_ms\":{:.3f},\"duration_ms\":{:.3f}}}",
+			to_ms(phase.start_ns), to_ms(phase.end_ns - phase.start_ns));
+	}
+
+	json.append("\n],\n\"modules\": [");
+	first = true;
+	for (const ModuleLoadTime& load_time : get_module_load_times())
+	{
+		json.append(first ? "\n" : ",\n");
+		first = false;
+
+		json.append("{\"name\":");
+		profiler::append_json_string(json, load_time.name.get_string());
+		fmt::format_to(std::back_inserter(json), ",\"load_ms\":{:.3f}}}", load_time.load_ms);
+	}
+
+	json.append("\n]\n}\n");
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	return file.good();
+}
+
+}
@@ -0,0 +1,306 @@
+#include "engine/profiling/profiler.hpp"
+#include "engine/profiling/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <fmt/format.h>
+
+namespace ze::profiler
+{
+
+namespace
+{
+
+/** Nearest-rank percentile of sorted durations */
+uint64_t get_percentile(const std::vector<uint64_t>& in_sorted_durations, const double in_percentile)
+{
+	const size_t rank = static_cast<size_t>(std::ceil(in_percentile * static_cast<double>(in_sorted_durations.size())));
+	return in_sorted_durations[std::clamp<size_t>(rank, 1, in_sorted_durations.size()) - 1];
+}
+
+double to_ms(const uint64_t in_ns)
+{
+	return static_cast<double>(in_ns) / 1e6;
+}
+
+class BinaryWriter
+{
+public:
+	template<typename T>
+	void write(const T& in_value)
+	{
+		write_bytes(&in_value, sizeof(T));
+	}
+
+	void write_bytes(const void* in_data, size_t in_size)
+	{
+		const auto* bytes = static_cast<const char*>(in_data);
+		buffer.insert(buffer.end(), bytes, bytes + in_size);
+	}
+
+	void write_string(std::string_view in_string)
+	{
+		const uint16_t size = static_cast<uint16_t>(std::min<size_t>(in_string.size(), UINT16_MAX));
+		write(size);
+		write_bytes(in_string.data(), size);
+	}
+
+	[[nodiscard]] const std::vector<char>& get_buffer() const { return buffer; }
+private:
+	std::vector<char> buffer;
+};
+
+class BinaryReader
+{
+public:
+	BinaryReader(const std::vector<char>& in_data) : data(in_data), offset(0) {}
+
+	template<typename T>
+	bool read(T& out_value)
+	{
+		if (data.size() - offset < sizeof(T))
+			return false;
+
+		std::memcpy(&out_value, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	bool read_string(std::string& out_string)
+	{
+		uint16_t size = 0;
+		if (!read(size) || data.size() - offset < size)
+			return false;
+
+		out_string.assign(data.data() + offset, size);
+		offset += size;
+		return true;
+	}
+
+	/** Guards against sizes of corrupted files before reserving memory */
+	[[nodiscard]] bool has_bytes(const size_t in_size) const { return data.size() - offset >= in_size; }
+private:
+	const std::vector<char>& data;
+	size_t offset;
+};
+
+}
+
+std::vector<ZoneStats> compute_zone_stats(const Capture& in_capture)
+{
+	std::vector<std::vector<uint64_t>> durations(in_capture.zones.size());
+	for (const CaptureThread& thread : in_capture.threads)
+		for (const CaptureEvent& event : thread.events)
+			durations[event.zone].emplace_back(event.end_ns - event.start_ns);
+
+	std::vector<ZoneStats> stats;
+	stats.reserve(in_capture.zones.size());
+	for (size_t i = 0; i < in_capture.zones.size(); ++i)
+	{
+		std::vector<uint64_t>& zone_durations = durations[i];
+		if (zone_durations.empty())
+			continue;
+
+		std::sort(zone_durations.begin(), zone_durations.end());
+
+		uint64_t total_ns = 0;
+		for (const uint64_t duration : zone_durations)
+			total_ns += duration;
+
+		stats.push_back({ in_capture.zones[i].name,
+			zone_durations.size(),
+			to_ms(total_ns),
+			to_ms(total_ns) / static_cast<double>(zone_durations.size()),
+			to_ms(zone_durations.front()),
+			to_ms(zone_durations.back()),
+			to_ms(get_percentile(zone_durations, 0.5)),
+			to_ms(get_percentile(zone_durations, 0.99)) });
+	}
+
+	std::sort(stats.begin(), stats.end(),
+		[](const ZoneStats& in_left, const ZoneStats& in_right) { return in_left.total_ms > in_right.total_ms; });
+	return stats;
+}
+
+std::optional<ZoneStats> get_zone_stats(const Capture& in_capture, std::string_view in_name)
+{
+	/** Zones declared at several places with the same name are merged */
+	Capture zone_capture;
+	zone_capture.zones.push_back({ std::string(in_name), {}, 0 });
+	for (const CaptureThread& thread : in_capture.threads)
+	{
+		CaptureThread& zone_thread = zone_capture.threads.emplace_back();
+		for (const CaptureEvent& event : thread.events)
+			if (in_capture.zones[event.zone].name == in_name)
+				zone_thread.events.push_back({ 0, event.start_ns, event.end_ns });
+	}
+
+	std::vector<ZoneStats> stats = compute_zone_stats(zone_capture);
+	if (stats.empty())
+		return std::nullopt;
+
+	return std::move(stats.front());
+}
+
+bool write_chrome_trace(const Capture& in_capture, const std::string& in_path)
+{
+	std::ofstream file(in_path, std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	/** Flushed to the file every few KBs */
+	static constexpr size_t flush_threshold = 64 * 1024;
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first_event = true;
+	auto begin_event = [&]()
+	{
+		if (!first_event)
+			json.append(",\n");
+
+		first_event = false;
+		if (json.size() >= flush_threshold)
+		{
+			file.write(json.data(), static_cast<std::streamsize>(json.size()));
+			json.clear();
+		}
+	};
+
+	for (const CaptureThread& thread : in_capture.threads)
+	{
+		begin_event();
+		fmt::format_to(std::back_inserter(json), "{{\"ph\":\"M\",\"pid\":0,\"tid\":{},\"name\":\"thread_name\",\"args\":{{\"name\":",
+			thread.id);
+		append_json_string(json, thread.name);
+		json.append("}}");
+
+		for (const CaptureEvent& event : thread.events)
+		{
+			begin_event();
+			json.append("{\"ph\":\"X\",\"pid\":0,\"tid\":");
+			fmt::format_to(std::back_inserter(json), "{},\"ts\":{:.3f},\"dur\":{:.3f},\"name\":",
+				thread.id, static_cast<double>(event.start_ns) / 1e3, static_cast<double>(event.end_ns - event.start_ns) / 1e3);
+			append_json_string(json, in_capture.zones[event.zone].name);
+			json.push_back('}');
+		}
+	}
+
+	for (size_t i = 0; i < in_capture.frame_start_ns.size(); ++i)
+	{
+		begin_event();
+		fmt::format_to(std::back_inserter(json), "{{\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"name\":\"Frame {}\"}}",
+			static_cast<double>(in_capture.frame_start_ns[i]) / 1e3, i);
+	}
+
+	json.append("\n]}\n");
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	return file.good();
+}
+
+bool write_binary_capture(const Capture& in_capture, const std::string& in_path)
+{
+	std::ofstream file(in_path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	BinaryWriter writer;
+	writer.write_bytes(binary_capture_magic, sizeof(binary_capture_magic));
+	writer.write(binary_capture_version);
+	writer.write(in_capture.duration_ns);
+	writer.write(in_capture.dropped_events);
+
+	writer.write(static_cast<uint32_t>(in_capture.frame_start_ns.size()));
+	for (const uint64_t frame_start_ns : in_capture.frame_start_ns)
+		writer.write(frame_start_ns);
+
+	writer.write(static_cast<uint32_t>(in_capture.zones.size()));
+	for (const CaptureZone& zone : in_capture.zones)
+	{
+		writer.write_string(zone.name);
+		writer.write_string(zone.file);
+		writer.write(zone.line);
+	}
+
+	writer.write(static_cast<uint32_t>(in_capture.threads.size()));
+	for (const CaptureThread& thread : in_capture.threads)
+	{
+		writer.write(thread.id);
+		writer.write_string(thread.name);
+		writer.write(static_cast<uint32_t>(thread.events.size()));
+		for (const CaptureEvent& event : thread.events)
+		{
+			writer.write(event.zone);
+			writer.write(event.start_ns);
+			writer.write(event.end_ns);
+		}
+	}
+
+	file.write(writer.get_buffer().data(), static_cast<std::streamsize>(writer.get_buffer().size()));
+	return file.good();
+}
+
+std::optional<Capture> read_binary_capture(const std::string& in_path)
+{
+	std::ifstream file(in_path, std::ios::binary);
+	if (!file.is_open())
+		return std::nullopt;
+
+	const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	BinaryReader reader(data);
+
+	char magic[sizeof(binary_capture_magic)];
+	uint32_t version = 0;
+	if (!reader.read(magic) || std::memcmp(magic, binary_capture_magic, sizeof(magic)) != 0 ||
+		!reader.read(version) || version != binary_capture_version)
+		return std::nullopt;
+
+	Capture capture;
+	uint32_t frame_count = 0;
+	if (!reader.read(capture.duration_ns) || !reader.read(capture.dropped_events) ||
+		!reader.read(frame_count) || !reader.has_bytes(frame_count * sizeof(uint64_t)))
+		return std::nullopt;
+
+	capture.frame_start_ns.resize(frame_count);
+	for (uint64_t& frame_start_ns : capture.frame_start_ns)
+		reader.read(frame_start_ns);
+
+	uint32_t zone_count = 0;
+	if (!reader.read(zone_count))
+		return std::nullopt;
+
+	for (uint32_t i = 0; i < zone_count; ++i)
+	{
+		CaptureZone& zone = capture.zones.emplace_back();
+		if (!reader.read_string(zone.name) || !reader.read_string(zone.file) || !reader.read(zone.line))
+			return std::nullopt;
+	}
+
+	uint32_t thread_count = 0;
+	if (!reader.read(thread_count))
+		return std::nullopt;
+
+	for (uint32_t i = 0; i < thread_count; ++i)
+	{
+		CaptureThread& thread = capture.threads.emplace_back();
+		uint32_t event_count = 0;
+		if (!reader.read(thread.id) || !reader.read_string(thread.name) || !reader.read(event_count) ||
+			!reader.has_bytes(event_count * (sizeof(uint32_t) + 2 * sizeof(uint64_t))))
+			return std::nullopt;
+
+		thread.events.resize(event_count);
+		for (CaptureEvent& event : thread.events)
+		{
+			reader.read(event.zone);
+			reader.read(event.start_ns);
+			reader.read(event.end_ns);
+			if (event.zone >= zone_count)
+				return std::nullopt;
+		}
+	}
+
+	return capture;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <fmt/format.h>
+
+namespace ze::profiler
+{
+
+/** Append in_string quoted and escaped */
+inline void append_json_string(std::string& out_json, std::string_view in_string)
+{
+	out_json.push_back('"');
+	for (const char c : in_string)
+	{
+		switch (c)
+		{
+		case '"':
+			out_json.append("\\\"");
+			break;
+		case '\\':
+			out_json.append("\\\\");
+			break;
+		case '\n':
+			out_json.append("\\n");
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+				fmt::format_to(std::back_inserter(out_json), "\\u{:04x}", static_cast<uint32_t>(c));
+			else
+				out_json.push_back(c);
+			break;
+		}
+	}
+	out_json.push_back('"');
+}
+
+}
@@ -0,0 +1,309 @@
+#include "engine/profiling/profiler.hpp"
+#include "engine/hal/thread.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <fmt/format.h>
+
+namespace ze::profiler
+{
+
+namespace
+{
+
+static constexpr size_t default_thread_buffer_capacity = 64 * 1024;
+
+/** Fields are atomics as end_capture reads buffers while their thread may still write, see collect_thread */
+struct RingEvent
+{
+	std::atomic<const ZoneDesc*> desc;
+	std::atomic_uint64_t start_ns;
+	std::atomic_uint64_t end_ns;
+};
+
+struct ThreadBuffer
+{
+	ThreadBuffer(const size_t in_capacity, const std::thread::id& in_thread, const uint32_t in_id)
+		: events(std::make_unique<RingEvent[]>(in_capacity)), capacity(in_capacity), mask(in_capacity - 1),
+		thread(in_thread), id(in_id), write_position(0), capture_start_position(0) {}
+
+	std::unique_ptr<RingEvent[]> events;
+
+	/** Power of two */
+	size_t capacity;
+	size_t mask;
+	std::thread::id thread;
+	uint32_t id;
+
+	/** Only written by the owner thread, number of events ever written */
+	std::atomic_uint64_t write_position;
+
+	/** Write position when the running capture started */
+	uint64_t capture_start_position;
+};
+
+/** Read by every zone, kept out of the registry so checking it takes no initialization guard */
+constinit std::atomic_bool capturing = false;
+
+/** Set by request_frame_capture, so mark_frame only locks when there is something to do */
+constinit std::atomic_bool has_frame_request = false;
+
+/** Set once a frame capture completes, so take_frame_capture can be polled every frame */
+constinit std::atomic_bool has_frame_capture = false;
+
+constinit thread_local ThreadBuffer* thread_buffer = nullptr;
+
+/**
+ * Buffers are never freed (threads may exit while a capture reads them), a buffer per thread ever profiled
+ */
+struct Registry
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	size_t thread_buffer_capacity = default_thread_buffer_capacity;
+
+	uint64_t capture_start_ns = 0;
+	std::vector<uint64_t> frame_start_ns;
+
+	uint32_t requested_frame_count = 0;
+
+	/** Frames left before the frame capture ends, 0 if the running capture isn't a frame capture */
+	uint32_t remaining_frame_count = 0;
+	std::optional<Capture> frame_capture;
+};
+
+Registry& get_registry()
+{
+	static Registry registry;
+	return registry;
+}
+
+ThreadBuffer* register_thread()
+{
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	thread_buffer = registry.buffers.emplace_back(std::make_unique<ThreadBuffer>(registry.thread_buffer_capacity,
+		std::this_thread::get_id(), static_cast<uint32_t>(registry.buffers.size()))).get();
+	return thread_buffer;
+}
+
+void begin_capture_locked(Registry& in_registry)
+{
+	for (const auto& buffer : in_registry.buffers)
+		buffer->capture_start_position = buffer->write_position.load(std::memory_order_acquire);
+
+	in_registry.capture_start_ns = get_time_ns();
+	in_registry.frame_start_ns.clear();
+	capturing.store(true, std::memory_order_release);
+}
+
+/**
+ * Copy the events the thread wrote during the capture, then drop the ones it may have overwritten in the
+ * meantime: a thread overwriting an event has published the position preceding it (seqlock-like validation)
+ */
+void collect_thread(const Registry& in_registry, const ThreadBuffer& in_buffer, Capture& out_capture,
+	std::unordered_map<const ZoneDesc*, uint32_t>& out_zone_indices)
+{
+	const uint64_t end_position = in_buffer.write_position.load(std::memory_order_acquire);
+	const uint64_t first_position = std::max(in_buffer.capture_start_position,
+		end_position > in_buffer.capacity ? end_position - in_buffer.capacity : 0);
+
+	struct RawEvent
+	{
+		const ZoneDesc* desc;
+		uint64_t start_ns;
+		uint64_t end_ns;
+	};
+
+	std::vector<RawEvent> raw_events;
+	raw_events.reserve(end_position - first_position);
+	for (uint64_t i = first_position; i < end_position; ++i)
+	{
+		const RingEvent& event = in_buffer.events[i & in_buffer.mask];
+		raw_events.push_back({ event.desc.load(std::memory_order_relaxed),
+			event.start_ns.load(std::memory_order_relaxed),
+			event.end_ns.load(std::memory_order_relaxed) });
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const uint64_t overwrite_position = in_buffer.write_position.load(std::memory_order_relaxed);
+	const uint64_t first_valid_position = overwrite_position >= in_buffer.capacity ?
+		overwrite_position - in_buffer.capacity + 1 : 0;
+	const size_t skipped_count = first_valid_position > first_position ?
+		static_cast<size_t>(std::min(first_valid_position - first_position, end_position - first_position)) : 0;
+
+	out_capture.dropped_events += std::max(first_position, first_valid_position) - in_buffer.capture_start_position;
+	if (skipped_count == raw_events.size())
+		return;
+
+	CaptureThread& thread = out_capture.threads.emplace_back();
+	thread.id = in_buffer.id;
+	thread.name = hal::get_thread_name(in_buffer.thread);
+	if (thread.name.empty())
+		thread.name = fmt::format("Thread {}", in_buffer.id);
+
+	thread.events.reserve(raw_events.size() - skipped_count);
+	for (size_t i = skipped_count; i < raw_events.size(); ++i)
+	{
+		const RawEvent& event = raw_events[i];
+
+		/** Zones started during a previous capture and ended late */
+		if (event.start_ns < in_registry.capture_start_ns)
+			continue;
+
+		auto [it, inserted] = out_zone_indices.try_emplace(event.desc, static_cast<uint32_t>(out_capture.zones.size()));
+		if (inserted)
+			out_capture.zones.push_back({ event.desc->name, event.desc->file, event.desc->line });
+
+		thread.events.push_back({ it->second,
+			event.start_ns - in_registry.capture_start_ns,
+			event.end_ns - in_registry.capture_start_ns });
+	}
+}
+
+Capture end_capture_locked(Registry& in_registry)
+{
+	Capture capture;
+	if (!capturing.exchange(false, std::memory_order_acq_rel))
+		return capture;
+
+	capture.duration_ns = get_time_ns() - in_registry.capture_start_ns;
+	capture.frame_start_ns.reserve(in_registry.frame_start_ns.size());
+	for (const uint64_t frame_start_ns : in_registry.frame_start_ns)
+		capture.frame_start_ns.emplace_back(frame_start_ns - in_registry.capture_start_ns);
+
+	std::unordered_map<const ZoneDesc*, uint32_t> zone_indices;
+	for (const auto& buffer : in_registry.buffers)
+		collect_thread(in_registry, *buffer, capture, zone_indices);
+
+	in_registry.remaining_frame_count = 0;
+	return capture;
+}
+
+}
+
+uint64_t get_time_ns()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+namespace detail
+{
+
+uint64_t begin_zone()
+{
+	if (!capturing.load(std::memory_order_relaxed))
+		return 0;
+
+	return get_time_ns();
+}
+
+void end_zone(const ZoneDesc* in_desc, const uint64_t in_start_ns)
+{
+	const uint64_t end_ns = get_time_ns();
+	if (!capturing.load(std::memory_order_relaxed))
+		return;
+
+	ThreadBuffer* buffer = thread_buffer;
+	if (!buffer) [[unlikely]]
+		buffer = register_thread();
+
+	const uint64_t position = buffer->write_position.load(std::memory_order_relaxed);
+
+	/** Orders the publication of position before the slot is overwritten, see collect_thread */
+	std::atomic_thread_fence(std::memory_order_release);
+
+	RingEvent& event = buffer->events[position & buffer->mask];
+	event.desc.store(in_desc, std::memory_order_relaxed);
+	event.start_ns.store(in_start_ns, std::memory_order_relaxed);
+	event.end_ns.store(end_ns, std::memory_order_relaxed);
+	buffer->write_position.store(position + 1, std::memory_order_release);
+}
+
+}
+
+void set_thread_buffer_capacity(const size_t in_capacity)
+{
+	ZE_CHECKF(in_capacity > 0, "Invalid thread buffer capacity {}", in_capacity);
+
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	registry.thread_buffer_capacity = std::bit_ceil(in_capacity);
+}
+
+void begin_capture()
+{
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	if (!capturing.load(std::memory_order_relaxed))
+		begin_capture_locked(registry);
+}
+
+Capture end_capture()
+{
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	return end_capture_locked(registry);
+}
+
+bool is_capturing()
+{
+	return capturing.load(std::memory_order_relaxed);
+}
+
+void request_frame_capture(const uint32_t in_frame_count)
+{
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	registry.requested_frame_count = in_frame_count;
+	registry.frame_capture.reset();
+	has_frame_capture.store(false, std::memory_order_relaxed);
+	has_frame_request.store(in_frame_count != 0, std::memory_order_relaxed);
+}
+
+std::optional<Capture> take_frame_capture()
+{
+	if (!has_frame_capture.load(std::memory_order_relaxed))
+		return std::nullopt;
+
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	has_frame_capture.store(false, std::memory_order_relaxed);
+	return std::exchange(registry.frame_capture, std::nullopt);
+}
+
+void mark_frame()
+{
+	if (!capturing.load(std::memory_order_relaxed) && !has_frame_request.load(std::memory_order_relaxed))
+		return;
+
+	Registry& registry = get_registry();
+	std::scoped_lock lock(registry.mutex);
+	if (capturing.load(std::memory_order_relaxed))
+	{
+		if (registry.remaining_frame_count != 0 && --registry.remaining_frame_count == 0)
+		{
+			registry.frame_capture = end_capture_locked(registry);
+			has_frame_capture.store(true, std::memory_order_relaxed);
+			return;
+		}
+
+		registry.frame_start_ns.emplace_back(get_time_ns());
+	}
+	else if (registry.requested_frame_count != 0)
+	{
+		begin_capture_locked(registry);
+		registry.frame_start_ns.emplace_back(registry.capture_start_ns);
+		registry.remaining_frame_count = std::exchange(registry.requested_frame_count, 0);
+		has_frame_request.store(false, std::memory_order_relaxed);
+	}
+}
+
+}
@@ -0,0 +1,69 @@
+#include "engine/util/thread_index.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace ze
+{
+
+namespace
+{
+
+static constexpr uint32_t unassigned_thread_index = invalid_thread_index - 1;
+
+thread_local uint32_t thread_index = unassigned_thread_index;
+
+struct ThreadIndexRegistry
+{
+	std::mutex mutex;
+	std::vector<uint32_t> free_indices;
+	uint32_t next_index = 0;
+};
+
+ThreadIndexRegistry& get_registry()
+{
+	static ThreadIndexRegistry registry;
+	return registry;
+}
+
+/** Gives the index back once the thread exits, later thread_local destructors get invalid_thread_index */
+struct ThreadIndexReleaser
+{
+	~ThreadIndexReleaser()
+	{
+		ThreadIndexRegistry& registry = get_registry();
+		std::scoped_lock lock(registry.mutex);
+		registry.free_indices.emplace_back(thread_index);
+		thread_index = invalid_thread_index;
+	}
+};
+
+}
+
+uint32_t get_thread_index()
+{
+	if (thread_index == unassigned_thread_index) [[unlikely]]
+	{
+		ThreadIndexRegistry& registry = get_registry();
+		{
+			std::scoped_lock lock(registry.mutex);
+			if (!registry.free_indices.empty())
+			{
+				/** Lowest free index first so indices stay small */
+				auto it = std::min_element(registry.free_indices.begin(), registry.free_indices.end());
+				thread_index = *it;
+				registry.free_indices.erase(it);
+			}
+			else
+			{
+				thread_index = registry.next_index++;
+			}
+		}
+
+		thread_local ThreadIndexReleaser releaser;
+	}
+
+	return thread_index;
+}
+
+}
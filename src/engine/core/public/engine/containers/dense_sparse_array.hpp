@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine/debug/assertions.hpp"
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ze
+{
+
+/**
+ * SparseArray variant keeping its elements packed in a contiguous array, for data iterated every frame
+ * Indices are stable and go through one indirection, removing swaps the last element into the hole
+ * so element addresses and iteration order are not stable
+ */
+template<typename T>
+class DenseSparseArray
+{
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+public:
+	using ElementType = T;
+	using IteratorType = typename std::vector<T>::iterator;
+	using ConstIteratorType = typename std::vector<T>::const_iterator;
+
+	template<typename... Args>
+	[[nodiscard]] size_t emplace(Args&&... in_args)
+	{
+		size_t index = 0;
+		if (!free_indices.empty())
+		{
+			index = free_indices.back();
+			free_indices.pop_back();
+		}
+		else
+		{
+			index = dense_positions.size();
+			dense_positions.emplace_back(npos);
+		}
+
+		dense_positions[index] = elements.size();
+		elements.emplace_back(std::forward<Args>(in_args)...);
+		element_indices.emplace_back(index);
+		return index;
+	}
+
+	void remove(size_t in_index)
+	{
+		ZE_ASSERT(is_valid(in_index));
+
+		const size_t position = dense_positions[in_index];
+		const size_t last_position = elements.size() - 1;
+		if (position != last_position)
+		{
+			elements[position] = std::move(elements[last_position]);
+			element_indices[position] = element_indices[last_position];
+			dense_positions[element_indices[position]] = position;
+		}
+
+		elements.pop_back();
+		element_indices.pop_back();
+		dense_positions[in_index] = npos;
+		free_indices.emplace_back(in_index);
+	}
+
+	void reserve(size_t in_capacity)
+	{
+		elements.reserve(in_capacity);
+		element_indices.reserve(in_capacity);
+		dense_positions.reserve(in_capacity);
+	}
+
+	IteratorType begin() { return elements.begin(); }
+	ConstIteratorType begin() const { return elements.begin(); }
+	ConstIteratorType cbegin() const { return elements.cbegin(); }
+	IteratorType end() { return elements.end(); }
+	ConstIteratorType end() const { return elements.end(); }
+	ConstIteratorType cend() const { return elements.cend(); }
+
+	ElementType& operator[](const size_t& in_index)
+	{
+		ZE_ASSERT(is_valid(in_index));
+		return elements[dense_positions[in_index]];
+	}
+
+	const ElementType& operator[](const size_t& in_index) const
+	{
+		ZE_ASSERT(is_valid(in_index));
+		return elements[dense_positions[in_index]];
+	}
+
+	[[nodiscard]] bool is_valid(const size_t& in_index) const
+	{
+		return in_index < dense_positions.size() && dense_positions[in_index] != npos;
+	}
+
+	[[nodiscard]] bool is_empty() const { return elements.empty(); }
+
+	/** Packed elements, in no particular order */
+	[[nodiscard]] std::span<T> get_elements() { return elements; }
+	[[nodiscard]] std::span<const T> get_elements() const { return elements; }
+
+	/** Index of the element at in_position in the packed array */
+	[[nodiscard]] size_t get_index(const size_t in_position) const { return element_indices[in_position]; }
+
+	[[nodiscard]] auto get_size() const { return elements.size(); }
+	[[nodiscard]] auto get_capacity() const { return elements.capacity(); }
+private:
+	std::vector<T> elements;
+
+	/** Index of each packed element */
+	std::vector<size_t> element_indices;
+
+	/** Position in the packed array of each index, npos if free */
+	std::vector<size_t> dense_positions;
+	std::vector<size_t> free_indices;
+};
+
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "engine/debug/assertions.hpp"
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ze
+{
+
+template<typename Signature, size_t Bytes = 32>
+class InlineFunction;
+
+/**
+ * Move-only std::function storing callables of up to Bytes bytes inline
+ * Lambdas capturing a few references or handles never allocate, larger callables fall back to the heap
+ * Usage: InlineFunction<void(int)> func = [this](int in_value) { ... };
+ */
+template<typename R, typename... Args, size_t Bytes>
+class InlineFunction<R(Args...), Bytes>
+{
+	struct VTable
+	{
+		R(*invoke)(void*, Args&&...);
+
+		/** Move-construct the callable of the source storage in the destination storage, then destroy the source */
+		void(*relocate)(void*, void*) noexcept;
+		void(*destroy)(void*) noexcept;
+	};
+
+	static constexpr size_t storage_alignment = alignof(std::max_align_t);
+
+	template<typename F>
+	static constexpr bool is_stored_inline = sizeof(F) <= Bytes && alignof(F) <= storage_alignment &&
+		std::is_nothrow_move_constructible_v<F>;
+
+	template<typename F>
+	static F& get_callable(void* in_storage)
+	{
+		if constexpr (is_stored_inline<F>)
+			return *std::launder(static_cast<F*>(in_storage));
+		else
+			return **static_cast<F**>(in_storage);
+	}
+
+	template<typename F>
+	static constexpr VTable vtable_for =
+	{
+		[](void* in_storage, Args&&... in_args) -> R
+		{
+			/** A void function may wrap a callable returning a value, which is discarded */
+			if constexpr (std::is_void_v<R>)
+				std::invoke(get_callable<F>(in_storage), std::forward<Args>(in_args)...);
+			else
+				return std::invoke(get_callable<F>(in_storage), std::forward<Args>(in_args)...);
+		},
+		[](void* in_dst, void* in_src) noexcept
+		{
+			if constexpr (is_stored_inline<F>)
+			{
+				F& src = get_callable<F>(in_src);
+				std::construct_at(static_cast<F*>(in_dst), std::move(src));
+				std::destroy_at(&src);
+			}
+			else
+			{
+				*static_cast<F**>(in_dst) = *static_cast<F**>(in_src);
+			}
+		},
+		[](void* in_storage) noexcept
+		{
+			if constexpr (is_stored_inline<F>)
+				std::destroy_at(&get_callable<F>(in_storage));
+			else
+				delete *static_cast<F**>(in_storage);
+		}
+	};
+
+public:
+	InlineFunction() noexcept : vtable(nullptr) {}
+	InlineFunction(std::nullptr_t) noexcept : vtable(nullptr) {}
+
+	template<typename F>
+		requires (!std::same_as<std::remove_cvref_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+	InlineFunction(F&& in_func)
+	{
+		using Callable = std::decay_t<F>;
+		static_assert(sizeof(Callable*) <= Bytes);
+
+		if constexpr (is_stored_inline<Callable>)
+			std::construct_at(reinterpret_cast<Callable*>(storage), std::forward<F>(in_func));
+		else
+			*reinterpret_cast<Callable**>(storage) = new Callable(std::forward<F>(in_func));
+
+		vtable = &vtable_for<Callable>;
+	}
+
+	InlineFunction(InlineFunction&& in_other) noexcept : vtable(std::exchange(in_other.vtable, nullptr))
+	{
+		if (vtable)
+			vtable->relocate(storage, in_other.storage);
+	}
+
+	~InlineFunction()
+	{
+		reset();
+	}
+
+	InlineFunction& operator=(InlineFunction&& in_other) noexcept
+	{
+		if (this != &in_other)
+		{
+			reset();
+			vtable = std::exchange(in_other.vtable, nullptr);
+			if (vtable)
+				vtable->relocate(storage, in_other.storage);
+		}
+
+		return *this;
+	}
+
+	InlineFunction& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+
+	InlineFunction(const InlineFunction&) = delete;
+	InlineFunction& operator=(const InlineFunction&) = delete;
+
+	R operator()(Args... in_args) const
+	{
+		ZE_CHECK(vtable);
+		return vtable->invoke(storage, std::forward<Args>(in_args)...);
+	}
+
+	void reset() noexcept
+	{
+		if (vtable)
+			std::exchange(vtable, nullptr)->destroy(storage);
+	}
+
+	[[nodiscard]] explicit operator bool() const { return vtable != nullptr; }
+private:
+	const VTable* vtable;
+
+	/** Invoking a const InlineFunction may still mutate its callable, like std::function */
+	alignas(storage_alignment) mutable std::byte storage[Bytes];
+};
+
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "engine/debug/assertions.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace ze
+{
+
+/**
+ * Handle to an element of a SlotMap: a slot index and the generation of the slot when the element was inserted
+ * Slots bump their generation when their element is erased, so a handle to an erased element is detected as stale
+ * even if its slot has been reused since
+ */
+struct SlotMapHandle
+{
+	static constexpr uint32_t null = ~0U;
+
+	uint32_t index = null;
+	uint32_t generation = null;
+
+	constexpr SlotMapHandle() = default;
+	constexpr SlotMapHandle(const uint32_t in_index, const uint32_t in_generation) : index(in_index), generation(in_generation) {}
+
+	/** Pack the handle in a uint64_t, a null handle packs to ~0 */
+	[[nodiscard]] constexpr uint64_t to_u64() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+	[[nodiscard]] static constexpr SlotMapHandle from_u64(const uint64_t in_value)
+	{
+		return SlotMapHandle(static_cast<uint32_t>(in_value), static_cast<uint32_t>(in_value >> 32));
+	}
+
+	constexpr bool operator==(const SlotMapHandle&) const = default;
+	[[nodiscard]] constexpr explicit operator bool() const { return index != null; }
+};
+
+namespace detail
+{
+
+/** An odd generation means the slot holds an element, an even one that it is free */
+[[nodiscard]] constexpr bool is_slot_generation_alive(const uint32_t in_generation) { return in_generation & 1; }
+
+}
+
+/**
+ * Container of elements accessed through generational handles
+ * Elements are packed in a contiguous array for cache-friendly iteration, slots map handles to their position
+ * Insertion and erasure are O(1), erasing swaps the last element into the hole so element addresses are not stable
+ * Not thread-safe, see ThreadSafeSlotMap
+ */
+template<typename T>
+class SlotMap
+{
+	struct Slot
+	{
+		/** Position of the element in the packed array, next free slot if the slot is free */
+		uint32_t position_or_next_free;
+		uint32_t generation;
+	};
+
+public:
+	using ElementType = T;
+	using IteratorType = typename std::vector<T>::iterator;
+	using ConstIteratorType = typename std::vector<T>::const_iterator;
+
+	SlotMap() : free_head(SlotMapHandle::null) {}
+
+	template<typename... Args>
+	[[nodiscard]] SlotMapHandle emplace(Args&&... in_args)
+	{
+		uint32_t index = free_head;
+		if (index != SlotMapHandle::null)
+		{
+			free_head = slots[index].position_or_next_free;
+		}
+		else
+		{
+			ZE_ASSERTF(slots.size() < SlotMapHandle::null, "SlotMap is full ({} slots)", slots.size());
+			index = static_cast<uint32_t>(slots.size());
+			slots.push_back({ 0, 0 });
+		}
+
+		Slot& slot = slots[index];
+		slot.position_or_next_free = static_cast<uint32_t>(elements.size());
+		slot.generation++;
+		elements.emplace_back(std::forward<Args>(in_args)...);
+		element_slots.emplace_back(index);
+
+		return SlotMapHandle(index, slot.generation);
+	}
+
+	/**
+	 * Erase the element of in_handle
+	 * \return False if the handle is null or stale
+	 */
+	bool erase(const SlotMapHandle& in_handle)
+	{
+		if (!contains(in_handle))
+			return false;
+
+		Slot& slot = slots[in_handle.index];
+		const uint32_t position = slot.position_or_next_free;
+		const uint32_t last_position = static_cast<uint32_t>(elements.size() - 1);
+		if (position != last_position)
+		{
+			elements[position] = std::move(elements[last_position]);
+			element_slots[position] = element_slots[last_position];
+			slots[element_slots[position]].position_or_next_free = position;
+		}
+
+		elements.pop_back();
+		element_slots.pop_back();
+
+		slot.generation++;
+		slot.position_or_next_free = free_head;
+		free_head = in_handle.index;
+		return true;
+	}
+
+	void clear()
+	{
+		for (const uint32_t index : element_slots)
+		{
+			Slot& slot = slots[index];
+			slot.generation++;
+			slot.position_or_next_free = free_head;
+			free_head = index;
+		}
+
+		elements.clear();
+		element_slots.clear();
+	}
+
+	void reserve(const size_t in_capacity)
+	{
+		elements.reserve(in_capacity);
+		element_slots.reserve(in_capacity);
+		slots.reserve(in_capacity);
+	}
+
+	/** Element of in_handle, nullptr if the handle is null or stale */
+	[[nodiscard]] T* get(const SlotMapHandle& in_handle)
+	{
+		return contains(in_handle) ? &elements[slots[in_handle.index].position_or_next_free] : nullptr;
+	}
+
+	[[nodiscard]] const T* get(const SlotMapHandle& in_handle) const
+	{
+		return contains(in_handle) ? &elements[slots[in_handle.index].position_or_next_free] : nullptr;
+	}
+
+	ElementType& operator[](const SlotMapHandle& in_handle)
+	{
+		ZE_ASSERT(contains(in_handle));
+		return elements[slots[in_handle.index].position_or_next_free];
+	}
+
+	const ElementType& operator[](const SlotMapHandle& in_handle) const
+	{
+		ZE_ASSERT(contains(in_handle));
+		return elements[slots[in_handle.index].position_or_next_free];
+	}
+
+	[[nodiscard]] bool contains(const SlotMapHandle& in_handle) const
+	{
+		return in_handle.index < slots.size() && slots[in_handle.index].generation == in_handle.generation &&
+			detail::is_slot_generation_alive(in_handle.generation);
+	}
+
+	IteratorType begin() { return elements.begin(); }
+	ConstIteratorType begin() const { return elements.begin(); }
+	ConstIteratorType cbegin() const { return elements.cbegin(); }
+	IteratorType end() { return elements.end(); }
+	ConstIteratorType end() const { return elements.end(); }
+	ConstIteratorType cend() const { return elements.cend(); }
+
+	/** Packed elements, in no particular order */
+	[[nodiscard]] std::span<T> get_elements() { return elements; }
+	[[nodiscard]] std::span<const T> get_elements() const { return elements; }
+
+	/** Handle of the element at in_position in the packed array */
+	[[nodiscard]] SlotMapHandle get_handle(const size_t in_position) const
+	{
+		const uint32_t index = element_slots[in_position];
+		return SlotMapHandle(index, slots[index].generation);
+	}
+
+	[[nodiscard]] bool is_empty() const { return elements.empty(); }
+	[[nodiscard]] auto get_size() const { return elements.size(); }
+	[[nodiscard]] auto get_capacity() const { return elements.capacity(); }
+private:
+	std::vector<T> elements;
+
+	/** Slot of each packed element */
+	std::vector<uint32_t> element_slots;
+	std::vector<Slot> slots;
+	uint32_t free_head;
+};
+
+/**
+ * SlotMap variant that can be used from multiple threads without locking
+ * Elements are stored in fixed-size pages that are never moved, so element addresses are stable and lookups
+ * never race with a growing array. Free slots form a lock-free tagged stack
+ * Inserting, erasing and looking up different elements concurrently is safe,
+ * erasing an element while another thread is using it is not
+ */
+template<typename T, size_t PageSize = 256, size_t MaxPages = 4096>
+class ThreadSafeSlotMap
+{
+	struct Slot
+	{
+		std::atomic_uint32_t generation = 0;
+		std::atomic_uint32_t next_free = SlotMapHandle::null;
+		alignas(T) std::byte storage[sizeof(T)];
+
+		T* get_element() { return std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	static_assert(PageSize * MaxPages <= SlotMapHandle::null, "Too many slots to be indexed by a SlotMapHandle");
+
+public:
+	ThreadSafeSlotMap() : free_head(SlotMapHandle::null), slot_count(0), size(0)
+	{
+		for (auto& page : pages)
+			page.store(nullptr, std::memory_order_relaxed);
+	}
+
+	~ThreadSafeSlotMap()
+	{
+		for_each([](const SlotMapHandle&, T& in_element)
+		{
+			in_element.~T();
+		});
+
+		for (auto& page : pages)
+			delete[] page.load(std::memory_order_relaxed);
+	}
+
+	ThreadSafeSlotMap(const ThreadSafeSlotMap&) = delete;
+	ThreadSafeSlotMap& operator=(const ThreadSafeSlotMap&) = delete;
+
+	template<typename... Args>
+	[[nodiscard]] SlotMapHandle emplace(Args&&... in_args)
+	{
+		uint32_t index = pop_free_slot();
+		if (index == SlotMapHandle::null)
+		{
+			index = slot_count.fetch_add(1, std::memory_order_relaxed);
+			ZE_ASSERTF(index < PageSize * MaxPages, "ThreadSafeSlotMap is full ({} slots)", PageSize * MaxPages);
+		}
+
+		Slot& slot = get_or_allocate_page(index / PageSize)[index % PageSize];
+		new (slot.storage) T(std::forward<Args>(in_args)...);
+
+		/** Publish the element, lookups acquire the generation */
+		const uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+		slot.generation.store(generation, std::memory_order_release);
+		size.fetch_add(1, std::memory_order_relaxed);
+
+		return SlotMapHandle(index, generation);
+	}
+
+	/**
+	 * Erase the element of in_handle
+	 * \return False if the handle is null or stale
+	 */
+	bool erase(const SlotMapHandle& in_handle)
+	{
+		Slot* slot = get_slot(in_handle);
+		if (!slot)
+			return false;
+
+		slot->get_element()->~T();
+		slot->generation.store(in_handle.generation + 1, std::memory_order_release);
+		size.fetch_sub(1, std::memory_order_relaxed);
+		push_free_slot(in_handle.index, *slot);
+		return true;
+	}
+
+	/** Element of in_handle, nullptr if the handle is null or stale */
+	[[nodiscard]] T* get(const SlotMapHandle& in_handle) const
+	{
+		Slot* slot = get_slot(in_handle);
+		return slot ? slot->get_element() : nullptr;
+	}
+
+	[[nodiscard]] bool contains(const SlotMapHandle& in_handle) const
+	{
+		return get_slot(in_handle) != nullptr;
+	}
+
+	/**
+	 * Call in_function(handle, element) for every element, page by page
+	 * Must not run concurrently with erase
+	 */
+	template<typename Func>
+	void for_each(Func&& in_function)
+	{
+		const size_t count = slot_count.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; ++i)
+		{
+			Slot* page = pages[i / PageSize].load(std::memory_order_acquire);
+			if (!page)
+			{
+				i += PageSize - 1 - (i % PageSize);
+				continue;
+			}
+
+			Slot& slot = page[i % PageSize];
+			const uint32_t generation = slot.generation.load(std::memory_order_acquire);
+			if (detail::is_slot_generation_alive(generation))
+				in_function(SlotMapHandle(static_cast<uint32_t>(i), generation), *slot.get_element());
+		}
+	}
+
+	[[nodiscard]] size_t get_size() const { return size.load(std::memory_order_relaxed); }
+	[[nodiscard]] bool is_empty() const { return get_size() == 0; }
+private:
+	[[nodiscard]] Slot* get_slot(const SlotMapHandle& in_handle) const
+	{
+		if (!detail::is_slot_generation_alive(in_handle.generation) || in_handle.index >= PageSize * MaxPages)
+			return nullptr;
+
+		Slot* page = pages[in_handle.index / PageSize].load(std::memory_order_acquire);
+		if (!page)
+			return nullptr;
+
+		Slot& slot = page[in_handle.index % PageSize];
+		return slot.generation.load(std::memory_order_acquire) == in_handle.generation ? &slot : nullptr;
+	}
+
+	Slot* get_or_allocate_page(const size_t in_page)
+	{
+		Slot* page = pages[in_page].load(std::memory_order_acquire);
+		if (page)
+			return page;
+
+		/** Several threads may race to allocate the same page, only one wins */
+		Slot* new_page = new Slot[PageSize];
+		if (pages[in_page].compare_exchange_strong(page, new_page, std::memory_order_acq_rel, std::memory_order_acquire))
+			return new_page;
+
+		delete[] new_page;
+		return page;
+	}
+
+	/**
+	 * Free list head packs a tag in its high 32 bits, bumped on every pop so a slot popped and pushed back
+	 * by other threads between our load and our CAS (ABA) makes the CAS fail
+	 */
+	uint32_t pop_free_slot()
+	{
+		uint64_t head = free_head.load(std::memory_order_acquire);
+		while (true)
+		{
+			const uint32_t index = static_cast<uint32_t>(head);
+			if (index == SlotMapHandle::null)
+				return SlotMapHandle::null;
+
+			Slot& slot = pages[index / PageSize].load(std::memory_order_acquire)[index % PageSize];
+			const uint64_t new_head = (((head >> 32) + 1) << 32) | slot.next_free.load(std::memory_order_relaxed);
+			if (free_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+				return index;
+		}
+	}
+
+	void push_free_slot(const uint32_t in_index, Slot& in_slot)
+	{
+		uint64_t head = free_head.load(std::memory_order_relaxed);
+		do
+		{
+			in_slot.next_free.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+		} while (!free_head.compare_exchange_weak(head, (head & 0xFFFFFFFF00000000ULL) | in_index,
+			std::memory_order_release, std::memory_order_relaxed));
+	}
+private:
+	std::array<std::atomic<Slot*>, MaxPages> pages;
+	std::atomic_uint64_t free_head;
+
+	/** Slots handed out at least once */
+	std::atomic_uint32_t slot_count;
+	std::atomic_size_t size;
+};
+
+}
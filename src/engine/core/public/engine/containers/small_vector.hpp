@@ -0,0 +1,274 @@
+#pragma once
+
+#include "engine/debug/assertions.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace ze
+{
+
+/**
+ * Vector storing up to N elements inline, only allocating on the heap when it grows past N
+ * Made for short-lived or small lists built on hot paths (e.g. per draw or per frame), that almost never need the heap
+ * Converts to std::span like std::vector, element addresses are invalidated when it grows or is moved
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+	static_assert(N > 0, "Use std::vector for vectors without inline storage");
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	static constexpr size_t inline_capacity = N;
+
+	SmallVector() noexcept : elements(get_inline_elements()), count(0), element_capacity(N) {}
+
+	SmallVector(std::initializer_list<T> in_list) : SmallVector()
+	{
+		append(in_list.begin(), in_list.end());
+	}
+
+	explicit SmallVector(const std::span<const T>& in_elements) : SmallVector()
+	{
+		append(in_elements.begin(), in_elements.end());
+	}
+
+	explicit SmallVector(const size_t in_count, const T& in_value = T()) : SmallVector()
+	{
+		resize(in_count, in_value);
+	}
+
+	SmallVector(const SmallVector& in_other) : SmallVector()
+	{
+		append(in_other.begin(), in_other.end());
+	}
+
+	SmallVector(SmallVector&& in_other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector()
+	{
+		move_from(std::move(in_other));
+	}
+
+	~SmallVector()
+	{
+		std::destroy_n(elements, count);
+		free_heap_elements();
+	}
+
+	SmallVector& operator=(const SmallVector& in_other)
+	{
+		if (this != &in_other)
+		{
+			clear();
+			append(in_other.begin(), in_other.end());
+		}
+
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& in_other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &in_other)
+		{
+			clear();
+			move_from(std::move(in_other));
+		}
+
+		return *this;
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... in_args)
+	{
+		if (count == element_capacity) [[unlikely]]
+			return grow_and_emplace_back(std::forward<Args>(in_args)...);
+
+		T* element = std::construct_at(elements + count, std::forward<Args>(in_args)...);
+		++count;
+		return *element;
+	}
+
+	void push_back(const T& in_value) { emplace_back(in_value); }
+	void push_back(T&& in_value) { emplace_back(std::move(in_value)); }
+
+	void pop_back()
+	{
+		ZE_CHECK(count > 0);
+		std::destroy_at(elements + --count);
+	}
+
+	void clear()
+	{
+		std::destroy_n(elements, count);
+		count = 0;
+	}
+
+	void reserve(const size_t in_capacity)
+	{
+		if (in_capacity > element_capacity)
+			reallocate(in_capacity);
+	}
+
+	void resize(const size_t in_count)
+	{
+		resize_impl(in_count, [](T* in_element) { std::construct_at(in_element); });
+	}
+
+	void resize(const size_t in_count, const T& in_value)
+	{
+		resize_impl(in_count, [&](T* in_element) { std::construct_at(in_element, in_value); });
+	}
+
+	T& operator[](const size_t in_index)
+	{
+		ZE_CHECK(in_index < count);
+		return elements[in_index];
+	}
+
+	const T& operator[](const size_t in_index) const
+	{
+		ZE_CHECK(in_index < count);
+		return elements[in_index];
+	}
+
+	bool operator==(const SmallVector& in_other) const
+	{
+		return std::equal(begin(), end(), in_other.begin(), in_other.end());
+	}
+
+	[[nodiscard]] T& front() { return (*this)[0]; }
+	[[nodiscard]] const T& front() const { return (*this)[0]; }
+	[[nodiscard]] T& back() { return (*this)[count - 1]; }
+	[[nodiscard]] const T& back() const { return (*this)[count - 1]; }
+
+	[[nodiscard]] T* data() { return elements; }
+	[[nodiscard]] const T* data() const { return elements; }
+	[[nodiscard]] size_t size() const { return count; }
+	[[nodiscard]] size_t capacity() const { return element_capacity; }
+	[[nodiscard]] bool empty() const { return count == 0; }
+
+	/** \return True if the elements are still in the inline storage */
+	[[nodiscard]] bool is_inline() const { return elements == get_inline_elements(); }
+
+	iterator begin() { return elements; }
+	iterator end() { return elements + count; }
+	const_iterator begin() const { return elements; }
+	const_iterator end() const { return elements + count; }
+	const_iterator cbegin() const { return elements; }
+	const_iterator cend() const { return elements + count; }
+private:
+	T* get_inline_elements() { return reinterpret_cast<T*>(inline_storage); }
+	const T* get_inline_elements() const { return reinterpret_cast<const T*>(inline_storage); }
+
+	template<typename Iterator>
+	void append(Iterator in_first, Iterator in_last)
+	{
+		const size_t new_count = count + static_cast<size_t>(std::distance(in_first, in_last));
+		reserve(new_count);
+		std::uninitialized_copy(in_first, in_last, elements + count);
+		count = new_count;
+	}
+
+	/** Steal the heap elements of in_other, or move its inline ones. Expects this vector to be empty */
+	void move_from(SmallVector&& in_other)
+	{
+		if (!in_other.is_inline())
+		{
+			free_heap_elements();
+			elements = std::exchange(in_other.elements, in_other.get_inline_elements());
+			count = std::exchange(in_other.count, 0);
+			element_capacity = std::exchange(in_other.element_capacity, N);
+			return;
+		}
+
+		reserve(in_other.count);
+		std::uninitialized_move_n(in_other.elements, in_other.count, elements);
+		count = in_other.count;
+		in_other.clear();
+	}
+
+	size_t get_grown_capacity(const size_t in_min_capacity) const
+	{
+		return std::max(element_capacity * 2, in_min_capacity);
+	}
+
+	void reallocate(const size_t in_capacity)
+	{
+		T* new_elements = std::allocator<T>().allocate(in_capacity);
+		std::uninitialized_move_n(elements, count, new_elements);
+		std::destroy_n(elements, count);
+		free_heap_elements();
+		elements = new_elements;
+		element_capacity = in_capacity;
+	}
+
+	/** The new element is constructed before the old ones move, so in_args may refer to an element of this vector */
+	template<typename... Args>
+	T& grow_and_emplace_back(Args&&... in_args)
+	{
+		const size_t new_capacity = get_grown_capacity(count + 1);
+		T* new_elements = std::allocator<T>().allocate(new_capacity);
+		T* element = std::construct_at(new_elements + count, std::forward<Args>(in_args)...);
+		std::uninitialized_move_n(elements, count, new_elements);
+		std::destroy_n(elements, count);
+		free_heap_elements();
+		elements = new_elements;
+		element_capacity = new_capacity;
+		++count;
+		return *element;
+	}
+
+	/** Like grow_and_emplace_back, new elements are constructed before the old ones move */
+	template<typename Constructor>
+	void resize_impl(const size_t in_count, Constructor&& in_constructor)
+	{
+		if (in_count < count)
+		{
+			std::destroy(elements + in_count, elements + count);
+		}
+		else if (in_count > element_capacity)
+		{
+			const size_t new_capacity = get_grown_capacity(in_count);
+			T* new_elements = std::allocator<T>().allocate(new_capacity);
+			for (size_t i = count; i < in_count; ++i)
+				in_constructor(new_elements + i);
+
+			std::uninitialized_move_n(elements, count, new_elements);
+			std::destroy_n(elements, count);
+			free_heap_elements();
+			elements = new_elements;
+			element_capacity = new_capacity;
+		}
+		else
+		{
+			for (size_t i = count; i < in_count; ++i)
+				in_constructor(elements + i);
+		}
+
+		count = in_count;
+	}
+
+	void free_heap_elements()
+	{
+		if (!is_inline())
+			std::allocator<T>().deallocate(elements, element_capacity);
+	}
+private:
+	T* elements;
+	size_t count;
+	size_t element_capacity;
+	alignas(T) std::byte inline_storage[sizeof(T) * N];
+};
+
+}
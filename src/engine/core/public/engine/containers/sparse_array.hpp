@@ -1,21 +1,44 @@
 #pragma once
 
 #include "engine/debug/assertions.hpp"
-#include <boost/dynamic_bitset.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
 
 namespace ze
 {
 
+/**
+ * Array of elements with stable indices, removed indices are reused
+ * Free slots form an intrusive free list so emplace and remove are O(1), the storage grows geometrically
+ * Iteration skips holes by scanning the allocation bitset a word at a time
+ */
 template<typename T>
 class SparseArray
 {
+	static constexpr size_t initial_capacity = 64;
+	static constexpr size_t bits_per_word = 64;
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	/** A free slot stores the index of the next free slot */
+	union Slot
+	{
+		Slot() {}
+		~Slot() {}
+
+		T value;
+		size_t next_free;
+	};
+
 public:
 	template<typename U>
 	class Iterator
 	{
 	public:
 		using ArrayType = std::conditional_t<std::is_const_v<U>, const SparseArray<T>&, SparseArray<T>&>;
-		using iterator_category = std::random_access_iterator_tag;
+		using iterator_category = std::forward_iterator_tag;
 		using value_type = U;
 		using difference_type = std::ptrdiff_t;
 		using pointer = U*;
@@ -28,43 +51,21 @@ public:
 
 		U& operator*()
 		{
-			return array[current_idx];
+			return array.elements[current_idx].value;
 		}
 
 		const U& operator*() const
 		{
-			return array[current_idx];
+			return array.elements[current_idx].value;
 		}
 
 		Iterator& operator++()
 		{
-			while (++current_idx < array.get_capacity())
-			{
-				if (array.allocated_indices[current_idx])
-					return *this;
-			}
-
+			current_idx = array.get_next_valid_index(current_idx + 1);
 			return *this;
 		}
 
-		Iterator& operator=(const Iterator& other)
-		{
-			array = other.array;
-			current_idx = other.current_idx;
-			return *this;
-		}
-
-		Iterator& operator-(difference_type in_diff)
-		{
-			current_idx -= in_diff;
-			ZE_CHECK(current_idx > 0 && current_idx <= array.get_capacity() - 1);
-			return *this;
-		}
-
-		friend difference_type operator-(const Iterator& left, const Iterator& right)
-		{
-			return right - left;
-		}
+		[[nodiscard]] size_t get_index() const { return current_idx; }
 
 		friend bool operator==(const Iterator& left, const Iterator& right)
 		{
@@ -84,29 +85,32 @@ public:
 	using IteratorType = Iterator<T>;
 	using ConstIteratorType = const Iterator<const T>;
 
-	SparseArray() : elements(nullptr), size(0), capacity(0) {}
+	SparseArray() : elements(nullptr), size(0), capacity(0), used_count(0), free_head(npos) {}
 	~SparseArray()
 	{
 		if (elements)
 		{
-			for (size_t i = 0; i < capacity; ++i)
+			if constexpr (!std::is_trivially_destructible_v<T>)
 			{
-				if (is_valid(i))
-					remove(i);
+				for (size_t i = get_next_valid_index(0); i < capacity; i = get_next_valid_index(i + 1))
+					elements[i].value.~T();
 			}
 
 			std::free(elements);
 		}
 	}
 
+	SparseArray(const SparseArray&) = delete;
+	SparseArray& operator=(const SparseArray&) = delete;
+
 	template<typename... Args>
 	[[nodiscard]] size_t emplace(Args&&... in_args)
 	{
 		size_t index = get_free_index();
 		ZE_CHECKF(!is_valid(index), "Index {} already contains a element!", index);
 
-		new (elements + index) T(std::forward<Args>(in_args)...);
-		allocated_indices[index] = true;
+		new (&elements[index].value) T(std::forward<Args>(in_args)...);
+		set_allocated(index, true);
 		size++;
 
 		return index;
@@ -114,14 +118,26 @@ public:
 
 	void remove(size_t in_index)
 	{
-		elements[in_index].~T();
-		allocated_indices[in_index] = false;
+		ZE_ASSERT(is_valid(in_index));
+		elements[in_index].value.~T();
+		set_allocated(in_index, false);
+		elements[in_index].next_free = free_head;
+		free_head = in_index;
 		size--;
 	}
 
+	/**
+	 * Make room for at least in_capacity elements without growing
+	 */
+	void reserve(size_t in_capacity)
+	{
+		if (in_capacity > capacity)
+			realloc(in_capacity);
+	}
+
 	IteratorType begin()
 	{
-		return IteratorType(*this, 0);
+		return IteratorType(*this, get_next_valid_index(0));
 	}
 
 	ConstIteratorType begin() const
@@ -131,12 +147,12 @@ public:
 
 	ConstIteratorType cbegin() const
 	{
-		return ConstIteratorType(*this, 0);
+		return ConstIteratorType(*this, get_next_valid_index(0));
 	}
 
 	IteratorType end()
 	{
-		return IteratorType(*this, size);
+		return IteratorType(*this, capacity);
 	}
 
 	ConstIteratorType end() const
@@ -146,7 +162,7 @@ public:
 
 	ConstIteratorType cend() const
 	{
-		return ConstIteratorType(*this, size);
+		return ConstIteratorType(*this, capacity);
 	}
 
 	ElementType& operator[](const size_t& in_index)
@@ -161,12 +177,12 @@ public:
 
 	[[nodiscard]] bool is_valid(const size_t& in_index) const
 	{
-		return in_index < capacity && allocated_indices[in_index];
+		return in_index < capacity && is_allocated(in_index);
 	}
 
 	[[nodiscard]] bool is_empty() const
 	{
-		return allocated_indices.none();
+		return size == 0;
 	}
 
 	[[nodiscard]] auto get_size() const { return size;  }
@@ -175,60 +191,113 @@ private:
 	[[nodiscard]] T& at(const size_t& in_index)
 	{
 		ZE_ASSERT(is_valid(in_index));
-		return elements[in_index];
+		return elements[in_index].value;
 	}
 
 	[[nodiscard]] const T& at(const size_t& in_index) const
 	{
 		ZE_ASSERT(is_valid(in_index));
-		return elements[in_index];
+		return elements[in_index].value;
+	}
+
+	[[nodiscard]] bool is_allocated(const size_t in_index) const
+	{
+		return allocated_indices[in_index / bits_per_word] & (uint64_t(1) << (in_index % bits_per_word));
+	}
+
+	void set_allocated(const size_t in_index, const bool in_allocated)
+	{
+		const uint64_t mask = uint64_t(1) << (in_index % bits_per_word);
+		if (in_allocated)
+			allocated_indices[in_index / bits_per_word] |= mask;
+		else
+			allocated_indices[in_index / bits_per_word] &= ~mask;
+	}
+
+	/**
+	 * First valid index >= in_index, capacity if none
+	 */
+	[[nodiscard]] size_t get_next_valid_index(const size_t in_index) const
+	{
+		if (in_index >= capacity)
+			return capacity;
+
+		size_t word_idx = in_index / bits_per_word;
+		uint64_t word = allocated_indices[word_idx] & (~uint64_t(0) << (in_index % bits_per_word));
+		while (word == 0)
+		{
+			if (++word_idx == allocated_indices.size())
+				return capacity;
+
+			word = allocated_indices[word_idx];
+		}
+
+		return word_idx * bits_per_word + static_cast<size_t>(std::countr_zero(word));
 	}
 
 	[[nodiscard]] size_t get_free_index()
 	{
-		for (size_t i = 0; i < capacity; ++i)
-			if (!allocated_indices[i])
-				return i;
+		if (free_head != npos)
+		{
+			const size_t index = free_head;
+			free_head = elements[index].next_free;
+			return index;
+		}
 
-		realloc(capacity + 1);
-		return capacity - 1;
+		/** Slots past used_count have never been used, so they are not in the free list */
+		if (used_count == capacity)
+			realloc(std::max(initial_capacity, capacity * 2));
+
+		return used_count++;
 	}
 
 	void realloc(size_t new_capacity)
 	{
-		if (elements)
+		/** Running out of memory is fatal, ZE_ASSERTF doesn't return */
+		Slot* new_elements = nullptr;
+		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			T* old_elements = elements;
-			elements = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
-			for (size_t i = 0; i < capacity; ++i)
+			/** Slot isn't trivially copyable because of its user-provided constructor and destructor, its members are */
+			new_elements = static_cast<Slot*>(std::realloc(static_cast<void*>(elements), new_capacity * sizeof(Slot)));
+			ZE_ASSERTF(new_elements, "Failed to grow SparseArray to {} elements", new_capacity);
+		}
+		else
+		{
+			new_elements = static_cast<Slot*>(std::malloc(new_capacity * sizeof(Slot)));
+			ZE_ASSERTF(new_elements, "Failed to grow SparseArray to {} elements", new_capacity);
+
+			if (elements)
 			{
-				if (is_valid(i))
+				for (size_t i = 0; i < used_count; ++i)
 				{
-					if constexpr (std::is_move_constructible_v<T>)
-						new (elements + i) T(std::move(old_elements[i]));
+					if (is_allocated(i))
+					{
+						new (&new_elements[i].value) T(std::move(elements[i].value));
+						elements[i].value.~T();
+					}
 					else
-						elements[i] = std::move(old_elements[i]);
-
-					old_elements[i].~T();
+					{
+						new_elements[i].next_free = elements[i].next_free;
+					}
 				}
-			}
 
-			std::free(old_elements);
-		}
-		else
-		{
-			elements = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+				std::free(elements);
+			}
 		}
 
-		ZE_CHECK(elements);
+		elements = new_elements;
 		capacity = new_capacity;
-		allocated_indices.resize(new_capacity);
+		allocated_indices.resize((new_capacity + bits_per_word - 1) / bits_per_word);
 	}
 private:
-	T* elements;
+	Slot* elements;
 	size_t size;
 	size_t capacity;
-	boost::dynamic_bitset<> allocated_indices;
+
+	/** Slots [0, used_count) have been used at least once */
+	size_t used_count;
+	size_t free_head;
+	std::vector<uint64_t> allocated_indices;
 };
 
-}
\ No newline at end of file
+}
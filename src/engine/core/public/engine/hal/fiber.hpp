@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+/** Implemented in private/engine/hal/<platform>/fiber.cpp */
+namespace ze::hal
+{
+
+/** Opaque fiber handle */
+struct Fiber;
+
+using FiberEntry = void(*)(void* in_userdata);
+
+/**
+ * Convert the calling thread to a fiber so it can switch to other fibers
+ */
+Fiber* convert_thread_to_fiber();
+void convert_fiber_to_thread(Fiber* in_fiber);
+
+/**
+ * Create a fiber that will run in_entry the first time it is switched to
+ * in_entry must never return
+ */
+Fiber* create_fiber(size_t in_stack_size, FiberEntry in_entry, void* in_userdata);
+void destroy_fiber(Fiber* in_fiber);
+
+/**
+ * Save the current context in in_from and resume in_to
+ * in_from must be the currently running fiber
+ */
+void switch_to_fiber(Fiber* in_from, Fiber* in_to);
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <thread>
+
+namespace ze::hal
+{
+
+/**
+ * Names are kept in a registry so any thread name can be queried
+ * The kernel name (truncated to 15 characters) is only set when naming the calling thread
+ */
+std::string get_thread_name(std::thread::id id);
+void set_thread_name(std::thread::id id, const std::string& in_name);
+
+/**
+ * Number of logical cores, affinity masks can only address the first 64
+ */
+uint32_t get_logical_core_count();
+
+/**
+ * Restrict the calling thread to the logical cores set in in_mask (bit i = core i)
+ */
+bool set_current_thread_affinity(uint64_t in_mask);
+
+/**
+ * Maps to the thread nice value, raising the priority requires CAP_SYS_NICE
+ */
+bool set_current_thread_priority(ThreadPriority in_priority);
+
+}
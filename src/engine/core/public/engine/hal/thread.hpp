@@ -1,9 +1,25 @@
 #pragma once
 
 #include "engine/platform_macros.hpp"
+#include <cstdint>
+
+namespace ze::hal
+{
+
+enum class ThreadPriority
+{
+	Low,
+	Normal,
+	High,
+	Highest
+};
+
+}
 
 #if ZE_PLATFORM(WINDOWS)
 #include "windows/thread.hpp"
+#elif ZE_PLATFORM(LINUX)
+#include "posix/thread.hpp"
 #else
 #error "Platform not supported"
-#endif
\ No newline at end of file
+#endif
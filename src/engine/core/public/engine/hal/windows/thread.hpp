@@ -6,4 +6,16 @@ namespace ze::hal
 std::string get_thread_name(std::thread::id id);
 void set_thread_name(std::thread::id id, const std::string& in_name);
 
-}
\ No newline at end of file
+/**
+ * Number of logical cores, affinity masks can only address the first 64
+ */
+uint32_t get_logical_core_count();
+
+/**
+ * Restrict the calling thread to the logical cores set in in_mask (bit i = core i)
+ */
+bool set_current_thread_affinity(uint64_t in_mask);
+
+bool set_current_thread_priority(ThreadPriority in_priority);
+
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <robin_hood.h>
 
@@ -15,4 +20,83 @@ void hash_combine(size_t& seed, const T& v)
 	seed ^= H()(v) + 0x9e3779b97f4a7c15 + (seed << 12) + (seed >> 4);
 }
 
-}
\ No newline at end of file
+struct Hash128
+{
+	uint64_t low;
+	uint64_t high;
+
+	bool operator==(const Hash128& in_other) const { return low == in_other.low && high == in_other.high; }
+};
+
+/**
+ * Hash a span of bytes (XXH3, vectorized for large inputs)
+ * Not cryptographic, but stable across runs and platforms so it can be used for on-disk caches
+ */
+[[nodiscard]] uint64_t hash_bytes(const void* in_data, size_t in_size, uint64_t in_seed = 0);
+[[nodiscard]] Hash128 hash_bytes_128(const void* in_data, size_t in_size, uint64_t in_seed = 0);
+
+/**
+ * Streaming version of hash_bytes, the result is the same as hashing all the updates concatenated
+ * Updates are buffered so hashing a key field by field is cheap, and inputs that fit in the buffer are hashed in one shot
+ */
+class Hasher
+{
+public:
+	explicit Hasher(uint64_t in_seed = 0) : buffer_size(0), seed(in_seed), has_state(false) {}
+
+	void update(const void* in_data, size_t in_size)
+	{
+		if (in_size == 0)
+			return;
+
+		if (buffer_size + in_size > buffer_capacity) [[unlikely]]
+		{
+			update_state(in_data, in_size);
+			return;
+		}
+
+		std::memcpy(buffer + buffer_size, in_data, in_size);
+		buffer_size += in_size;
+	}
+
+	template<typename T>
+		requires std::is_scalar_v<T>
+	void update(const T in_value)
+	{
+		update(&in_value, sizeof(T));
+	}
+
+	/** Only the characters are hashed, write the size too when several strings follow each other */
+	void update(std::string_view in_string)
+	{
+		update(in_string.data(), in_string.size());
+	}
+
+	[[nodiscard]] uint64_t finish() const;
+	[[nodiscard]] Hash128 finish_128() const;
+private:
+	/** Flush the buffer and in_data to the XXH3 state */
+	void update_state(const void* in_data, size_t in_size);
+private:
+	static constexpr size_t buffer_capacity = 256;
+
+	/** XXH3_state_t, kept opaque so xxhash isn't included everywhere. Only initialized once the buffer overflows */
+	static constexpr size_t state_size = 576;
+	alignas(64) std::byte state[state_size];
+	uint8_t buffer[buffer_capacity];
+	size_t buffer_size;
+	uint64_t seed;
+	bool has_state;
+};
+
+}
+
+namespace std
+{
+
+template<> struct hash<ze::Hash128>
+{
+	size_t operator()(const ze::Hash128& in_hash) const noexcept { return in_hash.low; }
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ze::logger
+{
+
+/**
+ * Binary logs store deferred records without formatting them, the format strings are written once
+ *
+ * Layout (native endianness): binary_log_magic, binary_log_version (uint32_t), then entries starting with a
+ * BinaryLogEntryKind byte:
+ * - Format: uint32_t id, uint8_t severity, uint16_t category size, category, uint32_t format size, format,
+ *   uint8_t argument count, DeferredArgType per argument
+ * - Thread: uint32_t id, uint16_t name size, name
+ * - Record: uint32_t format id, uint32_t thread id, int64_t system clock time in ns, uint32_t size, arguments
+ */
+inline constexpr char binary_log_magic[8] = { 'Z', 'E', 'B', 'I', 'N', 'L', 'O', 'G' };
+inline constexpr uint32_t binary_log_version = 1;
+
+enum class BinaryLogEntryKind : uint8_t
+{
+	Format = 1,
+	Thread,
+	Record,
+};
+
+/**
+ * Write deferred records to a binary file instead of formatting them, read it back with the logdecoder tool
+ * Immediate messages are still sent to the sinks
+ * \return False if the file couldn't be opened
+ */
+bool open_binary_log(const std::string& in_path);
+void close_binary_log();
+
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "engine/logger/logger.hpp"
+#include <array>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace ze::logger
+{
+
+/**
+ * Types arguments of deferred messages are stored as
+ */
+enum class DeferredArgType : uint8_t
+{
+	Bool,
+	Char,
+	Int,
+	UInt,
+	Double,
+	String,
+	Pointer,
+};
+
+/**
+ * A deferred log call site, built at compile time
+ * Its address identifies the site in deferred records, so nothing is registered at runtime
+ */
+struct DeferredFormat
+{
+	SeverityFlagBits severity;
+	Category category;
+	std::string_view format;
+	std::span<const DeferredArgType> arg_types;
+};
+
+namespace detail
+{
+
+template<typename T>
+consteval DeferredArgType get_deferred_arg_type()
+{
+	using Type = std::remove_cvref_t<T>;
+
+	if constexpr (std::is_same_v<Type, bool>)
+		return DeferredArgType::Bool;
+	else if constexpr (std::is_same_v<Type, char>)
+		return DeferredArgType::Char;
+	else if constexpr (std::is_enum_v<Type>)
+		return get_deferred_arg_type<std::underlying_type_t<Type>>();
+	else if constexpr (std::is_integral_v<Type>)
+		return std::is_signed_v<Type> ? DeferredArgType::Int : DeferredArgType::UInt;
+	else if constexpr (std::is_floating_point_v<Type>)
+		return DeferredArgType::Double;
+	else if constexpr (std::is_convertible_v<const Type&, std::string_view>)
+		return DeferredArgType::String;
+	else if constexpr (std::is_pointer_v<Type> || std::is_null_pointer_v<Type>)
+		return DeferredArgType::Pointer;
+	else
+		static_assert(std::is_void_v<Type>, "Type can't be used in a deferred log, format it or log it immediately");
+}
+
+/**
+ * Type the argument is formatted as
+ */
+template<typename T>
+using DeferredFormattedType = std::tuple_element_t<static_cast<size_t>(get_deferred_arg_type<T>()),
+	std::tuple<bool, char, int64_t, uint64_t, double, std::string_view, const void*>>;
+
+template<typename... Args>
+inline constexpr std::array<DeferredArgType, sizeof...(Args)> deferred_arg_types = { get_deferred_arg_type<Args>()... };
+
+/**
+ * One instance per call site (Site is a unique lambda type) and argument types
+ */
+template<typename Site, typename... Args>
+struct DeferredSite
+{
+	static constexpr DeferredFormat format = { Site{}().severity, Site{}().category, Site{}().format,
+		std::span<const DeferredArgType>(deferred_arg_types<Args...>) };
+};
+
+template<typename T>
+size_t get_deferred_arg_size(const T& in_arg)
+{
+	if constexpr (get_deferred_arg_type<T>() == DeferredArgType::String)
+		return sizeof(uint32_t) + std::string_view(in_arg).size();
+	else if constexpr (get_deferred_arg_type<T>() == DeferredArgType::Bool ||
+		get_deferred_arg_type<T>() == DeferredArgType::Char)
+		return 1;
+	else
+		return 8;
+}
+
+template<typename T>
+uint8_t* write_deferred_arg(uint8_t* in_dst, const T& in_arg)
+{
+	constexpr DeferredArgType type = get_deferred_arg_type<T>();
+	if constexpr (type == DeferredArgType::String)
+	{
+		const std::string_view string(in_arg);
+		const uint32_t size = static_cast<uint32_t>(string.size());
+		std::memcpy(in_dst, &size, sizeof(size));
+		std::memcpy(in_dst + sizeof(size), string.data(), size);
+		return in_dst + sizeof(size) + size;
+	}
+	else if constexpr (type == DeferredArgType::Bool || type == DeferredArgType::Char)
+	{
+		*in_dst = static_cast<uint8_t>(in_arg);
+		return in_dst + 1;
+	}
+	else
+	{
+		using StoredType = std::conditional_t<type == DeferredArgType::Int, int64_t,
+			std::conditional_t<type == DeferredArgType::UInt, uint64_t,
+			std::conditional_t<type == DeferredArgType::Double, double, uint64_t>>>;
+
+		StoredType value;
+		if constexpr (type == DeferredArgType::Pointer)
+			value = reinterpret_cast<uint64_t>(in_arg);
+		else
+			value = static_cast<StoredType>(in_arg);
+		std::memcpy(in_dst, &value, sizeof(value));
+		return in_dst + sizeof(value);
+	}
+}
+
+/**
+ * Reserve a record of in_size argument bytes in the calling thread buffer
+ * \return nullptr if the buffer is full, the message is then counted as dropped
+ */
+uint8_t* begin_deferred_record(const DeferredFormat& in_format, size_t in_size);
+void end_deferred_record();
+
+template<typename Site, typename CategoryType, typename... Args>
+void log_deferred(Args&&... in_args)
+{
+	constexpr const DeferredFormat& format = DeferredSite<Site, std::remove_cvref_t<Args>...>::format;
+
+	/** Same compile-time check as the immediate functions, with the types the arguments will be formatted as */
+	[[maybe_unused]] constexpr fmt::format_string<DeferredFormattedType<Args>...> checked_format(format.format);
+
+	if constexpr (!is_compiled_in<CategoryType>(format.severity))
+		return;
+
+	if (!format.category.is_enabled(format.severity))
+		return;
+
+	const size_t size = (get_deferred_arg_size(in_args) + ... + 0);
+	if (uint8_t* data = begin_deferred_record(format, size))
+	{
+		((data = write_deferred_arg(data, in_args)), ...);
+		end_deferred_record();
+	}
+}
+
+/**
+ * Format the arguments of a deferred record, used by the logger thread and the log decoder
+ * \return False if the data doesn't match the argument types
+ */
+bool format_deferred(std::string_view in_format, std::span<const DeferredArgType> in_arg_types,
+	std::span<const uint8_t> in_data, std::string& out_message);
+
+}
+
+/**
+ * Log a message whose formatting is deferred to the logger thread (or offline with a binary log)
+ * Only the raw argument bytes are copied by the caller, strings are copied too so they don't need to outlive the call
+ * Usage: ZE_LOG_DEFERRED(Verbose, log_jobsystem, "Job {} took {} us", job_id, time);
+ */
+#define ZE_LOG_DEFERRED(Severity, LogCategory, Format, ...) \
+	ze::logger::detail::log_deferred<decltype([]() { \
+		return ze::logger::DeferredFormat { ze::logger::SeverityFlagBits::Severity, LogCategory, Format, {} }; }), \
+		std::remove_cvref_t<decltype(LogCategory)>>(__VA_ARGS__)
+
+}
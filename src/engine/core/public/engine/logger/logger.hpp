@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <chrono>
 #include <thread>
@@ -22,18 +26,74 @@ enum class SeverityFlagBits : uint8_t
 	Fatal
 };
 
+/**
+ * Runtime minimum severity of a category
+ * Each module has its own instance of a category level, they register themselves so set_category_level reaches all
+ * of them
+ */
+class CategoryLevel
+{
+public:
+	CategoryLevel(const std::string_view& in_name);
+	~CategoryLevel();
+
+	CategoryLevel(const CategoryLevel&) = delete;
+	CategoryLevel& operator=(const CategoryLevel&) = delete;
+
+	[[nodiscard]] bool is_enabled(SeverityFlagBits in_severity) const
+	{
+		return in_severity >= min_severity.load(std::memory_order_relaxed);
+	}
+
+	void set_min_severity(SeverityFlagBits in_severity) { min_severity.store(in_severity, std::memory_order_relaxed); }
+	[[nodiscard]] std::string_view get_name() const { return name; }
+private:
+	std::string_view name;
+	std::atomic<SeverityFlagBits> min_severity;
+};
+
 struct Category
 {
 	std::string_view name;
 
+	/** nullptr for categories without a runtime level, they are always enabled */
+	CategoryLevel* level = nullptr;
+
 	Category() = default;
 	constexpr Category(const std::string_view& in_name) : name(in_name) {}
+	constexpr Category(const std::string_view& in_name, CategoryLevel& in_level) : name(in_name), level(&in_level) {}
+
+	[[nodiscard]] bool is_enabled(SeverityFlagBits in_severity) const
+	{
+		return !level || level->is_enabled(in_severity);
+	}
+};
+
+/**
+ * Category whose messages below MinSeverity are removed at compile time
+ */
+template<SeverityFlagBits MinSeverity>
+struct StaticCategory : Category
+{
+	static constexpr SeverityFlagBits min_severity = MinSeverity;
+
+	using Category::Category;
 };
 
+/** Verbose messages are only compiled in debug builds */
+#if ZE_BUILD(IS_DEBUG)
+inline constexpr SeverityFlagBits default_min_severity = SeverityFlagBits::Verbose;
+#else
+inline constexpr SeverityFlagBits default_min_severity = SeverityFlagBits::Info;
+#endif
+
 struct Message
 {
 	std::chrono::system_clock::time_point time;
 	std::thread::id thread;
+
+	/** Cached name of the thread that logged the message */
+	std::string_view thread_name;
 	SeverityFlagBits severity;
 	Category category;
 	std::string message;
@@ -41,19 +101,88 @@ struct Message
 	Message() : severity(SeverityFlagBits::Info) {}
 };
 
-void log(SeverityFlagBits in_severity, const Category& in_category, const std::string& in_message);
+/**
+ * Queue a message, sinks are called from the logger thread
+ * When the queue is full the message is dropped, see get_dropped_message_count
+ * Fatal messages are written synchronously after flushing the queue, then the program is terminated
+ */
+void log(SeverityFlagBits in_severity, const Category& in_category, std::string_view in_message);
 void add_sink(std::unique_ptr<Sink>&& in_sink);
 void set_pattern(const std::string& in_pattern);
 
+/**
+ * Wait until every message queued before the call has been written to the sinks
+ */
+void flush();
+
+/**
+ * Flush and stop the logger thread, messages logged afterwards are written synchronously
+ */
+void shutdown();
+
+/**
+ * Number of messages dropped because the queue was full
+ */
+uint64_t get_dropped_message_count();
+
+/**
+ * Set the runtime minimum severity of every category named in_name, including ones registered later
+ */
+void set_category_level(std::string_view in_name, SeverityFlagBits in_severity);
+
+/**
+ * Minimum severity of categories without their own level
+ */
+void set_default_level(SeverityFlagBits in_severity);
+
+/**
+ * Parse a comma-separated level list, a bare severity sets the default level
+ * e.g. "warn,vulkan=verbose,jobsystem=error"
+ * \return False if an entry is invalid, the valid entries are still applied
+ */
+bool parse_levels(std::string_view in_levels);
+
 namespace detail
 {
 
 std::string_view severity_to_string(SeverityFlagBits in_severity);
+bool string_to_severity(std::string_view in_string, SeverityFlagBits& out_severity);
 std::string format_message(const std::string& in_pattern, const Message& in_message);
 
 }
 
-#define ZE_DEFINE_LOG_CATEGORY(Name) constexpr ze::logger::Category log_##Name(#Name);
+namespace detail
+{
+
+template<typename T>
+constexpr SeverityFlagBits get_compile_time_min_severity()
+{
+	if constexpr (requires { T::min_severity; })
+		return T::min_severity;
+	else
+		return SeverityFlagBits::Verbose;
+}
+
+/** Whether messages of in_severity logged to a CategoryType are compiled in */
+template<typename CategoryType>
+constexpr bool is_compiled_in(SeverityFlagBits in_severity)
+{
+	return in_severity >= get_compile_time_min_severity<CategoryType>();
+}
+
+template<typename T>
+concept CategoryType = std::derived_from<T, Category>;
+
+}
+
+/**
+ * Define a category log_Name, messages below MinSeverity are removed at compile time
+ */
+#define ZE_DEFINE_LOG_CATEGORY_WITH_MIN_SEVERITY(Name, MinSeverity) \
+	inline ze::logger::CategoryLevel log_level_##Name(#Name); \
+	constexpr ze::logger::StaticCategory<MinSeverity> log_##Name(#Name, log_level_##Name);
+
+#define ZE_DEFINE_LOG_CATEGORY(Name) ZE_DEFINE_LOG_CATEGORY_WITH_MIN_SEVERITY(Name, ze::logger::default_min_severity)
 
 ZE_DEFINE_LOG_CATEGORY(unknown);
 
@@ -61,19 +190,26 @@ template<typename... Args>
 void logf(SeverityFlagBits in_severity, const Category& in_category,
 	const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
-	log(in_severity, in_category, fmt::format(in_format, std::forward<Args>(in_args)...));
+	if (!in_category.is_enabled(in_severity))
+		return;
+
+	fmt::memory_buffer buffer;
+	fmt::format_to(std::back_inserter(buffer), in_format, std::forward<Args>(in_args)...);
+	log(in_severity, in_category, std::string_view(buffer.data(), buffer.size()));
 }
 
-#if ZE_BUILD(IS_DEBUG)
-template<typename... Args>
-void verbose(const Category& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+template<SeverityFlagBits Severity, detail::CategoryType C, typename... Args>
+void logf(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
-	logf(SeverityFlagBits::Verbose, in_category, in_format, std::forward<Args>(in_args)...);
+	if constexpr (detail::is_compiled_in<C>(Severity))
+		logf(Severity, in_category, in_format, std::forward<Args>(in_args)...);
+}
+
+template<detail::CategoryType C, typename... Args>
+void verbose(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+{
+	logf<SeverityFlagBits::Verbose>(in_category, in_format, std::forward<Args>(in_args)...);
 }
-#else
-template<typename... Args>
-void verbose(const Category&, const fmt::format_string<Args...>&, Args&&...) {}
-#endif
 
 template<typename... Args>
 void verbose(const fmt::format_string<Args...>& in_format, Args&&... in_args)
@@ -81,10 +217,10 @@ void verbose(const fmt::format_string<Args...>& in_format, Args&&... in_args)
 	verbose(log_unknown, in_format, std::forward<Args>(in_args)...);
 }
 
-template<typename... Args>
-void info(const Category& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+template<detail::CategoryType C, typename... Args>
+void info(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
-	logf(SeverityFlagBits::Info, in_category, in_format, std::forward<Args>(in_args)...);
+	logf<SeverityFlagBits::Info>(in_category, in_format, std::forward<Args>(in_args)...);
 }
 
 template<typename... Args>
@@ -93,22 +229,22 @@ void info(const fmt::format_string<Args...>& in_format, Args&&... in_args)
 	info(log_unknown, in_format, std::forward<Args>(in_args)...);
 }
 
-template<typename... Args>
-void warn(const Category& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+template<detail::CategoryType C, typename... Args>
+void warn(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
-	logf(SeverityFlagBits::Warn, in_category, in_format, std::forward<Args>(in_args)...);
+	logf<SeverityFlagBits::Warn>(in_category, in_format, std::forward<Args>(in_args)...);
 }
 
 template<typename... Args>
-void warn(const std::string_view& in_format, Args&&... in_args)
+void warn(const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
 	warn(log_unknown, in_format, std::forward<Args>(in_args)...);
 }
 
-template<typename... Args>
-void error(const Category& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+template<detail::CategoryType C, typename... Args>
+void error(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
-	logf(SeverityFlagBits::Error, in_category, in_format, std::forward<Args>(in_args)...);
+	logf<SeverityFlagBits::Error>(in_category, in_format, std::forward<Args>(in_args)...);
 }
 
 template<typename... Args>
@@ -117,8 +253,9 @@ void error(const fmt::format_string<Args...>& in_format, Args&&... in_args)
 	error(log_unknown, in_format, std::forward<Args>(in_args)...);
 }
 
-template<typename... Args>
-void fatal(const Category& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
+/** Fatal messages can't be filtered, no level is above fatal */
+template<detail::CategoryType C, typename... Args>
+void fatal(const C& in_category, const fmt::format_string<Args...>& in_format, Args&&... in_args)
 {
 	logf(SeverityFlagBits::Fatal, in_category, in_format, std::forward<Args>(in_args)...);
 }
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "engine/core.hpp"
+#include "engine/memory/tracking.hpp"
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ze
+{
+
+/**
+ * Linear allocator for data living until the end of the frame at most
+ * Each thread bumps a pointer in its own blocks so allocating takes no lock, and freeing does nothing
+ * reset() is O(1): it starts a new epoch, each thread rewinds its blocks the next time it allocates.
+ * Blocks are kept across frames so a steady-state frame gets no memory from the system
+ * reset() must not run while other threads use memory of the current frame
+ */
+class FrameArena
+{
+	/** Threads whose index is past this count share a locked state */
+	static constexpr uint32_t max_thread_states = 64;
+
+	struct Block
+	{
+		uint8_t* memory;
+		size_t size;
+	};
+
+	struct alignas(std::hardware_destructive_interference_size) ThreadState
+	{
+		/** Written by the owner only, atomic as get_used_bytes reads it */
+		std::atomic_uint64_t epoch = 0;
+		size_t block_idx = 0;
+		uint8_t* cursor = nullptr;
+		uint8_t* end = nullptr;
+		std::vector<Block> blocks;
+
+		/** Single writer, bytes allocated during the state epoch */
+		std::atomic_size_t used_bytes = 0;
+	};
+
+public:
+	static constexpr size_t default_block_size = 256 * 1024;
+
+	explicit FrameArena(const size_t in_block_size = default_block_size, const MemoryTag in_tag = MemoryTag::Core);
+	~FrameArena();
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	/**
+	 * [THREAD SAFE] Get in_size bytes aligned on in_alignment, valid until the next reset
+	 */
+	[[nodiscard]] void* allocate(const size_t in_size, const size_t in_alignment = alignof(std::max_align_t));
+
+	template<typename T>
+	[[nodiscard]] T* allocate_array(const size_t in_count)
+	{
+		return static_cast<T*>(allocate(sizeof(T) * in_count, alignof(T)));
+	}
+
+	/**
+	 * Free every allocation, in O(1)
+	 */
+	void reset();
+
+	/** Bytes allocated since the last reset */
+	[[nodiscard]] size_t get_used_bytes() const;
+
+	/** Number of blocks allocated from the system since the arena creation */
+	[[nodiscard]] size_t get_block_allocation_count() const { return block_allocation_count.load(std::memory_order_relaxed); }
+private:
+	void* allocate_from(ThreadState& in_state, const size_t in_size, const size_t in_alignment);
+	void rewind(ThreadState& in_state, const uint64_t in_epoch);
+	void next_block(ThreadState& in_state, const size_t in_min_size);
+private:
+	size_t block_size;
+	MemoryTag tag;
+	std::atomic_uint64_t epoch;
+	std::atomic_size_t block_allocation_count;
+	std::unique_ptr<ThreadState[]> thread_states;
+	ThreadState shared_state;
+	std::mutex shared_state_mutex;
+};
+
+/**
+ * std::pmr adapter of a FrameArena, deallocation does nothing
+ */
+class FrameMemoryResource final : public std::pmr::memory_resource
+{
+public:
+	explicit FrameMemoryResource(FrameArena& in_arena) : arena(in_arena) {}
+private:
+	void* do_allocate(const size_t in_bytes, const size_t in_alignment) override
+	{
+		return arena.allocate(in_bytes, in_alignment);
+	}
+
+	void do_deallocate(void*, size_t, size_t) override {}
+
+	bool do_is_equal(const std::pmr::memory_resource& in_other) const noexcept override
+	{
+		return this == &in_other;
+	}
+private:
+	FrameArena& arena;
+};
+
+/**
+ * Engine frame arena, reset by gfx::Device::new_frame
+ */
+FrameArena& get_frame_arena();
+
+/**
+ * Memory resource of the engine frame arena, for std::pmr containers holding frame-transient data
+ */
+std::pmr::memory_resource* get_frame_memory_resource();
+
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "engine/core.hpp"
+#include <cstddef>
+#include <new>
+#include <string_view>
+
+namespace ze
+{
+
+/**
+ * Subsystem an allocation is accounted to
+ */
+enum class MemoryTag : uint8_t
+{
+	Untagged,
+	Core,
+	Logger,
+	Jobs,
+	Gfx,
+	Shaders,
+	RenderGraph,
+	Filesystem,
+
+	Count
+};
+
+}
+
+namespace ze::memory
+{
+
+static constexpr size_t tag_count = static_cast<size_t>(MemoryTag::Count);
+
+struct TagStats
+{
+	size_t current_bytes;
+	size_t peak_bytes;
+	uint64_t allocation_count;
+	uint64_t free_count;
+
+	/** 0 if the tag has no budget */
+	size_t budget_bytes;
+};
+
+/**
+ * [THREAD SAFE] Allocate memory accounted to in_tag
+ * \return nullptr if out of memory
+ */
+[[nodiscard]] void* allocate(const size_t in_size, const size_t in_alignment, const MemoryTag in_tag);
+
+/**
+ * [THREAD SAFE] Free memory from allocate, with the same size, alignment and tag
+ */
+void deallocate(void* in_ptr, const size_t in_size, const size_t in_alignment, const MemoryTag in_tag);
+
+/**
+ * [THREAD SAFE] Account memory obtained by other means (e.g. a third-party allocator) to in_tag
+ * Counters are batched per thread and published every few KBs, so stats of other threads may lag a little
+ */
+void track_allocation(const MemoryTag in_tag, const size_t in_size);
+void track_free(const MemoryTag in_tag, const size_t in_size);
+
+/**
+ * Publish the counters batched by the calling thread
+ */
+void flush_thread_stats();
+
+/**
+ * Tag of allocations without an explicit one (global new when built with ZE_WITH_MEMORY_TRACKING)
+ */
+[[nodiscard]] MemoryTag get_current_tag();
+
+/**
+ * Set the current tag of the calling thread until the scope ends
+ * Usage: memory::ScopedTag tag(MemoryTag::Shaders);
+ */
+class ScopedTag
+{
+public:
+	explicit ScopedTag(const MemoryTag in_tag);
+	~ScopedTag();
+
+	ScopedTag(const ScopedTag&) = delete;
+	ScopedTag& operator=(const ScopedTag&) = delete;
+private:
+	MemoryTag previous_tag;
+};
+
+/**
+ * [THREAD SAFE] Stats of a tag, peaks are tracked at the batching granularity
+ */
+[[nodiscard]] TagStats get_stats(const MemoryTag in_tag);
+
+/**
+ * [THREAD SAFE] Warn once each time a tag goes over in_bytes, 0 removes the budget
+ */
+void set_budget(const MemoryTag in_tag, const size_t in_bytes);
+
+/**
+ * Log the stats of every tag
+ */
+void log_stats();
+
+/**
+ * Standard allocator accounting to Tag
+ */
+template<typename T, MemoryTag Tag>
+class TagAllocator
+{
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = TagAllocator<U, Tag>;
+	};
+
+	TagAllocator() noexcept = default;
+
+	template<typename U>
+	TagAllocator(const TagAllocator<U, Tag>&) noexcept {}
+
+	[[nodiscard]] T* allocate(const size_t in_count)
+	{
+		T* ptr = static_cast<T*>(memory::allocate(sizeof(T) * in_count, alignof(T), Tag));
+		ZE_ASSERTF(ptr, "Out of memory ({} bytes, tag {})", sizeof(T) * in_count, static_cast<uint32_t>(Tag));
+		return ptr;
+	}
+
+	void deallocate(T* in_ptr, const size_t in_count) noexcept
+	{
+		memory::deallocate(in_ptr, sizeof(T) * in_count, alignof(T), Tag);
+	}
+
+	template<typename U>
+	bool operator==(const TagAllocator<U, Tag>&) const noexcept { return true; }
+};
+
+}
+
+namespace std
+{
+
+inline std::string_view to_string(const ze::MemoryTag& in_tag)
+{
+	switch(in_tag)
+	{
+	default:
+		return "Unknown";
+	case ze::MemoryTag::Untagged:
+		return "Untagged";
+	case ze::MemoryTag::Core:
+		return "Core";
+	case ze::MemoryTag::Logger:
+		return "Logger";
+	case ze::MemoryTag::Jobs:
+		return "Jobs";
+	case ze::MemoryTag::Gfx:
+		return "Gfx";
+	case ze::MemoryTag::Shaders:
+		return "Shaders";
+	case ze::MemoryTag::RenderGraph:
+		return "RenderGraph";
+	case ze::MemoryTag::Filesystem:
+		return "Filesystem";
+	}
+}
+
+}
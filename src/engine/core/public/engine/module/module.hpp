@@ -1,5 +1,6 @@
 #pragma once
 
+#include "engine/name.hpp"
 #include <string_view>
 
 namespace ze
@@ -26,10 +27,10 @@ public:
 		handle = in_handle;
 	}
 
-	[[nodiscard]] const std::string& get_name() const { return name; }
+	[[nodiscard]] Name get_name() const { return name; }
 	[[nodiscard]] void* get_handle() const { return handle; }
 private:
-	std::string name;
+	Name name;
 	void* handle;
 };
 
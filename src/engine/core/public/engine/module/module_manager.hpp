@@ -1,8 +1,11 @@
 #pragma once
 
 #include "engine/core.hpp"
+#include <atomic>
+#include <span>
 #include <string_view>
 #include <vector>
+#include "engine/name.hpp"
 #include "engine/result.hpp"
 
 namespace ze
@@ -15,19 +18,39 @@ enum class ModuleLoadError
 	InvalidModule,
 	MissingImplementModuleMacro,
 	NotFound,
+	UnknownDependency,
+	DependencyCycle,
 };
 
 /**
  * Load the specified module, a correspond dll/lib must be present
+ * Names are case-insensitive and loaded modules are looked up in a hash map, prefer ModuleRef on hot paths
+ * [THREAD SAFE] Loading a module another thread is loading waits for it to be loaded (see set_module_load_wait_func)
  */
 [[nodiscard]] Result<Module*, ModuleLoadError> load_module(const std::string_view& name);
 
+/**
+ * Called by load_module, without holding any lock, while the requested module is being loaded by another thread
+ * \return false if there was nothing to do, load_module then sleeps a bit before calling it again
+ */
+using ModuleLoadWaitFunc = bool(*)();
+
+/**
+ * [THREAD SAFE] Make threads waiting for a module loaded by another thread call in_func instead of blocking,
+ * e.g to keep executing jobs on a job system worker (see load_modules_parallel), nullptr to block again
+ * \return The previous function
+ */
+ModuleLoadWaitFunc set_module_load_wait_func(const ModuleLoadWaitFunc in_func);
+
 /**
  * Unload the specified module
  * \warn Will also unload the corresponding DLL!
  */
 void unload_module(const std::string_view& name);
 
+/**
+ * Unload every module, in the reverse order they were loaded in so modules are unloaded before their dependencies
+ */
 void unload_all_modules();
 
 /**
@@ -46,4 +69,92 @@ template<typename T>
 	return nullptr;
 }
 
-}
\ No newline at end of file
+namespace detail
+{
+
+/** Incremented each time modules are unloaded, so ModuleRef caches are refreshed */
+[[nodiscard]] uint64_t get_module_generation();
+
+}
+
+/**
+ * Cached typed accessor to a module, looked up on first use and again only once modules have been unloaded
+ * Usage: static constinit ModuleRef<filesystem::Module> filesystem_module("FileSystem");
+ * [THREAD SAFE] Usually a couple of atomic loads
+ */
+template<typename T>
+	requires std::derived_from<T, Module>
+class ModuleRef
+{
+public:
+	/** in_name must outlive the ModuleRef (e.g. a string literal) */
+	constexpr explicit ModuleRef(const std::string_view in_name) : name(in_name), module(nullptr), generation(~0ULL) {}
+
+	/** \return nullptr if the module couldn't be loaded, the next call tries again */
+	[[nodiscard]] T* get() const
+	{
+		const uint64_t current_generation = detail::get_module_generation();
+		if (generation.load(std::memory_order_acquire) != current_generation) [[unlikely]]
+		{
+			T* loaded_module = get_module<T>(name);
+			if (!loaded_module)
+				return nullptr;
+
+			module.store(loaded_module, std::memory_order_relaxed);
+			generation.store(current_generation, std::memory_order_release);
+		}
+
+		return module.load(std::memory_order_relaxed);
+	}
+
+	T* operator->() const { return get(); }
+	T& operator*() const { return *get(); }
+private:
+	std::string_view name;
+	mutable std::atomic<T*> module;
+	mutable std::atomic_uint64_t generation;
+};
+
+/**
+ * A module to load and the modules it depends on, see load_modules
+ */
+struct ModuleDesc
+{
+	std::string_view name;
+	std::vector<std::string_view> dependencies;
+};
+
+/**
+ * Resolve the dependencies of each module of in_modules to indices in in_modules
+ * Dependencies outside of in_modules must already be loaded and are skipped
+ * \return UnknownDependency if a dependency isn't loaded nor part of in_modules, DependencyCycle if modules depend
+ * on each other
+ */
+[[nodiscard]] Result<std::vector<std::vector<size_t>>, ModuleLoadError> resolve_module_dependencies(
+	const std::span<const ModuleDesc>& in_modules);
+
+/**
+ * Load in_modules one after the other, each after its dependencies
+ * See load_modules_parallel (engine module) to load independent modules in parallel on the job system
+ * \return False if the dependencies are invalid or a module failed to load
+ */
+bool load_modules(const std::span<const ModuleDesc>& in_modules);
+
+/**
+ * Time spent loading a module: loading its library and constructing it
+ * Modules loading other modules from their constructor include the time spent loading them
+ */
+struct ModuleLoadTime
+{
+	Name name;
+	double load_ms;
+};
+
+/**
+ * [THREAD SAFE] Load times of the loaded modules, in load order
+ */
+[[nodiscard]] std::vector<ModuleLoadTime> get_module_load_times();
+
+void log_module_load_times();
+
+}
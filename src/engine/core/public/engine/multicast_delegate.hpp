@@ -1,7 +1,7 @@
 #pragma once
 
+#include "engine/containers/inline_function.hpp"
 #include <vector>
-#include <functional>
 
 namespace ze
 {
@@ -14,9 +14,10 @@ class MulticastDelegate
 	using FuncType = void(Args...);
 
 public:
-	void bind(std::function<FuncType> in_func)
+	template<typename F>
+	void bind(F&& in_func)
 	{
-		functions.emplace_back(in_func);
+		functions.emplace_back(std::forward<F>(in_func));
 	}
 
 	void call(Args&&... in_args)
@@ -27,7 +28,7 @@ public:
 		}
 	}
 private:
-	std::vector<std::function<FuncType>> functions;
+	std::vector<InlineFunction<FuncType>> functions;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <fmt/format.h>
+#include <robin_hood.h>
+
+namespace ze
+{
+
+namespace detail
+{
+
+/**
+ * 64-bit FNV-1a, usable at compile time
+ */
+constexpr uint64_t hash_name(std::string_view in_string)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+	for (const char c : in_string)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+struct HashedString
+{
+	std::string_view string;
+	uint64_t hash;
+};
+
+}
+
+/**
+ * An interned string: names are stored once in a global table and identified by a 32-bit id
+ * Comparing names compares ids and hashing a name returns its precomputed hash, so they are cheap map keys
+ * Creating a name from a string hashes it and looks it up in the table, prefer ZE_NAME for literals
+ * The default name is the empty name
+ * [THREAD SAFE]
+ */
+class Name
+{
+public:
+	constexpr Name() : id(0), hash(0) {}
+	Name(std::string_view in_string) : Name(detail::HashedString { in_string, detail::hash_name(in_string) }) {}
+	Name(const char* in_string) : Name(std::string_view(in_string)) {}
+	Name(const std::string& in_string) : Name(std::string_view(in_string)) {}
+	explicit Name(const detail::HashedString& in_string);
+
+	/**
+	 * The interned string, valid until the program exits
+	 */
+	[[nodiscard]] std::string_view get_string() const;
+
+	[[nodiscard]] uint32_t get_id() const { return id; }
+
+	/** Hash of the string, stable between runs unlike the id */
+	[[nodiscard]] uint32_t get_hash() const { return hash; }
+	[[nodiscard]] bool is_empty() const { return id == 0; }
+
+	friend bool operator==(const Name& in_left, const Name& in_right) { return in_left.id == in_right.id; }
+private:
+	uint32_t id;
+	uint32_t hash;
+};
+
+/**
+ * Name of a string literal, the string is hashed at compile time and interned once
+ */
+#define ZE_NAME(String) \
+	([]() -> const ze::Name& \
+	{ \
+		static constexpr ze::detail::HashedString hashed_string { String, ze::detail::hash_name(String) }; \
+		static const ze::Name name(hashed_string); \
+		return name; \
+	}())
+
+}
+
+namespace std
+{
+
+/** Also used by robin_hood maps */
+template<> struct hash<ze::Name>
+{
+	size_t operator()(const ze::Name& in_name) const noexcept { return in_name.get_hash(); }
+};
+
+}
+
+template<>
+struct fmt::formatter<ze::Name> : fmt::formatter<std::string_view>
+{
+	template<typename FormatContext>
+	auto format(const ze::Name& in_name, FormatContext& in_context) const
+	{
+		return fmt::formatter<std::string_view>::format(in_name.get_string(), in_context);
+	}
+};
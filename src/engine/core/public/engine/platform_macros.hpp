@@ -41,6 +41,9 @@
 
 /** Return 1 if feature is enabled */
 #define ZE_FEATURE_PRIVATE_DEFINITION_PROFILING() ZE_DEFINED(ZE_HAS_PROFILING)
+#define ZE_FEATURE_PRIVATE_DEFINITION_CPU_PROFILER() ZE_DEFINED(ZE_HAS_CPU_PROFILER)
+#define ZE_FEATURE_PRIVATE_DEFINITION_MEMORY_TRACKING() ZE_DEFINED(ZE_HAS_MEMORY_TRACKING)
+#define ZE_FEATURE_PRIVATE_DEFINITION_MEMORY_PROFILING() ZE_DEFINED(ZE_HAS_MEMORY_PROFILING)
 #define ZE_FEATURE(X) ZE_FEATURE_PRIVATE_DEFINITION_##X()
 
 /** Dll symbol export/import */
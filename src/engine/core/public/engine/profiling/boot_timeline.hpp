@@ -0,0 +1,94 @@
+#pragma once
+
+#include "engine/profiling/profiler.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Timeline of the engine startup, from main to the first presented frame
+ *
+ * Boot phases are recorded whether or not a profiler capture is running, they are few and recording one takes a lock.
+ * Once the first frame is presented the time to first frame and the phases are logged, and written as JSON when a
+ * report path was set (e.g. --boot-report=boot.json) so it can be tracked across releases.
+ */
+namespace ze::boot
+{
+
+/**
+ * Times are relative to the boot start
+ */
+struct Phase
+{
+	std::string name;
+	std::string thread;
+	uint64_t start_ns;
+	uint64_t end_ns;
+};
+
+/**
+ * Start the timeline, call it first thing in main
+ */
+void begin();
+
+/**
+ * [THREAD SAFE] Record a phase, in_start_ns and in_end_ns are profiler::get_time_ns times
+ */
+void add_phase(const std::string_view& in_name, const uint64_t in_start_ns, const uint64_t in_end_ns);
+
+/**
+ * Record the enclosing scope as a phase, in_name must outlive it (e.g. a string literal)
+ */
+class ScopedPhase
+{
+public:
+	explicit ScopedPhase(const std::string_view& in_name) : name(in_name), start_ns(profiler::get_time_ns()) {}
+
+	~ScopedPhase()
+	{
+		add_phase(name, start_ns, profiler::get_time_ns());
+	}
+
+	ScopedPhase(const ScopedPhase&) = delete;
+	ScopedPhase& operator=(const ScopedPhase&) = delete;
+private:
+	std::string_view name;
+	uint64_t start_ns;
+};
+
+/**
+ * Write the report to in_path once the first frame is presented
+ */
+void set_report_path(const std::string& in_path);
+
+/**
+ * End the timeline, called by the engine loop once the first frame has been presented. Later calls are ignored
+ */
+void mark_first_frame();
+
+/** \return An empty optional if the first frame hasn't been presented yet */
+[[nodiscard]] std::optional<uint64_t> get_time_to_first_frame_ns();
+
+/** [THREAD SAFE] Phases recorded so far, sorted by start time */
+[[nodiscard]] std::vector<Phase> get_phases();
+
+/**
+ * Write the boot report as JSON:
+ * { "time_to_first_frame_ms": 812.5,
+ *   "phases": [ { "name": "Create device", "thread": "Worker 2", "start_ms": 40.1, "duration_ms": 120.3 }, ... ],
+ *   "modules": [ { "name": "VulkanGfx", "load_ms": 12.4 }, ... ] }
+ * time_to_first_frame_ms is null if the first frame hasn't been presented yet
+ * \return False if the file couldn't be opened
+ */
+bool write_report(const std::string& in_path);
+
+}
+
+/**
+ * Record the enclosing scope as a boot phase, also profiled as a zone. Name must be a string literal
+ */
+#define ZE_BOOT_PHASE(Name) \
+	ze::boot::ScopedPhase ZE_PROFILER_PRIVATE_CONCAT(ze_boot_phase_, __LINE__)(Name); \
+	ZE_PROFILE_SCOPE(Name)
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "engine/core.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#if ZE_FEATURE(PROFILING)
+#include <Tracy.hpp>
+#endif
+
+/**
+ * Built-in CPU profiler, usable without Tracy (e.g. headless on build machines)
+ *
+ * Zones are only recorded while a capture is running: outside of a capture a zone costs a call and a relaxed load.
+ * Each thread writes its zones to its own ring buffer without any lock, the oldest zones of a thread are dropped
+ * when a capture records more than its buffer holds.
+ * Captures can be exported to the Chrome trace-event JSON format (chrome://tracing, Perfetto) or to a compact binary
+ * format, and per-zone statistics can be queried from code.
+ */
+namespace ze::profiler
+{
+
+/**
+ * Static description of a zone, created by the ZE_PROFILE_* macros
+ */
+struct ZoneDesc
+{
+	const char* name;
+	const char* file;
+	uint32_t line;
+};
+
+/** Monotonic clock used by zones, in nanoseconds */
+[[nodiscard]] uint64_t get_time_ns();
+
+namespace detail
+{
+
+/** \return Start time of the zone, 0 if no capture is running */
+[[nodiscard]] uint64_t begin_zone();
+void end_zone(const ZoneDesc* in_desc, const uint64_t in_start_ns);
+
+}
+
+class ScopedZone
+{
+public:
+	explicit ScopedZone(const ZoneDesc* in_desc) : desc(in_desc), start_ns(detail::begin_zone()) {}
+
+	~ScopedZone()
+	{
+		if (start_ns != 0)
+			detail::end_zone(desc, start_ns);
+	}
+
+	ScopedZone(const ScopedZone&) = delete;
+	ScopedZone& operator=(const ScopedZone&) = delete;
+private:
+	const ZoneDesc* desc;
+	uint64_t start_ns;
+};
+
+struct CaptureZone
+{
+	std::string name;
+	std::string file;
+	uint32_t line;
+};
+
+/**
+ * Times are relative to the capture start
+ */
+struct CaptureEvent
+{
+	/** Index in Capture::zones */
+	uint32_t zone;
+	uint64_t start_ns;
+	uint64_t end_ns;
+};
+
+struct CaptureThread
+{
+	std::string name;
+	uint32_t id;
+
+	/** Sorted by end time */
+	std::vector<CaptureEvent> events;
+};
+
+struct Capture
+{
+	std::vector<CaptureZone> zones;
+	std::vector<CaptureThread> threads;
+
+	/** Start time of each captured frame, empty if the capture wasn't made of frames */
+	std::vector<uint64_t> frame_start_ns;
+	uint64_t duration_ns = 0;
+
+	/** Zones lost because a thread ring buffer was full */
+	uint64_t dropped_events = 0;
+};
+
+/**
+ * Durations of every occurrence of a zone in a capture, in milliseconds
+ */
+struct ZoneStats
+{
+	std::string name;
+	uint64_t count;
+	double total_ms;
+	double mean_ms;
+	double min_ms;
+	double max_ms;
+	double p50_ms;
+	double p99_ms;
+};
+
+/**
+ * Capacity (in zones, rounded up to a power of two) of the ring buffers of threads recording their first zone after
+ * this call
+ */
+void set_thread_buffer_capacity(const size_t in_capacity);
+
+/**
+ * [THREAD SAFE] Start recording zones of every thread, does nothing if a capture is already running
+ */
+void begin_capture();
+
+/**
+ * Stop the running capture and collect the zones of every thread
+ */
+[[nodiscard]] Capture end_capture();
+
+[[nodiscard]] bool is_capturing();
+
+/**
+ * Capture the next in_frame_count frames, the capture starts at the next mark_frame
+ * Get it with take_frame_capture once the frames have been processed
+ */
+void request_frame_capture(const uint32_t in_frame_count);
+
+/**
+ * Get the capture made by request_frame_capture, if completed. Cheap enough to be polled every frame
+ */
+[[nodiscard]] std::optional<Capture> take_frame_capture();
+
+/**
+ * Mark the start of a new frame, called by the engine loop through ZE_PROFILE_FRAME
+ */
+void mark_frame();
+
+/**
+ * Statistics of every zone of in_capture, sorted by total time
+ */
+[[nodiscard]] std::vector<ZoneStats> compute_zone_stats(const Capture& in_capture);
+[[nodiscard]] std::optional<ZoneStats> get_zone_stats(const Capture& in_capture, std::string_view in_name);
+
+/**
+ * Write in_capture as Chrome trace events (JSON)
+ * \return False if the file couldn't be opened
+ */
+bool write_chrome_trace(const Capture& in_capture, const std::string& in_path);
+
+/**
+ * Binary captures are much smaller and faster to write than JSON, convert them with the profconverter tool
+ *
+ * Layout (native endianness): binary_capture_magic, binary_capture_version (uint32_t), uint64_t duration in ns,
+ * uint64_t dropped events, uint32_t frame count, frame start times (uint64_t),
+ * uint32_t zone count, per zone: uint16_t name size, name, uint16_t file size, file, uint32_t line,
+ * uint32_t thread count, per thread: uint32_t id, uint16_t name size, name, uint32_t event count,
+ * events as uint32_t zone, uint64_t start in ns, uint64_t end in ns
+ */
+inline constexpr char binary_capture_magic[8] = { 'Z', 'E', 'P', 'R', 'O', 'F', 'I', 'L' };
+inline constexpr uint32_t binary_capture_version = 1;
+
+bool write_binary_capture(const Capture& in_capture, const std::string& in_path);
+
+/**
+ * \return An empty optional if the file couldn't be read or isn't a valid capture
+ */
+[[nodiscard]] std::optional<Capture> read_binary_capture(const std::string& in_path);
+
+}
+
+#define ZE_PROFILER_PRIVATE_CONCAT_IMPL(A, B) A##B
+#define ZE_PROFILER_PRIVATE_CONCAT(A, B) ZE_PROFILER_PRIVATE_CONCAT_IMPL(A, B)
+
+#if ZE_FEATURE(PROFILING)
+#define ZE_PROFILER_PRIVATE_TRACY_ZONE(Name) ZoneScopedN(Name)
+#define ZE_PROFILER_PRIVATE_TRACY_FRAME() FrameMark
+#else
+#define ZE_PROFILER_PRIVATE_TRACY_ZONE(Name)
+#define ZE_PROFILER_PRIVATE_TRACY_FRAME()
+#endif
+
+/**
+ * Profile the enclosing scope, Name must be a string literal
+ * Also forwarded to Tracy when building with profiling
+ */
+#if ZE_FEATURE(CPU_PROFILER)
+#define ZE_PROFILE_SCOPE(Name) \
+	static constexpr ze::profiler::ZoneDesc ZE_PROFILER_PRIVATE_CONCAT(ze_profiler_zone_desc_, __LINE__) { Name, __FILE__, __LINE__ }; \
+	ze::profiler::ScopedZone ZE_PROFILER_PRIVATE_CONCAT(ze_profiler_zone_, __LINE__)(&ZE_PROFILER_PRIVATE_CONCAT(ze_profiler_zone_desc_, __LINE__)); \
+	ZE_PROFILER_PRIVATE_TRACY_ZONE(Name)
+#define ZE_PROFILE_FRAME() \
+	ze::profiler::mark_frame(); \
+	ZE_PROFILER_PRIVATE_TRACY_FRAME()
+#else
+#define ZE_PROFILE_SCOPE(Name) ZE_PROFILER_PRIVATE_TRACY_ZONE(Name)
+#define ZE_PROFILE_FRAME() ZE_PROFILER_PRIVATE_TRACY_FRAME()
+#endif
+
+#define ZE_PROFILE_FUNCTION() ZE_PROFILE_SCOPE(__FUNCTION__)
@@ -1,95 +1,392 @@
 #pragma once
 
 #include "engine/core.hpp"
-#include <vector>
+#include "engine/util/thread_index.hpp"
+#include "engine/memory/tracking.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <vector>
 
 namespace ze
 {
 
+namespace detail
+{
+
+/** Threads whose index is past this count (or exiting) bypass the per-thread magazines */
+static constexpr uint32_t max_pool_magazines = 64;
+
+/** Header written in free slots */
+struct PoolFreeSlot
+{
+	PoolFreeSlot* next;
+
+	/** Only meaningful for the first slot of a batch in the depot */
+	PoolFreeSlot* next_batch;
+	size_t batch_size;
+};
+
+/**
+ * Slot size of a T: sizes are rounded to a multiple of 16 so pools of similarly sized types share an implementation
+ */
+template<typename T>
+constexpr size_t get_pool_size_class()
+{
+	const size_t alignment = std::max<size_t>(16, alignof(T));
+	return (std::max(sizeof(T), sizeof(PoolFreeSlot)) + alignment - 1) & ~(alignment - 1);
+}
+
 /**
- * Simple object pool implementation
+ * Untyped pool of fixed-size slots
+ *
+ * Chunks are cache-line aligned and grow geometrically. A thread frees slots into its own magazine (a free list) and
+ * allocates from it without any atomic operation. A magazine holding 2 * magazine_size slots pushes half of them as a
+ * single batch to a lock-free depot, and an empty magazine takes a whole batch back, so the depot is touched at most
+ * once every magazine_size operations and slots freely migrate between threads.
+ * New slots are carved out of chunks under a lock, which only happens while the pool grows.
  */
-template<typename T, int ChunkSize, bool ThreadSafe>
-class SimplePool
+template<size_t SlotSize, size_t SlotAlignment, size_t ChunkSize, bool ThreadSafe>
+class FixedSizePool
 {
-	struct ChunkDeleter
+	static constexpr size_t magazine_size = 32;
+	static constexpr size_t max_chunk_slot_count = ChunkSize * 64;
+	static constexpr size_t chunk_alignment = std::max(std::hardware_destructive_interference_size, SlotAlignment);
+	static constexpr size_t magazine_count = ThreadSafe ? max_pool_magazines : 1;
+
+	/** Depot head packs a tag in the high 16 bits of the pointer to avoid ABA, user-space pointers fit in 48 bits */
+	static constexpr uint64_t depot_pointer_mask = (uint64_t(1) << 48) - 1;
+
+	static_assert(SlotSize >= sizeof(PoolFreeSlot) && SlotSize % SlotAlignment == 0);
+	static_assert(sizeof(void*) == sizeof(uint64_t), "Depot tagged pointers require 64-bit pointers");
+
+#if ZE_BUILD(IS_DEBUG)
+	static constexpr uint8_t poison_byte = 0xDD;
+#endif
+
+	struct alignas(std::hardware_destructive_interference_size) Magazine
 	{
-		void operator()(T* in_ptr)
-		{
-			::free(in_ptr);
-		}
+		PoolFreeSlot* head = nullptr;
+		size_t count = 0;
+
+		/** Single writer counters, summed by get_size */
+		std::atomic_size_t allocations = 0;
+		std::atomic_size_t frees = 0;
 	};
-	
-	using ChunkType = std::unique_ptr<T[], ChunkDeleter>;
 
 public:
-	SimplePool() : size(0) {}
-	~SimplePool() = default;
-	
-	template<typename... Args>
-	T* allocate(Args&&... in_args)
+	explicit FixedSizePool(const MemoryTag in_tag = MemoryTag::Untagged) : depot(0), next_chunk_slot_count(ChunkSize),
+		bump_ptr(nullptr), bump_end(nullptr), uncached_allocations(0), uncached_frees(0),
+		magazines(std::make_unique<Magazine[]>(magazine_count)), tag(in_tag) {}
+
+	~FixedSizePool()
+	{
+		for (const Chunk& chunk : chunks)
+			memory::deallocate(chunk.memory, chunk.size, chunk_alignment, tag);
+	}
+
+	FixedSizePool(const FixedSizePool&) = delete;
+	FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+	/**
+	 * Get a slot of SlotSize bytes aligned on SlotAlignment, nullptr if out of memory
+	 */
+	void* allocate()
 	{
-		if constexpr(ThreadSafe)
-			std::scoped_lock<std::mutex> guard(mutex);
-		
-		if(free_memory.empty())
+		PoolFreeSlot* slot = nullptr;
+		if (Magazine* magazine = get_magazine())
 		{
-			const size_t obj_count = chunks.size() + ChunkSize;
+			if (!magazine->head && !refill(*magazine))
+				return nullptr;
 
-			/** TODO: Aligned malloc? */
-			ChunkType head(static_cast<T*>(malloc(obj_count * sizeof(T))));
-			if(!head)
+			slot = magazine->head;
+			magazine->head = slot->next;
+			magazine->count--;
+			increment(magazine->allocations);
+		}
+		else
+		{
+			slot = allocate_uncached();
+			if (!slot)
 				return nullptr;
+		}
+
+		check_poison(slot);
+		return slot;
+	}
+
+	void free(void* in_ptr)
+	{
+		PoolFreeSlot* slot = static_cast<PoolFreeSlot*>(in_ptr);
+		poison(slot);
+
+		if (Magazine* magazine = get_magazine())
+		{
+			slot->next = magazine->head;
+			magazine->head = slot;
+			magazine->count++;
+			increment(magazine->frees);
 
-			free_memory.reserve(obj_count);
-			for(size_t i = 0; i < obj_count; ++i)
-				free_memory.emplace_back(&head[i]);
+			if constexpr (ThreadSafe)
+			{
+				if (magazine->count >= magazine_size * 2)
+					flush(*magazine);
+			}
+		}
+		else
+		{
+			slot->next = nullptr;
+			push_batch(slot, 1);
+			uncached_frees.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
 
-			chunks.emplace_back(std::move(head));
+	/**
+	 * Number of allocated slots, may be briefly out of date while other threads allocate
+	 */
+	[[nodiscard]] size_t get_size() const
+	{
+		size_t allocations = uncached_allocations.load(std::memory_order_relaxed);
+		size_t frees = uncached_frees.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < magazine_count; ++i)
+		{
+			allocations += magazines[i].allocations.load(std::memory_order_relaxed);
+			frees += magazines[i].frees.load(std::memory_order_relaxed);
 		}
 
-		T* ptr = free_memory.back();
-		free_memory.pop_back();
+		return allocations - frees;
+	}
+private:
+	Magazine* get_magazine() const
+	{
+		if constexpr (ThreadSafe)
+		{
+			const uint32_t index = get_thread_index();
+			return index < magazine_count ? &magazines[index] : nullptr;
+		}
+		else
+		{
+			return &magazines[0];
+		}
+	}
 
-		new (ptr) T(std::forward<Args>(in_args)...);
-		size++;
-		return ptr;
+	static void increment(std::atomic_size_t& in_counter)
+	{
+		in_counter.store(in_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 	}
 
-	void free(T* in_ptr)
+	bool refill(Magazine& in_magazine)
 	{
-		size--;
-		in_ptr->~T();
+		if constexpr (ThreadSafe)
+		{
+			if (PoolFreeSlot* batch = pop_batch())
+			{
+				in_magazine.head = batch;
+				in_magazine.count = batch->batch_size;
+				return true;
+			}
+		}
 
-		if constexpr(ThreadSafe)
-			std::scoped_lock<std::mutex> guard(mutex);
-		
-		free_memory.emplace_back(in_ptr);
+		in_magazine.count = carve(magazine_size, in_magazine.head);
+		return in_magazine.count != 0;
 	}
 
-	SimplePool(const SimplePool& in_other)
+	/** Give magazine_size slots of the magazine to the depot */
+	void flush(Magazine& in_magazine)
 	{
-		(void)(in_other);
-		// TODO: implement lol
+		PoolFreeSlot* batch = in_magazine.head;
+		PoolFreeSlot* last = batch;
+		for (size_t i = 1; i < magazine_size; ++i)
+			last = last->next;
+
+		in_magazine.head = last->next;
+		in_magazine.count -= magazine_size;
+		last->next = nullptr;
+		push_batch(batch, magazine_size);
 	}
 
-    size_t get_size() const { return size; }
+	/** Threads without a magazine take a batch, keep its first slot and give the rest back */
+	PoolFreeSlot* allocate_uncached()
+	{
+		PoolFreeSlot* slot = pop_batch();
+		if (slot)
+		{
+			if (slot->batch_size > 1)
+				push_batch(slot->next, slot->batch_size - 1);
+		}
+		else if (carve(1, slot) == 0)
+		{
+			return nullptr;
+		}
+
+		uncached_allocations.fetch_add(1, std::memory_order_relaxed);
+		return slot;
+	}
+
+	void push_batch(PoolFreeSlot* in_batch, const size_t in_size)
+	{
+		in_batch->batch_size = in_size;
+
+		uint64_t head = depot.load(std::memory_order_relaxed);
+		uint64_t new_head = 0;
+		do
+		{
+			in_batch->next_batch = reinterpret_cast<PoolFreeSlot*>(head & depot_pointer_mask);
+			new_head = ((head & ~depot_pointer_mask) + (uint64_t(1) << 48)) | reinterpret_cast<uint64_t>(in_batch);
+		} while (!depot.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	PoolFreeSlot* pop_batch()
+	{
+		uint64_t head = depot.load(std::memory_order_acquire);
+		while (PoolFreeSlot* batch = reinterpret_cast<PoolFreeSlot*>(head & depot_pointer_mask))
+		{
+			/** batch may have been popped and reused meanwhile, the tag then makes the CAS fail */
+			const uint64_t new_head = ((head & ~depot_pointer_mask) + (uint64_t(1) << 48)) |
+				reinterpret_cast<uint64_t>(batch->next_batch);
+			if (depot.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+				return batch;
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Carve up to in_count never used slots, linked in out_head
+	 * \return Number of slots carved, less than in_count only when out of memory
+	 */
+	size_t carve(const size_t in_count, PoolFreeSlot*& out_head)
+	{
+		[[maybe_unused]] auto guard = lock_carving();
+
+		size_t count = 0;
+		out_head = nullptr;
+		while (count < in_count)
+		{
+			if (bump_ptr == bump_end && !allocate_chunk())
+				break;
+
+			PoolFreeSlot* slot = reinterpret_cast<PoolFreeSlot*>(bump_ptr);
+			bump_ptr += SlotSize;
+			poison(slot);
+			slot->next = out_head;
+			out_head = slot;
+			count++;
+		}
+
+		return count;
+	}
+
+	bool allocate_chunk()
+	{
+		const size_t slot_count = next_chunk_slot_count;
+		uint8_t* chunk = static_cast<uint8_t*>(memory::allocate(slot_count * SlotSize, chunk_alignment, tag));
+		if (!chunk)
+			return false;
+
+		chunks.push_back({ chunk, slot_count * SlotSize });
+		bump_ptr = chunk;
+		bump_end = chunk + slot_count * SlotSize;
+		next_chunk_slot_count = std::min(slot_count * 2, max_chunk_slot_count);
+		return true;
+	}
+
+	auto lock_carving()
+	{
+		if constexpr (ThreadSafe)
+			return std::unique_lock<std::mutex>(carve_mutex);
+		else
+			return 0;
+	}
+
+	/** Fill freed slots past their header so writes after free can be detected */
+	static void poison(PoolFreeSlot* in_slot)
+	{
+#if ZE_BUILD(IS_DEBUG)
+		std::memset(reinterpret_cast<uint8_t*>(in_slot) + sizeof(PoolFreeSlot), poison_byte, SlotSize - sizeof(PoolFreeSlot));
+#else
+		UnusedParameters{ in_slot };
+#endif
+	}
+
+	static void check_poison(PoolFreeSlot* in_slot)
+	{
+#if ZE_BUILD(IS_DEBUG)
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in_slot);
+		for (size_t i = sizeof(PoolFreeSlot); i < SlotSize; ++i)
+		{
+			ZE_CHECKF(bytes[i] == poison_byte, "Pool slot {} was written to after being freed (byte {})",
+				static_cast<const void*>(in_slot), i);
+		}
+#else
+		UnusedParameters{ in_slot };
+#endif
+	}
 private:
-	std::vector<ChunkType> chunks;
-	std::vector<T*> free_memory;
+	struct Chunk
+	{
+		void* memory;
+		size_t size;
+	};
+
+	std::atomic_uint64_t depot;
+
+	std::vector<Chunk> chunks;
+	size_t next_chunk_slot_count;
+	uint8_t* bump_ptr;
+	uint8_t* bump_end;
 
-	size_t size;
+	std::atomic_size_t uncached_allocations;
+	std::atomic_size_t uncached_frees;
+	std::unique_ptr<Magazine[]> magazines;
+	MemoryTag tag;
 
 	struct NoMutex {};
-    ZE_NO_UNIQUE_ADDRESS std::conditional_t<ThreadSafe, std::mutex, NoMutex> mutex;
+	ZE_NO_UNIQUE_ADDRESS std::conditional_t<ThreadSafe, std::mutex, NoMutex> carve_mutex;
+};
+
+}
+
+/**
+ * Object pool, see detail::FixedSizePool
+ * The thread-safe variant is lock-free except when it has to grow
+ * Objects still allocated when the pool is destroyed are not destructed
+ */
+template<typename T, int ChunkSize, bool ThreadSafe>
+class SimplePool
+{
+public:
+	/** in_tag is the memory tag the chunks are accounted to */
+	explicit SimplePool(const MemoryTag in_tag = MemoryTag::Untagged) : storage(in_tag) {}
+
+	template<typename... Args>
+	T* allocate(Args&&... in_args)
+	{
+		void* memory = storage.allocate();
+		return memory ? new (memory) T(std::forward<Args>(in_args)...) : nullptr;
+	}
+
+	void free(T* in_ptr)
+	{
+		in_ptr->~T();
+		storage.free(in_ptr);
+	}
+
+	[[nodiscard]] size_t get_size() const { return storage.get_size(); }
+private:
+	detail::FixedSizePool<detail::get_pool_size_class<T>(),
+		std::max(alignof(T), alignof(detail::PoolFreeSlot)),
+		ChunkSize,
+		ThreadSafe> storage;
 };
 
 template<typename T, int ChunkSize = 64>
 using UnsafeSimplePool = SimplePool<T, ChunkSize, false>;
-	
+
 template<typename T, int ChunkSize = 64>
 using ThreadSafeSimplePool = SimplePool<T, ChunkSize, true>;
-	
-}
\ No newline at end of file
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ze
+{
+
+static constexpr uint32_t invalid_thread_index = ~0U;
+
+/**
+ * Small index of the calling thread, used to give threads their own slot in per-thread caches
+ * Indices of exited threads are reused so they stay close to the number of live threads,
+ * returns invalid_thread_index from thread_local destructors running after the thread released its index
+ */
+uint32_t get_thread_index();
+
+}
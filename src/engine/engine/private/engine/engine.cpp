@@ -11,6 +11,11 @@
 #include "engine/module/module_manager.hpp"
 #include "engine/shadersystem/shader_manager.hpp"
 #include "engine/filesystem/filesystem.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/job_graph.hpp"
+#include "engine/memory/tracking.hpp"
+#include "engine/profiling/profiler.hpp"
+#include "engine/profiling/boot_timeline.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #define TINYOBJLOADER_IMPLEMENTATION
@@ -27,33 +32,134 @@
 namespace ze
 {
 
+namespace
+{
+
+/** Shaders the engine can't start without, compiled while the device is created */
+constexpr std::array required_shaders = { "ScatterUpload", "SPDMipmapsGen", "ImGui" };
+
+/**
+ * Allocations of every tag so far, the calling thread publishes its batched counters first
+ * Other threads publish theirs every few KBs, so a frame may include some of their earlier allocations
+ */
+uint64_t get_allocation_count()
+{
+	memory::flush_thread_stats();
+
+	uint64_t count = 0;
+	for (size_t i = 0; i < memory::tag_count; ++i)
+		count += memory::get_stats(static_cast<MemoryTag>(i)).allocation_count;
+	return count;
+}
+
+}
+
+/**
+ * Startup runs as a job graph, the main thread creates the window meanwhile:
+ * - Create backend -> Create device -> Initialize gfx utils
+ * - Scan shaders + Create backend (shader format) -> Compile required shaders (shaders are created once the device is)
+ * - Build font atlas
+ */
 Engine::Engine() : running(true)
 {
+	ZE_BOOT_PHASE("Engine initialization");
+
+	shader_manager = std::make_unique<shadersystem::ShaderManager>();
+	ImGui::SetCurrentContext(ImGui::CreateContext());
+
+	jobsystem::JobGraph boot_graph;
+
+	const auto create_backend = boot_graph.add([this]()
+	{
+		ZE_BOOT_PHASE("Create backend");
 #if ZE_BUILD(IS_DEBUG)
-	auto result = get_module<gfx::VulkanBackendModule>("vulkangfx")
-		->create_vulkan_backend(gfx::BackendFlags(gfx::BackendFlagBits::DebugLayers));
+		auto result = get_module<gfx::VulkanBackendModule>("vulkangfx")
+			->create_vulkan_backend(gfx::BackendFlags(gfx::BackendFlagBits::DebugLayers));
 #else
-	auto result = get_module<gfx::VulkanBackendModule>("vulkangfx")->create_vulkan_backend(gfx::BackendFlags());
+		auto result = get_module<gfx::VulkanBackendModule>("vulkangfx")->create_vulkan_backend(gfx::BackendFlags());
 #endif
-	if (!result)
-		logger::fatal("Failed to create backend: {}", result.get_error());
+		if (!result)
+			logger::fatal("Failed to create backend: {}", result.get_error());
+
+		backend = std::move(result.get_value());
+		shader_manager->set_shader_format(gfx::ShaderFormat(gfx::ShaderModel::SM6_0, backend->get_shader_language()));
+	});
+
+	const auto create_device = boot_graph.add([this]()
+	{
+		ZE_BOOT_PHASE("Create device");
+		auto backend_device = backend->create_device(gfx::ShaderModel::SM6_0);
+		if (!backend_device)
+			logger::fatal("Failed to create device: {}", backend_device.get_error());
+
+		device = std::make_unique<gfx::Device>(*backend, std::move(backend_device.get_value()));
+		image_available_semaphore = gfx::UniqueSemaphore(device->create_semaphore({}).get_value());
+		render_finished_semaphore = gfx::UniqueSemaphore(device->create_semaphore({}).get_value());
+		shader_manager->set_device(*device);
+	});
+	boot_graph.add_dependency(create_device, create_backend);
+
+	const auto scan_shaders = boot_graph.add([this]()
+	{
+		ZE_BOOT_PHASE("Scan shaders");
+		shader_manager->add_shader_directory("assets/shaders");
+	});
+
+	const auto compile_shaders = boot_graph.add([this]()
+	{
+		ZE_BOOT_PHASE("Compile required shaders");
+		std::vector<shadersystem::ShaderPermutation*> permutations;
+		for (const char* name : required_shaders)
+		{
+			if (shadersystem::Shader* shader = shader_manager->get_shader(name))
+			{
+				permutations.emplace_back(shader->get_permutation({}));
+				permutations.back()->compile();
+			}
+		}
 
-	backend = std::move(result.get_value());
+		/** Stages compile in parallel, the worker executes other boot jobs while waiting */
+		for (shadersystem::ShaderPermutation* permutation : permutations)
+			permutation->wait_for_compilation();
+	});
+	boot_graph.add_dependency(compile_shaders, scan_shaders);
+	boot_graph.add_dependency(compile_shaders, create_backend);
 
-	auto backend_device = backend->create_device(gfx::ShaderModel::SM6_0);
-	if (!backend_device)
-		logger::fatal("Failed to create device: {}", backend_device.get_error());
+	/** The module creates its resources when loaded */
+	const auto initialize_gfx_utils = boot_graph.add([this]()
+	{
+		ZE_BOOT_PHASE("Initialize gfx utils");
+		get_module<gfx::GfxUtilsModule>("gfxutils")->initialize_shaders(*shader_manager);
+	});
+	boot_graph.add_dependency(initialize_gfx_utils, create_device);
+	boot_graph.add_dependency(initialize_gfx_utils, compile_shaders);
+
+	boot_graph.add([]()
+	{
+		ZE_BOOT_PHASE("Build font atlas");
+		imgui::build_font_atlas();
+	});
 
-	device = std::make_unique<gfx::Device>(*result.get_value().get(), std::move(backend_device.get_value()));
-	shader_manager = std::make_unique<shadersystem::ShaderManager>(*device);
-	shader_manager->add_shader_directory("assets/shaders");
-	shader_manager->set_shader_format(gfx::ShaderFormat(gfx::ShaderModel::SM6_0, backend->get_shader_language()));
+	boot_graph.submit();
 
-	auto gfx_utils_module = get_module<gfx::GfxUtilsModule>("gfxutils");
-	gfx_utils_module->initialize_shaders(*shader_manager);
+	/** Windows belong to the thread pumping their messages */
+	{
+		ZE_BOOT_PHASE("Create window");
+		const auto platform = get_module<platform::ApplicationModule>("Application");
+		platform->get_application().set_message_handler(this);
+		main_window = platform->get_application().create_window(
+			"ZinoEngine",
+			1280,
+			720,
+			0,
+			0,
+			platform::WindowFlags(platform::WindowFlagBits::Centered | platform::WindowFlagBits::Maximized | platform::WindowFlagBits::Resizable));
+	}
 
-	image_available_semaphore = gfx::UniqueSemaphore(device->create_semaphore({}).get_value());
-	render_finished_semaphore = gfx::UniqueSemaphore(device->create_semaphore({}).get_value());
+	{
+		ZE_BOOT_PHASE("Wait for boot jobs");
+		boot_graph.wait();
+	}
 }
 
 Engine::~Engine()
@@ -64,17 +170,11 @@ Engine::~Engine()
 void Engine::run()
 {
 	const auto platform = get_module<platform::ApplicationModule>("Application");
-	platform->get_application().set_message_handler(this);
-	main_window = platform->get_application().create_window(
-		"ZinoEngine",
-		1280,
-		720,
-		0,
-		0,
-		platform::WindowFlags(platform::WindowFlagBits::Centered | platform::WindowFlagBits::Maximized | platform::WindowFlagBits::Resizable));
 
-	ImGui::SetCurrentContext(ImGui::CreateContext());
-	imgui::initialize(*shader_manager);
+	{
+		ZE_BOOT_PHASE("Initialize imgui");
+		imgui::initialize(*shader_manager);
+	}
 
 	/** Default ZE editor style */
 	{
@@ -149,13 +249,20 @@ void Engine::run()
 		colors[ImGuiCol_ModalWindowDimBg] = ImVec4(0.80f, 0.80f, 0.80f, 0.35f);
 	}
 
-	create_swapchain(gfx::UniqueSwapchain());
-
-	imgui::initialize_main_viewport(*main_window, swapchain.get());
+	{
+		ZE_BOOT_PHASE("Create swapchain");
+		create_swapchain(gfx::UniqueSwapchain());
+		imgui::initialize_main_viewport(*main_window, swapchain.get());
+	}
 	
 	std::array<gfx::rendergraph::PhysicalResourceRegistry, gfx::Device::max_frames_in_flight> registry;
 
 	auto previous = std::chrono::high_resolution_clock::now();
+	const uint64_t first_frame_start_ns = profiler::get_time_ns();
+
+	/** Global new is only counted when built with ZE_WITH_MEMORY_TRACKING, otherwise only tagged allocators are */
+	uint64_t previous_allocation_count = get_allocation_count();
+	uint64_t frame_allocation_count = 0;
 
 	while(running)
 	{
@@ -175,6 +282,7 @@ void Engine::run()
 		ImGui::NewFrame();
 		ImGui::Text("%.0f FPS", 1.f / ImGui::GetIO().DeltaTime, ImGui::GetIO().DeltaTime);
 		ImGui::Text("%.2f ms", ImGui::GetIO().DeltaTime * 1000);
+		ImGui::Text("%llu allocations", static_cast<unsigned long long>(frame_allocation_count));
 		ImGui::ShowDemoWindow();
 		ImGui::Render();
 
@@ -189,24 +297,24 @@ void Engine::run()
 		imgui::draw_viewport(ImGui::GetMainViewport(), render_graph, false);
 		imgui::draw_viewports(render_graph);
 
-		render_graph.set_backbuffer_attachment("backbuffer", 
+		render_graph.set_backbuffer_attachment(ZE_NAME("backbuffer"), 
 			get_device()->get_swapchain_backbuffer_view(swapchain.get()),
 			main_window->get_width(),
 			main_window->get_height());
 
 		{
-			ZoneScopedN("Render graph compilation");
+			ZE_PROFILE_SCOPE("Render graph compilation");
 			render_graph.compile();
 		}
 
 		const auto list = device->allocate_cmd_list(gfx::QueueType::Gfx);
 		{
-			ZoneScopedN("Execute render graph");
+			ZE_PROFILE_SCOPE("Execute render graph");
 			render_graph.execute(list);
 		}
 		
 		{
-			ZoneScopedN("Submit");
+			ZE_PROFILE_SCOPE("Submit");
 
 			std::array submit_wait_semaphores = { image_available_semaphore.get() };
 			std::array submit_signal_semaphores = { render_finished_semaphore.get() };
@@ -221,9 +329,24 @@ void Engine::run()
 		std::array present_wait_semaphores = { render_finished_semaphore.get() };
 		device->present(swapchain.get(), present_wait_semaphores);
 
+		if (!boot::get_time_to_first_frame_ns()) [[unlikely]]
+		{
+			boot::add_phase("First frame", first_frame_start_ns, profiler::get_time_ns());
+			boot::mark_first_frame();
+		}
+
+		const uint64_t allocation_count = get_allocation_count();
+		frame_allocation_count = allocation_count - previous_allocation_count;
+		previous_allocation_count = allocation_count;
+
 #if ZE_FEATURE(PROFILING)
-		FrameMark;
+		jobsystem::plot_stats();
+		TracyPlot("Allocations per frame", static_cast<int64_t>(frame_allocation_count));
 #endif
+		ZE_PROFILE_FRAME();
+
+		if (auto capture = profiler::take_frame_capture())
+			save_profiler_capture(*capture);
 
 		/** FPS Limiter */
 		if(1) {
@@ -254,6 +377,27 @@ void Engine::create_swapchain(const gfx::UniqueSwapchain& old_swapchain)
 		imgui::update_main_viewport(*main_window, swapchain.get());
 }
 
+/** Captures requested with --profile-frames, written next to the executable */
+void Engine::save_profiler_capture(const profiler::Capture& in_capture)
+{
+	if (!profiler::write_binary_capture(in_capture, "profile.zeprof") ||
+		!profiler::write_chrome_trace(in_capture, "profile.json"))
+	{
+		logger::error("Failed to write the profiler capture");
+		return;
+	}
+
+	logger::info("Profiler capture of {} frames written to profile.zeprof and profile.json ({} zones dropped)",
+		in_capture.frame_start_ns.size(), in_capture.dropped_events);
+
+	const auto stats = profiler::compute_zone_stats(in_capture);
+	for (size_t i = 0; i < std::min<size_t>(stats.size(), 10); ++i)
+	{
+		logger::info("{}: {} calls, mean {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms",
+			stats[i].name, stats[i].count, stats[i].mean_ms, stats[i].p50_ms, stats[i].p99_ms);
+	}
+}
+
 void Engine::on_resized_window(platform::Window& in_window, uint32_t in_width, uint32_t in_height)
 {
 	if(&in_window == main_window.get())
@@ -0,0 +1,65 @@
+#include "engine/module_loading.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/job_graph.hpp"
+#include "engine/profiling/profiler.hpp"
+#include <atomic>
+#include <memory>
+
+namespace ze
+{
+
+bool load_modules_parallel(const std::span<const ModuleDesc>& in_modules)
+{
+	ZE_PROFILE_FUNCTION();
+
+	auto dependencies = resolve_module_dependencies(in_modules);
+	if (!dependencies)
+	{
+		UnusedParameters{ dependencies.get_error() };
+		return false;
+	}
+
+	const std::unique_ptr<std::atomic_bool[]> failed = std::make_unique<std::atomic_bool[]>(in_modules.size());
+	jobsystem::JobGraph graph;
+	for (size_t i = 0; i < in_modules.size(); ++i)
+	{
+		graph.add([&, i]()
+		{
+			for (const size_t dependency : dependencies.get_value()[i])
+			{
+				if (failed[dependency].load(std::memory_order_relaxed))
+				{
+					logger::error("Skipped module {}: dependency {} failed to load", in_modules[i].name,
+						in_modules[dependency].name);
+					failed[i].store(true, std::memory_order_relaxed);
+					return;
+				}
+			}
+
+			if (auto result = load_module(in_modules[i].name); !result)
+			{
+				logger::error("Failed to load module {}", in_modules[i].name);
+				UnusedParameters{ result.get_error() };
+				failed[i].store(true, std::memory_order_relaxed);
+			}
+		});
+	}
+
+	for (size_t i = 0; i < in_modules.size(); ++i)
+		for (const size_t dependency : dependencies.get_value()[i])
+			graph.add_dependency(static_cast<jobsystem::JobGraph::NodeIndex>(i),
+				static_cast<jobsystem::JobGraph::NodeIndex>(dependency));
+
+	/** Modules loading a module another worker is loading (e.g from their constructor) execute jobs meanwhile */
+	const ModuleLoadWaitFunc previous_wait_func = set_module_load_wait_func(&jobsystem::try_execute_one_job);
+	graph.submit_and_wait();
+	set_module_load_wait_func(previous_wait_func);
+
+	for (size_t i = 0; i < in_modules.size(); ++i)
+		if (failed[i].load(std::memory_order_relaxed))
+			return false;
+
+	return true;
+}
+
+}
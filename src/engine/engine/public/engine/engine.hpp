@@ -10,6 +10,7 @@ namespace ze
 
 namespace gfx { class Device; }
 namespace shadersystem { class ShaderManager;  }
+namespace profiler { struct Capture; }
 
 class Engine : public platform::ApplicationMessageHandler
 {
@@ -20,6 +21,7 @@ public:
 	void run();
 private:
 	void create_swapchain(const gfx::UniqueSwapchain& old_swapchain);
+	void save_profiler_capture(const profiler::Capture& in_capture);
 	void on_resized_window(platform::Window& in_window, uint32_t in_width, uint32_t in_height) override;
 	void on_closing_window(platform::Window& in_window) override;
 	void on_mouse_down(platform::Window& in_window, platform::MouseButton in_button, const glm::ivec2& in_mouse_pos) override;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "engine/module/module_manager.hpp"
+#include <span>
+
+namespace ze
+{
+
+/**
+ * Load in_modules on the job system, each module once the modules it depends on are loaded
+ * Independent modules load and construct in parallel, the calling thread executes jobs while waiting
+ * Modules depending on a module that failed to load are skipped
+ * \return False if the dependencies are invalid or a module failed to load
+ */
+bool load_modules_parallel(const std::span<const ModuleDesc>& in_modules);
+
+}
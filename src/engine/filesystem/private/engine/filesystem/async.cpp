@@ -0,0 +1,30 @@
+#include "engine/filesystem/async.hpp"
+
+namespace ze::filesystem
+{
+
+jobsystem::Task<Result<std::vector<uint8_t>, FileSystemError>> read_file_async(FileSystem& in_filesystem,
+	std::filesystem::path in_path,
+	FileReadFlags in_flags)
+{
+	co_await jobsystem::schedule_on_lane(jobsystem::JobLane::IO);
+
+	auto file = in_filesystem.read(in_path, in_flags);
+	if (!file)
+		co_return make_error(file.get_error());
+
+	std::streambuf& buffer = *file.get_value();
+	std::vector<uint8_t> data;
+
+	const std::streamoff size = buffer.pubseekoff(0, std::ios::end, std::ios::in);
+	if (size > 0)
+	{
+		data.resize(static_cast<size_t>(size));
+		buffer.pubseekpos(0, std::ios::in);
+		data.resize(static_cast<size_t>(buffer.sgetn(reinterpret_cast<char*>(data.data()), size)));
+	}
+
+	co_return make_result(std::move(data));
+}
+
+}
@@ -1,4 +1,5 @@
 #include "engine/filesystem/filesystem.hpp"
+#include "engine/memory/tracking.hpp"
 
 namespace ze::filesystem
 {
@@ -8,6 +9,7 @@ FileSystem::FileSystem()
 
 Result<std::unique_ptr<std::streambuf>, FileSystemError> FileSystem::read(const std::filesystem::path& in_path, FileReadFlags in_flags)
 {
+	memory::ScopedTag tag(MemoryTag::Filesystem);
 	if(MountPoint* mount_point = get_matching_mount_point_from_path(in_path))
 		return mount_point->read(in_path, in_flags);
 
@@ -16,6 +18,7 @@ Result<std::unique_ptr<std::streambuf>, FileSystemError> FileSystem::read(const
 
 Result<std::unique_ptr<std::streambuf>, FileSystemError> FileSystem::write(const std::filesystem::path& in_path, FileWriteFlags in_flags)
 {
+	memory::ScopedTag tag(MemoryTag::Filesystem);
 	if (write_mount_point)
 		return write_mount_point->write(in_path, in_flags);
 
@@ -26,6 +29,7 @@ bool FileSystem::iterate_directory(const std::filesystem::path& in_path,
 	std::function<void(const std::filesystem::path&)> in_function,
 	IterateDirectoryFlags in_flags)
 {
+	memory::ScopedTag tag(MemoryTag::Filesystem);
 	if (MountPoint* mount_point = get_matching_mount_point_from_path(in_path))
 		return mount_point->iterate_directory(in_path, in_function, in_flags);
 
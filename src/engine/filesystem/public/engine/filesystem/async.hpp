@@ -0,0 +1,16 @@
+#pragma once
+
+#include "engine/filesystem/filesystem.hpp"
+#include "engine/jobsystem/task.hpp"
+
+namespace ze::filesystem
+{
+
+/**
+ * Read a whole file on the IO lane, the awaiting coroutine is resumed on an IO thread
+ */
+[[nodiscard]] jobsystem::Task<Result<std::vector<uint8_t>, FileSystemError>> read_file_async(FileSystem& in_filesystem,
+	std::filesystem::path in_path,
+	FileReadFlags in_flags = FileReadFlagBits::Binary);
+
+}
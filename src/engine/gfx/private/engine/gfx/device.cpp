@@ -1,6 +1,8 @@
 #include "engine/gfx/device.hpp"
 #include "engine/gfx/backend_device.hpp"
 #include "engine/gfx/compute_pipeline.hpp"
+#include "engine/memory/frame_arena.hpp"
+#include "engine/memory/tracking.hpp"
 
 namespace ze::gfx
 {
@@ -38,7 +40,7 @@ Swapchain::Swapchain(Device& in_device,
 	auto format = device.get_backend_device()->get_swapchain_format(in_swapchain);
 	for(const auto& texture : bck_textures)
 	{
-		textures.emplace_back(Device::cast_resource_ptr<TextureHandle>(in_device.textures.allocate(device,
+		textures.emplace_back(Device::to_resource_handle<TextureHandle>(in_device.textures.emplace(device,
 			TextureCreateInfo(
 				TextureType::Tex2D,
 				MemoryUsage::GpuToCpu,
@@ -59,7 +61,7 @@ Swapchain::Swapchain(Device& in_device,
 	size_t i = 0;
 	for(const auto& view : bck_views)
 	{
-		views.emplace_back(Device::cast_resource_ptr<TextureViewHandle>(in_device.texture_views.allocate(device,
+		views.emplace_back(Device::to_resource_handle<TextureViewHandle>(in_device.texture_views.emplace(device,
 			*Device::cast_handle<Texture>(textures[i]),
 			TextureViewCreateInfo(
 				bck_textures[i],
@@ -78,10 +80,10 @@ Swapchain::Swapchain(Device& in_device,
 Swapchain::~Swapchain()
 {
 	for(const auto& texture : textures)
-		device.textures.free(Device::cast_handle<Texture>(texture));
+		device.textures.erase(Device::to_slot_handle(texture));
 
 	for(const auto& view : views)
-		device.texture_views.free(Device::cast_handle<TextureView>(view));
+		device.texture_views.erase(Device::to_slot_handle(view));
 	
 	device.get_backend_device()->destroy_swap_chain(resource);
 }
@@ -177,31 +179,31 @@ Device::Frame::Frame() : gfx_command_pool(QueueType::Gfx),
 void Device::Frame::free_resources()
 {
 	for(auto& buffer : expired_buffers)
-		get_device()->buffers.free(cast_handle<Buffer>(buffer));
+		get_device()->buffers.erase(to_slot_handle(buffer));
 
 	for(auto& texture : expired_textures)
-		get_device()->textures.free(cast_handle<Texture>(texture));
+		get_device()->textures.erase(to_slot_handle(texture));
 
 	for(auto& texture_view : expired_texture_views)
-		get_device()->texture_views.free(cast_handle<TextureView>(texture_view));
+		get_device()->texture_views.erase(to_slot_handle(texture_view));
 
 	for(auto& shader : expired_shaders)
-		get_device()->shaders.free(cast_handle<Shader>(shader));
+		get_device()->shaders.erase(to_slot_handle(shader));
 
 	for(auto& pipeline_layout : expired_pipeline_layouts)
-		get_device()->pipeline_layouts.free(cast_handle<PipelineLayout>(pipeline_layout));
+		get_device()->pipeline_layouts.erase(to_slot_handle(pipeline_layout));
 
 	for(auto& swapchain : expired_swapchains)
-		get_device()->swapchains.free(cast_handle<Swapchain>(swapchain));
+		get_device()->swapchains.erase(to_slot_handle(swapchain));
 
 	for(auto& fence : expired_fences)
-		get_device()->fences.free(cast_handle<Fence>(fence));
+		get_device()->fences.erase(to_slot_handle(fence));
 	
 	for(auto& semaphore : expired_semaphores)
-		get_device()->semaphores.free(cast_handle<Semaphore>(semaphore));
+		get_device()->semaphores.erase(to_slot_handle(semaphore));
 
 	for(auto& sampler : expired_samplers)
-		get_device()->samplers.free(cast_handle<Sampler>(sampler));
+		get_device()->samplers.erase(to_slot_handle(sampler));
 }
 
 void Device::wait_idle()
@@ -220,6 +222,9 @@ void Device::new_frame()
 	
 	current_frame = (current_frame + 1) % max_frames_in_flight;
 
+	/** Previous frame CPU work is over, its transient data can go */
+	get_frame_arena().reset();
+
 	/** Wait for fences before doing anything */
 	if (!get_current_frame().wait_fences.empty())
 	{
@@ -284,8 +289,9 @@ void Device::submit_queue(const QueueType& in_type)
 
 	ZE_CHECK(fence && wait_semaphores_handles && signal_semaphores_handles);
 
-	std::vector<BackendDeviceResource> wait_semaphores;
-	std::vector<PipelineStageFlags> wait_pipeline_flags;
+	/** Frames usually wait/signal one or two semaphores and submit a few lists */
+	SmallVector<BackendDeviceResource, 4> wait_semaphores;
+	SmallVector<PipelineStageFlags, 4> wait_pipeline_flags;
 	wait_semaphores.reserve(wait_semaphores_handles->size());
 	wait_pipeline_flags.reserve(wait_semaphores_handles->size());
 	for(const auto& handle : *wait_semaphores_handles)
@@ -296,7 +302,7 @@ void Device::submit_queue(const QueueType& in_type)
 		wait_pipeline_flags.emplace_back(PipelineStageFlags(PipelineStageFlagBits::TopOfPipe));
 	}
 	
-	std::vector<BackendDeviceResource> signal_semaphores;
+	SmallVector<BackendDeviceResource, 4> signal_semaphores;
 	signal_semaphores.reserve(signal_semaphores_handles->size());
 	for(const auto& handle : *signal_semaphores_handles)
 		signal_semaphores.emplace_back(cast_handle<Semaphore>(handle)->get_resource());
@@ -305,7 +311,7 @@ void Device::submit_queue(const QueueType& in_type)
 	
 	if(lists && !lists->empty())
 	{
-		std::vector<BackendDeviceResource> cmds;
+		SmallVector<BackendDeviceResource, 4> cmds;
 		cmds.reserve(lists->size());
 		for(const auto& list : *lists)
 			cmds.emplace_back(cast_handle<CommandList>(list)->get_resource());
@@ -329,8 +335,7 @@ Result<BufferHandle, GfxResult> Device::create_buffer(BufferInfo in_create_info)
 	const auto srv_index = backend_device->get_buffer_srv_descriptor_index(result.get_value());
 	const auto uav_index = backend_device->get_buffer_uav_descriptor_index(result.get_value());
 
-	auto buffer = buffers.allocate(*this, result.get_value(), in_create_info.debug_name, srv_index, uav_index);
-	auto handle = cast_resource_ptr<BufferHandle>(buffer);
+	auto handle = to_resource_handle<BufferHandle>(buffers.emplace(*this, result.get_value(), in_create_info.debug_name, srv_index, uav_index));
 	
 	if(!in_create_info.initial_data.empty())
 	{
@@ -376,12 +381,13 @@ Result<TextureHandle, GfxResult> Device::create_texture(TextureInfo in_create_in
 	if(!result)
 		return result.get_error();
 
-	auto texture = textures.allocate(*this, 
+	const auto slot = textures.emplace(*this, 
 		in_create_info.info, 
 		false,
 		result.get_value(), 
 		in_create_info.debug_name);
-	auto handle = cast_resource_ptr<TextureHandle>(texture);
+	auto texture = textures.get(slot);
+	auto handle = to_resource_handle<TextureHandle>(slot);
 
 	if(!in_create_info.initial_mip_data.empty())
 	{
@@ -467,14 +473,14 @@ Result<TextureViewHandle, GfxResult> Device::create_texture_view(TextureViewInfo
 	const auto srv_index = backend_device->get_texture_view_srv_descriptor_index(result.get_value());
 	const auto uav_index = backend_device->get_texture_view_uav_descriptor_index(result.get_value());
 
-	const auto texture_view = texture_views.allocate(*this, 
+	const auto texture_view = texture_views.emplace(*this, 
 		*texture, 
 		create_info,
 		result.get_value(), 
 		in_create_info.debug_name,
 		srv_index,
 		uav_index);
-	return make_result(cast_resource_ptr<TextureViewHandle>(texture_view));
+	return make_result(to_resource_handle<TextureViewHandle>(texture_view));
 }
 
 Result<ShaderHandle, GfxResult> Device::create_shader(const ShaderInfo& in_create_info)
@@ -483,8 +489,8 @@ Result<ShaderHandle, GfxResult> Device::create_shader(const ShaderInfo& in_creat
 	if(!result)
 		return result.get_error();
 
-	auto shader = shaders.allocate(*this, result.get_value(), in_create_info.debug_name);
-	return make_result(cast_resource_ptr<ShaderHandle>(shader));
+	auto shader = shaders.emplace(*this, result.get_value(), in_create_info.debug_name);
+	return make_result(to_resource_handle<ShaderHandle>(shader));
 }
 
 Result<SwapchainHandle, GfxResult> Device::create_swapchain(const SwapChainInfo& in_create_info)
@@ -493,8 +499,8 @@ Result<SwapchainHandle, GfxResult> Device::create_swapchain(const SwapChainInfo&
 	if(!result)
 		return result.get_error();
 
-	auto swapchain = swapchains.allocate(*this, in_create_info.create_info, result.get_value(), in_create_info.debug_name);
-	return make_result(cast_resource_ptr<SwapchainHandle>(swapchain));
+	auto swapchain = swapchains.emplace(*this, in_create_info.create_info, result.get_value(), in_create_info.debug_name);
+	return make_result(to_resource_handle<SwapchainHandle>(swapchain));
 }
 
 Result<FenceHandle, GfxResult> Device::create_fence(const FenceInfo& in_create_info)
@@ -503,8 +509,8 @@ Result<FenceHandle, GfxResult> Device::create_fence(const FenceInfo& in_create_i
 	if(!result)
 		return result.get_error();
 
-	auto fence = fences.allocate(*this, result.get_value(), in_create_info.debug_name);
-	return make_result(cast_resource_ptr<FenceHandle>(fence));
+	auto fence = fences.emplace(*this, result.get_value(), in_create_info.debug_name);
+	return make_result(to_resource_handle<FenceHandle>(fence));
 }
 
 Result<SemaphoreHandle, GfxResult> Device::create_semaphore(const SemaphoreInfo& in_create_info)
@@ -513,8 +519,8 @@ Result<SemaphoreHandle, GfxResult> Device::create_semaphore(const SemaphoreInfo&
 	if(!result)
 		return result.get_error();
 
-	auto semaphore = semaphores.allocate(*this, result.get_value(), in_create_info.debug_name);
-	return make_result(cast_resource_ptr<SemaphoreHandle>(semaphore));
+	auto semaphore = semaphores.emplace(*this, result.get_value(), in_create_info.debug_name);
+	return make_result(to_resource_handle<SemaphoreHandle>(semaphore));
 }
 
 Result<PipelineLayoutHandle, GfxResult> Device::create_pipeline_layout(const PipelineLayoutInfo& in_create_info)
@@ -523,8 +529,8 @@ Result<PipelineLayoutHandle, GfxResult> Device::create_pipeline_layout(const Pip
 	if(!result)
 		return result.get_error();
 
-	auto layout = pipeline_layouts.allocate(*this, result.get_value(), in_create_info.debug_name);
-	return make_result(cast_resource_ptr<PipelineLayoutHandle>(layout));
+	auto layout = pipeline_layouts.emplace(*this, result.get_value(), in_create_info.debug_name);
+	return make_result(to_resource_handle<PipelineLayoutHandle>(layout));
 }
 
 Result<SamplerHandle, GfxResult> Device::create_sampler(const SamplerInfo& in_create_info)
@@ -535,8 +541,8 @@ Result<SamplerHandle, GfxResult> Device::create_sampler(const SamplerInfo& in_cr
 
 	const auto srv_index = backend_device->get_sampler_srv_descriptor_index(result.get_value());
 
-	auto sampler = samplers.allocate(*this, result.get_value(), in_create_info.debug_name, srv_index);
-	return make_result(cast_resource_ptr<SamplerHandle>(sampler));
+	auto sampler = samplers.emplace(*this, result.get_value(), in_create_info.debug_name, srv_index);
+	return make_result(to_resource_handle<SamplerHandle>(sampler));
 }
 
 void Device::destroy_buffer(const BufferHandle& in_buffer)
@@ -627,6 +633,11 @@ void Device::wait_for_fences(const std::span<FenceHandle>& in_fences, const bool
 	backend_device->wait_for_fences(wait_fences, in_wait_for_all, in_timeout);
 }
 
+GfxResult Device::get_fence_status(const FenceHandle& in_fence)
+{
+	return backend_device->get_fence_status(cast_handle<Fence>(in_fence)->get_resource());
+}
+
 void Device::reset_fences(const std::span<FenceHandle>& in_fences)
 {
 	std::vector<BackendDeviceResource> wait_fences;
@@ -681,10 +692,7 @@ void Device::cmd_begin_render_pass(const CommandListHandle& in_cmd_list,
 {
 	ZE_CHECK(in_info.render_area.width > 0 && in_info.render_area.height > 0);
 
-	std::vector<AttachmentDescription> attachment_descriptions;
-	std::vector<BackendDeviceResource> attachments;
-	attachments.reserve(in_info.color_attachments.size() + 1);
-	attachment_descriptions.reserve(in_info.color_attachments.size() + 1);
+	AttachmentVector<AttachmentDescription> attachment_descriptions;
 
 	Framebuffer framebuffer;
 	framebuffer.width = in_info.render_area.width;
@@ -722,14 +730,14 @@ void Device::cmd_begin_render_pass(const CommandListHandle& in_cmd_list,
 		if(view->get_texture().is_texture_from_swapchain())
 			desc.final_layout = TextureLayout::Present;
 
-		attachments.push_back(view->get_resource());
+		framebuffer.attachments.push_back(view->get_resource());
 		attachment_descriptions.push_back(desc);
 	}
 
 	if(in_info.depth_stencil_attachment)
 	{
 		const auto view = cast_handle<TextureView>(in_info.depth_stencil_attachment);
-		attachments.emplace_back(view->get_resource());
+		framebuffer.attachments.emplace_back(view->get_resource());
 		attachment_descriptions.emplace_back(view->get_create_info().format,
 			view->get_texture().get_create_info().sample_count,
 			in_info.depth_attachment_read_only ? AttachmentLoadOp::Load : AttachmentLoadOp::Clear,
@@ -740,14 +748,14 @@ void Device::cmd_begin_render_pass(const CommandListHandle& in_cmd_list,
 			TextureLayout::DepthStencilReadOnly);
 	}
 
-	std::vector<SubpassDescription> subpasses;
+	SmallVector<SubpassDescription, 1> subpasses;
 	subpasses.reserve(in_info.subpasses.size());
 	for(const auto& subpass : in_info.subpasses)
 	{
 		auto process_attachments = [&](const std::span<uint32_t>& in_indices, 
-			const TextureLayout in_layout) -> std::vector<AttachmentReference>
+			const TextureLayout in_layout) -> AttachmentVector<AttachmentReference>
 		{
-			std::vector<AttachmentReference> refs;
+			AttachmentVector<AttachmentReference> refs;
 			refs.reserve(in_indices.size());
 
 			for(const auto& index : in_indices)
@@ -759,13 +767,13 @@ void Device::cmd_begin_render_pass(const CommandListHandle& in_cmd_list,
 			return refs;
 		};
 
-		std::vector<AttachmentReference> input_attachments = process_attachments(subpass.input_attachments, 
+		AttachmentVector<AttachmentReference> input_attachments = process_attachments(subpass.input_attachments, 
 			TextureLayout::ShaderReadOnly);
 
-		std::vector<AttachmentReference> color_attachments = process_attachments(subpass.color_attachments,
+		AttachmentVector<AttachmentReference> color_attachments = process_attachments(subpass.color_attachments,
 			TextureLayout::ColorAttachment);
 
-		std::vector<AttachmentReference> resolve_attachments = process_attachments(subpass.resolve_attachments,
+		AttachmentVector<AttachmentReference> resolve_attachments = process_attachments(subpass.resolve_attachments,
 			TextureLayout::ColorAttachment);
 
 		AttachmentReference depth_stencil_attachment;
@@ -790,8 +798,6 @@ void Device::cmd_begin_render_pass(const CommandListHandle& in_cmd_list,
 
 	list->set_render_pass(render_pass);
 
-	framebuffer.attachments = attachments;
-	
 	backend_device->cmd_begin_render_pass(
 		list->get_resource(),
 		render_pass,
@@ -1042,7 +1048,7 @@ void Device::present(const SwapchainHandle& in_swapchain,
 	const std::span<SemaphoreHandle>& in_wait_semaphores)
 {
 	auto swapchain = cast_handle<Swapchain>(in_swapchain);
-	std::vector<BackendDeviceResource> wait_semaphores;
+	SmallVector<BackendDeviceResource, 4> wait_semaphores;
 	wait_semaphores.reserve(in_wait_semaphores.size());
 
 	for(const auto& semaphore : in_wait_semaphores)
@@ -1063,25 +1069,31 @@ BackendDeviceResource Device::get_swapchain_backend_handle(const SwapchainHandle
 
 BackendDeviceResource Device::get_or_create_render_pass(const RenderPassCreateInfo& in_create_info)
 {
-	auto it = render_passes.find(in_create_info);
+	DescriptionKeyBuilder key_builder;
+	const DescriptionKeyView key = build_description_key(key_builder, in_create_info);
+	auto it = render_passes.find(key);
 	if(it != render_passes.end())
 		return it->second;
 
+	memory::ScopedTag tag(MemoryTag::Gfx);
 	auto rp = backend_device->create_render_pass(in_create_info);
 	ZE_ASSERT(rp.has_value());
-	render_passes.insert({ in_create_info, rp.get_value() });
+	render_passes.emplace(DescriptionKey(key), rp.get_value());
 	return rp.get_value();
 }
 
 BackendDeviceResource Device::get_or_create_gfx_pipeline(const GfxPipelineCreateInfo& in_create_info)
 {
-	auto it = gfx_pipelines.find(in_create_info);
+	DescriptionKeyBuilder key_builder;
+	const DescriptionKeyView key = build_description_key(key_builder, in_create_info);
+	auto it = gfx_pipelines.find(key);
 	if(it != gfx_pipelines.end())
 		return it->second;
 
+	memory::ScopedTag tag(MemoryTag::Gfx);
 	auto pipeline = backend_device->create_gfx_pipeline(in_create_info);
 	ZE_ASSERT(pipeline.has_value());
-	gfx_pipelines.insert({ in_create_info, pipeline.get_value() });
+	gfx_pipelines.emplace(DescriptionKey(key), pipeline.get_value());
 
 	static size_t idx = 0;
 	backend_device->set_resource_name(fmt::format("Gfx Pipeline {}", idx++), DeviceResourceType::Pipeline, pipeline.get_value());
@@ -1090,13 +1102,16 @@ BackendDeviceResource Device::get_or_create_gfx_pipeline(const GfxPipelineCreate
 
 BackendDeviceResource Device::get_or_create_compute_pipeline(const ComputePipelineCreateInfo& in_create_info)
 {
-	auto it = compute_pipelines.find(in_create_info);
+	DescriptionKeyBuilder key_builder;
+	const DescriptionKeyView key = build_description_key(key_builder, in_create_info);
+	auto it = compute_pipelines.find(key);
 	if (it != compute_pipelines.end())
 		return it->second;
 
+	memory::ScopedTag tag(MemoryTag::Gfx);
 	auto pipeline = backend_device->create_compute_pipeline(in_create_info);
 	ZE_ASSERT(pipeline.has_value());
-	compute_pipelines.insert({ in_create_info, pipeline.get_value() });
+	compute_pipelines.emplace(DescriptionKey(key), pipeline.get_value());
 	static size_t idx = 0;
 	backend_device->set_resource_name(fmt::format("Compute Pipeline {}", idx++), DeviceResourceType::Pipeline, pipeline.get_value());
 	return pipeline.get_value();
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "engine/gfx/device.hpp"
+#include "engine/jobsystem/task.hpp"
+
+namespace ze::gfx
+{
+
+/**
+ * co_await to suspend a coroutine until in_fence is signaled, without blocking any thread
+ * The fence status is polled from the job system poll thread
+ */
+inline auto wait_for_fence_async(const FenceHandle& in_fence)
+{
+	return jobsystem::wait_until([in_fence]()
+	{
+		return get_device()->get_fence_status(in_fence) != GfxResult::NotReady;
+	});
+}
+
+}
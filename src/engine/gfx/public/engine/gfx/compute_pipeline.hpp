@@ -21,6 +21,12 @@ struct ComputePipelineCreateInfo
 	}
 };
 
+inline void write_description(DescriptionKeyBuilder& in_builder, const ComputePipelineCreateInfo& in_create_info)
+{
+	write_description(in_builder, in_create_info.shader_stage);
+	in_builder.write(in_create_info.pipeline_layout);
+}
+
 }
 
 namespace std
@@ -30,12 +36,8 @@ template<> struct hash<ze::gfx::ComputePipelineCreateInfo>
 {
 	uint64_t operator()(const ze::gfx::ComputePipelineCreateInfo& in_create_info) const noexcept
 	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_create_info.shader_stage);
-		ze::hash_combine(hash, in_create_info.pipeline_layout);
-			
-		return hash;
+		ze::gfx::DescriptionKeyBuilder builder;
+		return build_description_key(builder, in_create_info).hash;
 	}
 };
 
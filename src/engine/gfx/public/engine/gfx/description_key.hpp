@@ -0,0 +1,173 @@
+#pragma once
+
+#include "engine/core.hpp"
+#include "engine/flags.hpp"
+#include "engine/hash.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ze::gfx
+{
+
+/**
+ * Non-owning key of a description, used for lookups
+ */
+struct DescriptionKeyView
+{
+	uint64_t hash;
+	std::span<const uint8_t> data;
+};
+
+/**
+ * Owning key of a description (pipeline, render pass, sampler...)
+ * The description is stored as a compact byte blob: only its fields, without padding, and spans/vectors by value,
+ * so keys never reference the memory of the description they were built from
+ */
+class DescriptionKey
+{
+public:
+	explicit DescriptionKey(const DescriptionKeyView& in_view)
+		: hash(in_view.hash), size(in_view.data.size()), data(std::make_unique<uint8_t[]>(in_view.data.size()))
+	{
+		std::memcpy(data.get(), in_view.data.data(), size);
+	}
+
+	[[nodiscard]] DescriptionKeyView get_view() const { return { hash, { data.get(), size } }; }
+private:
+	uint64_t hash;
+	size_t size;
+	std::unique_ptr<uint8_t[]> data;
+};
+
+struct DescriptionKeyHash
+{
+	using is_transparent = void;
+
+	size_t operator()(const DescriptionKeyView& in_key) const noexcept { return in_key.hash; }
+	size_t operator()(const DescriptionKey& in_key) const noexcept { return in_key.get_view().hash; }
+};
+
+struct DescriptionKeyEqual
+{
+	using is_transparent = void;
+
+	bool operator()(const DescriptionKeyView& in_left, const DescriptionKeyView& in_right) const noexcept
+	{
+		return in_left.hash == in_right.hash &&
+			in_left.data.size() == in_right.data.size() &&
+			std::memcmp(in_left.data.data(), in_right.data.data(), in_left.data.size()) == 0;
+	}
+
+	bool operator()(const DescriptionKey& in_left, const DescriptionKeyView& in_right) const noexcept { return (*this)(in_left.get_view(), in_right); }
+	bool operator()(const DescriptionKeyView& in_left, const DescriptionKey& in_right) const noexcept { return (*this)(in_left, in_right.get_view()); }
+	bool operator()(const DescriptionKey& in_left, const DescriptionKey& in_right) const noexcept { return (*this)(in_left.get_view(), in_right.get_view()); }
+};
+
+/**
+ * Cache of objects created from descriptions, looked up without allocating
+ */
+template<typename T>
+using DescriptionMap = robin_hood::unordered_node_map<DescriptionKey, T, DescriptionKeyHash, DescriptionKeyEqual>;
+
+/**
+ * Writes the fields of a description to build its key
+ * Descriptions implement `void write_description(DescriptionKeyBuilder&, const Description&)`
+ * Small descriptions are written to an inline buffer so building a key for a lookup doesn't allocate
+ */
+class DescriptionKeyBuilder
+{
+public:
+	DescriptionKeyBuilder() : data(inline_buffer.data()), size(0), capacity(inline_buffer.size()) {}
+
+	DescriptionKeyBuilder(const DescriptionKeyBuilder&) = delete;
+	DescriptionKeyBuilder& operator=(const DescriptionKeyBuilder&) = delete;
+
+	template<typename T>
+		requires std::is_scalar_v<T> && (!std::is_pointer_v<T>)
+	void write(const T in_value)
+	{
+		append(&in_value, sizeof(T));
+	}
+
+	template<typename T>
+	void write(const Flags<T> in_flags)
+	{
+		write(static_cast<typename Flags<T>::MaskType>(in_flags));
+	}
+
+	/** Strings are written by value, a null string is written as an empty one */
+	void write(const std::string_view in_string)
+	{
+		write(static_cast<uint32_t>(in_string.size()));
+		append(in_string.data(), in_string.size());
+	}
+
+	void write(const char* in_string)
+	{
+		write(in_string ? std::string_view(in_string) : std::string_view());
+	}
+
+	/** Write the size then every element of a range */
+	template<typename Range>
+	void write_range(const Range& in_range)
+	{
+		write(static_cast<uint32_t>(std::size(in_range)));
+		for (const auto& element : in_range)
+		{
+			if constexpr (std::is_scalar_v<std::remove_cvref_t<decltype(element)>>)
+				write(element);
+			else
+				write_description(*this, element);
+		}
+	}
+
+	/** Only valid until the next write */
+	[[nodiscard]] DescriptionKeyView get_view() const
+	{
+		return { hash_bytes(data, size), { data, size } };
+	}
+private:
+	void append(const void* in_data, size_t in_size)
+	{
+		if (size + in_size > capacity) [[unlikely]]
+			grow(size + in_size);
+
+		/** in_size is a constant for scalars so this is a single store once inlined */
+		if (in_size != 0)
+			std::memcpy(data + size, in_data, in_size);
+		size += in_size;
+	}
+
+	void grow(size_t in_min_capacity)
+	{
+		heap_buffer.resize(std::max(in_min_capacity, capacity * 2));
+		if (data == inline_buffer.data())
+			std::memcpy(heap_buffer.data(), inline_buffer.data(), size);
+		data = heap_buffer.data();
+		capacity = heap_buffer.size();
+	}
+private:
+	std::array<uint8_t, 512> inline_buffer;
+	std::vector<uint8_t> heap_buffer;
+	uint8_t* data;
+	size_t size;
+	size_t capacity;
+};
+
+/**
+ * Build the key of a description
+ */
+template<typename T>
+DescriptionKeyView build_description_key(DescriptionKeyBuilder& in_builder, const T& in_description)
+{
+	write_description(in_builder, in_description);
+	return in_builder.get_view();
+}
+
+}
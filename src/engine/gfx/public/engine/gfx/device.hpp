@@ -5,11 +5,13 @@
 #include "swapchain.hpp"
 #include "engine/result.hpp"
 #include "gfx_result.hpp"
-#include "engine/util/simple_pool.hpp"
+#include "engine/containers/slot_map.hpp"
+#include "engine/containers/small_vector.hpp"
 #include <span>
 #include "shader.hpp"
 #include "command.hpp"
 #include "gfx_pipeline.hpp"
+#include "description_key.hpp"
 #include "buffer.hpp"
 #include "pipeline_layout.hpp"
 #include "render_pass.hpp"
@@ -29,6 +31,11 @@ class Backend;
 class BackendDevice;
 class Device;
 
+/**
+ * Get the currently used device
+ */
+Device* get_device();
+
 namespace detail
 {
 
@@ -219,7 +226,7 @@ private:
 	PipelineColorBlendStateCreateInfo color_blend_state;
 	PipelineDepthStencilStateCreateInfo depth_stencil_state;
 	PipelineMultisamplingStateCreateInfo multisampling_state;
-	std::vector<PipelineShaderStage> stages;
+	SmallVector<PipelineShaderStage, max_shader_stages> stages;
 	PipelineVertexInputStateCreateInfo vertex_input_state;
 	PipelineInputAssemblyStateCreateInfo input_assembly_state;
 	PipelineRasterizationStateCreateInfo rasterizer_state;
@@ -722,6 +729,12 @@ public:
 		const uint64_t in_timeout = std::numeric_limits<uint64_t>::max());
 	void reset_fences(const std::span<FenceHandle>& in_fences);
 
+	/**
+	 * Non-blocking fence query
+	 * \return Success if signaled, NotReady otherwise
+	 */
+	[[nodiscard]] GfxResult get_fence_status(const FenceHandle& in_fence);
+
 	uint32_t get_srv_descriptor_index(const BufferHandle& in_buffer);
 	uint32_t get_uav_descriptor_index(const BufferHandle& in_buffer);
 	uint32_t get_srv_descriptor_index(const TextureViewHandle& in_texture_view);
@@ -803,11 +816,27 @@ public:
 	TextureViewHandle get_swapchain_backbuffer_view(const SwapchainHandle& in_swapchain) const;
 	BackendDeviceResource get_swapchain_backend_handle(const SwapchainHandle& in_swapchain) const;
 
+	/**
+	 * Get the resource of a handle, nullptr if the handle is null or stale (its resource has been freed)
+	 * Command list handles are raw pointers as their lifetime is managed by the command pools
+	 */
 	template<typename T>
 	[[nodiscard]] static T* cast_handle(const auto& in_handle)
 		requires detail::IsHandleCompatibleWith<T, std::decay_t<decltype(in_handle)>>::value
 	{
-		return in_handle ? reinterpret_cast<T*>(in_handle.get_handle()) : nullptr;		
+		if (!in_handle)
+			return nullptr;
+
+		if constexpr (std::is_same_v<T, detail::CommandList>)
+		{
+			return reinterpret_cast<T*>(in_handle.get_handle());
+		}
+		else
+		{
+			T* resource = get_device()->get_resource_map<T>().get(to_slot_handle(in_handle));
+			ZE_CHECKF(resource, "Stale handle {:#x}, its resource has been freed", in_handle.get_handle());
+			return resource;
+		}
 	}
 
 	template<typename Handle>
@@ -831,33 +860,55 @@ private:
 	BackendDeviceResource get_or_create_compute_pipeline(const ComputePipelineCreateInfo& in_create_info);
 	
 	[[nodiscard]] Frame& get_current_frame() { return *frames[current_frame]; }
+
+	template<typename Handle>
+	[[nodiscard]] static Handle to_resource_handle(const SlotMapHandle& in_handle) { return Handle(in_handle.to_u64()); }
+	[[nodiscard]] static SlotMapHandle to_slot_handle(const auto& in_handle) { return SlotMapHandle::from_u64(in_handle.get_handle()); }
+
+	template<typename T>
+	[[nodiscard]] auto& get_resource_map()
+	{
+		if constexpr (std::is_same_v<T, detail::Buffer>)
+			return buffers;
+		else if constexpr (std::is_same_v<T, detail::Texture>)
+			return textures;
+		else if constexpr (std::is_same_v<T, detail::TextureView>)
+			return texture_views;
+		else if constexpr (std::is_same_v<T, detail::Shader>)
+			return shaders;
+		else if constexpr (std::is_same_v<T, detail::Swapchain>)
+			return swapchains;
+		else if constexpr (std::is_same_v<T, detail::PipelineLayout>)
+			return pipeline_layouts;
+		else if constexpr (std::is_same_v<T, detail::Fence>)
+			return fences;
+		else if constexpr (std::is_same_v<T, detail::Semaphore>)
+			return semaphores;
+		else
+			return samplers;
+	}
 private:
 	Backend& backend;
 	std::unique_ptr<BackendDevice> backend_device;
 	size_t current_frame;
 	std::vector<std::unique_ptr<Frame>> frames;
 
-	std::unordered_map<RenderPassCreateInfo, BackendDeviceResource> render_passes;
-	std::unordered_map<GfxPipelineCreateInfo, BackendDeviceResource> gfx_pipelines;
-	std::unordered_map<ComputePipelineCreateInfo, BackendDeviceResource> compute_pipelines;
+	DescriptionMap<BackendDeviceResource> render_passes;
+	DescriptionMap<BackendDeviceResource> gfx_pipelines;
+	DescriptionMap<BackendDeviceResource> compute_pipelines;
 	
-	/** Resources pools */
-	ThreadSafeSimplePool<detail::Buffer> buffers;
-	ThreadSafeSimplePool<detail::Texture> textures;
-	ThreadSafeSimplePool<detail::TextureView> texture_views;
-	ThreadSafeSimplePool<detail::Shader> shaders;
-	ThreadSafeSimplePool<detail::Swapchain> swapchains;
-	ThreadSafeSimplePool<detail::PipelineLayout> pipeline_layouts;
-	ThreadSafeSimplePool<detail::Fence> fences;
-	ThreadSafeSimplePool<detail::Semaphore> semaphores;
-	ThreadSafeSimplePool<detail::Sampler> samplers;
+	/** Resources, handles are generational so freed resources are detected */
+	ThreadSafeSlotMap<detail::Buffer> buffers;
+	ThreadSafeSlotMap<detail::Texture> textures;
+	ThreadSafeSlotMap<detail::TextureView> texture_views;
+	ThreadSafeSlotMap<detail::Shader> shaders;
+	ThreadSafeSlotMap<detail::Swapchain> swapchains;
+	ThreadSafeSlotMap<detail::PipelineLayout> pipeline_layouts;
+	ThreadSafeSlotMap<detail::Fence> fences;
+	ThreadSafeSlotMap<detail::Semaphore> semaphores;
+	ThreadSafeSlotMap<detail::Sampler> samplers;
 };
 	
-/**
- * Get the currently used device
- */
-Device* get_device();
-
 /**
  * Smart device resources
  */
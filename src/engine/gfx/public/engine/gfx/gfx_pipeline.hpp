@@ -426,153 +426,118 @@ struct GfxPipelineCreateInfo
 			subpass == in_create_info.subpass;
 	}
 };
-	
-}
 
-namespace std
+/** Keys */
+inline void write_description(DescriptionKeyBuilder& in_builder, const VertexInputBindingDescription& in_binding)
 {
+	in_builder.write(in_binding.binding);
+	in_builder.write(in_binding.stride);
+	in_builder.write(in_binding.input_rate);
+}
 
-template<> struct hash<ze::gfx::VertexInputBindingDescription>
+inline void write_description(DescriptionKeyBuilder& in_builder, const VertexInputAttributeDescription& in_attribute)
 {
-	uint64_t operator()(const ze::gfx::VertexInputBindingDescription& in_binding) const noexcept
-	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_binding.binding);
-		ze::hash_combine(hash, in_binding.input_rate);
-		ze::hash_combine(hash, in_binding.stride);
-			
-		return hash;
-	}
-};
+	in_builder.write(in_attribute.location);
+	in_builder.write(in_attribute.binding);
+	in_builder.write(in_attribute.format);
+	in_builder.write(in_attribute.offset);
+}
 
-template<> struct hash<ze::gfx::VertexInputAttributeDescription>
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineVertexInputStateCreateInfo& in_state)
 {
-	uint64_t operator()(const ze::gfx::VertexInputAttributeDescription& in_attribute) const noexcept
-	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_attribute.binding);
-		ze::hash_combine(hash, in_attribute.location);
-		ze::hash_combine(hash, in_attribute.format);
-		ze::hash_combine(hash, in_attribute.offset);
-			
-		return hash;
-	}
-};
+	in_builder.write_range(in_state.input_binding_descriptions);
+	in_builder.write_range(in_state.input_attribute_descriptions);
+}
 
-template<> struct hash<ze::gfx::PipelineVertexInputStateCreateInfo>
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineInputAssemblyStateCreateInfo& in_state)
 {
-	uint64_t operator()(const ze::gfx::PipelineVertexInputStateCreateInfo& in_state) const noexcept
-	{
-		uint64_t hash = 0;
-
-		for(const auto& binding : in_state.input_binding_descriptions)
-			ze::hash_combine(hash, binding);
-			
-		for(const auto& attribute : in_state.input_attribute_descriptions)
-			ze::hash_combine(hash, attribute);
-			
-		return hash;
-	}
-};
+	in_builder.write(in_state.primitive_topology);
+}
 
-template<> struct hash<ze::gfx::PipelineInputAssemblyStateCreateInfo>
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineRasterizationStateCreateInfo& in_state)
 {
-	uint64_t operator()(const ze::gfx::PipelineInputAssemblyStateCreateInfo& in_state) const noexcept
-	{
-		uint64_t hash = 0;
+	in_builder.write(in_state.polygon_mode);
+	in_builder.write(in_state.cull_mode);
+	in_builder.write(in_state.front_face);
+	in_builder.write(in_state.enable_depth_clamp);
+	in_builder.write(in_state.enable_depth_bias);
+	in_builder.write(in_state.depth_bias_constant_factor);
+	in_builder.write(in_state.depth_bias_clamp);
+	in_builder.write(in_state.depth_bias_slope_factor);
+}
 
-		ze::hash_combine(hash, in_state.primitive_topology);
-			
-		return hash;
-	}
-};
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineMultisamplingStateCreateInfo& in_state)
+{
+	in_builder.write(in_state.samples);
+}
 
-template<> struct hash<ze::gfx::PipelineMultisamplingStateCreateInfo>
+inline void write_description(DescriptionKeyBuilder& in_builder, const StencilOpState& in_state)
 {
-	uint64_t operator()(const ze::gfx::PipelineMultisamplingStateCreateInfo& in_state) const noexcept
-	{
-		uint64_t hash = 0;
+	in_builder.write(in_state.fail_op);
+	in_builder.write(in_state.pass_op);
+	in_builder.write(in_state.depth_fail_op);
+	in_builder.write(in_state.compare_op);
+	in_builder.write(in_state.compare_mask);
+	in_builder.write(in_state.write_mask);
+	in_builder.write(in_state.reference);
+}
 
-		ze::hash_combine(hash, in_state.samples);
-			
-		return hash;
-	}
-};
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineDepthStencilStateCreateInfo& in_state)
+{
+	in_builder.write(in_state.enable_depth_test);
+	in_builder.write(in_state.enable_depth_write);
+	in_builder.write(in_state.depth_compare_op);
+	in_builder.write(in_state.enable_depth_bounds_test);
+	in_builder.write(in_state.enable_stencil_test);
+	write_description(in_builder, in_state.front_face);
+	write_description(in_builder, in_state.back_face);
+}
 
-template<> struct hash<ze::gfx::PipelineRasterizationStateCreateInfo>
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineColorBlendAttachmentState& in_state)
 {
-	uint64_t operator()(const ze::gfx::PipelineRasterizationStateCreateInfo& in_state) const noexcept
-	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_state.enable_depth_clamp);
-		ze::hash_combine(hash, in_state.polygon_mode);
-		ze::hash_combine(hash, in_state.cull_mode);
-		ze::hash_combine(hash, in_state.enable_depth_bias);
-		ze::hash_combine(hash, in_state.depth_bias_constant_factor);
-		ze::hash_combine(hash, in_state.depth_bias_slope_factor);
-		ze::hash_combine(hash, in_state.depth_bias_clamp);
-			
-		return hash;
-	}
-};
+	in_builder.write(in_state.enable_blend);
+	in_builder.write(in_state.src_color_blend_factor);
+	in_builder.write(in_state.dst_color_blend_factor);
+	in_builder.write(in_state.color_blend_op);
+	in_builder.write(in_state.src_alpha_blend_factor);
+	in_builder.write(in_state.dst_alpha_blend_factor);
+	in_builder.write(in_state.alpha_blend_op);
+	in_builder.write(in_state.color_write_flags);
+}
 
-template<> struct hash<ze::gfx::StencilOpState>
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineColorBlendStateCreateInfo& in_state)
 {
-	uint64_t operator()(const ze::gfx::StencilOpState& in_state) const noexcept
-	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_state.pass_op);
-		ze::hash_combine(hash, in_state.fail_op);
-		ze::hash_combine(hash, in_state.depth_fail_op);
-		ze::hash_combine(hash, in_state.compare_op);
-		ze::hash_combine(hash, in_state.compare_mask);
-		ze::hash_combine(hash, in_state.write_mask);
-		ze::hash_combine(hash, in_state.reference);
-			
-		return hash;
-	}
-};
+	in_builder.write(in_state.enable_logic_op);
+	in_builder.write(in_state.logic_op);
+	in_builder.write_range(in_state.attachments);
+}
 
-template<> struct hash<ze::gfx::PipelineDepthStencilStateCreateInfo>
+inline void write_description(DescriptionKeyBuilder& in_builder, const GfxPipelineCreateInfo& in_create_info)
+{
+	in_builder.write_range(in_create_info.shader_stages);
+	write_description(in_builder, in_create_info.vertex_input_state);
+	write_description(in_builder, in_create_info.input_assembly_state);
+	write_description(in_builder, in_create_info.rasterization_state);
+	write_description(in_builder, in_create_info.multisampling_state);
+	write_description(in_builder, in_create_info.depth_stencil_state);
+	write_description(in_builder, in_create_info.color_blend_state);
+	in_builder.write(in_create_info.pipeline_layout);
+	in_builder.write(in_create_info.render_pass);
+	in_builder.write(in_create_info.subpass);
+}
+
+}
+
+namespace std
 {
-	uint64_t operator()(const ze::gfx::PipelineDepthStencilStateCreateInfo& in_state) const noexcept
-	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_state.enable_depth_test);
-		ze::hash_combine(hash, in_state.enable_depth_write);
-		ze::hash_combine(hash, in_state.depth_compare_op);
-		ze::hash_combine(hash, in_state.enable_depth_bounds_test);
-		ze::hash_combine(hash, in_state.front_face);
-		ze::hash_combine(hash, in_state.back_face);
-			
-		return hash;
-	}
-};
 
 template<> struct hash<ze::gfx::GfxPipelineCreateInfo>
 {
 	uint64_t operator()(const ze::gfx::GfxPipelineCreateInfo& in_create_info) const noexcept
 	{
-		uint64_t hash = std::hash<uint32_t>()(in_create_info.subpass);
-
-		for(const auto& stage : in_create_info.shader_stages)
-			ze::hash_combine(hash, stage);
-
-		ze::hash_combine(hash, in_create_info.vertex_input_state);
-		ze::hash_combine(hash, in_create_info.input_assembly_state);
-		ze::hash_combine(hash, in_create_info.multisampling_state);
-		ze::hash_combine(hash, in_create_info.rasterization_state);
-		ze::hash_combine(hash, in_create_info.depth_stencil_state);
-		ze::hash_combine(hash, in_create_info.pipeline_layout);
-		ze::hash_combine(hash, in_create_info.render_pass);
-
-		return hash;
+		ze::gfx::DescriptionKeyBuilder builder;
+		return build_description_key(builder, in_create_info).hash;
 	}
 };
 
-}
\ No newline at end of file
+}
@@ -10,6 +10,7 @@ enum class GfxResult
 {
 	Success = 0,
 	Timeout = 1,
+	NotReady = 2,
 	
 	ErrorUnknown = -1,
 	ErrorOutOfDeviceMemory = -2,
@@ -32,6 +33,8 @@ inline std::string_view to_string(const ze::gfx::GfxResult in_result)
 		return "Success";
 	case ze::gfx::GfxResult::Timeout:
 		return "Timeout";
+	case ze::gfx::GfxResult::NotReady:
+		return "NotReady";
 	case ze::gfx::GfxResult::ErrorUnknown:
 		return "ErrorUnknown";
 	case ze::gfx::GfxResult::ErrorOutOfDeviceMemory:
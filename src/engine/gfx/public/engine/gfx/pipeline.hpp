@@ -3,6 +3,7 @@
 #include "engine/flags.hpp"
 #include "engine/gfx/device_resource.hpp"
 #include "engine/hash.hpp"
+#include "description_key.hpp"
 #include "texture.hpp"
 
 namespace ze::gfx
@@ -76,6 +77,13 @@ struct PipelineShaderStage
 	}
 };
 
+inline void write_description(DescriptionKeyBuilder& in_builder, const PipelineShaderStage& in_stage)
+{
+	in_builder.write(in_stage.shader_stage);
+	in_builder.write(in_stage.shader);
+	in_builder.write(in_stage.entry_point);
+}
+
 static constexpr size_t max_shader_stages = 6;
 
 enum class PipelineBindPoint
@@ -151,13 +159,8 @@ template<> struct hash<ze::gfx::PipelineShaderStage>
 {
 	uint64_t operator()(const ze::gfx::PipelineShaderStage& in_stage) const noexcept
 	{
-		uint64_t hash = 0;
-
-		ze::hash_combine(hash, in_stage.shader_stage);
-		ze::hash_combine(hash, in_stage.shader);
-		ze::hash_combine(hash, in_stage.entry_point);
-
-		return hash;
+		ze::gfx::DescriptionKeyBuilder builder;
+		return build_description_key(builder, in_stage).hash;
 	}
 };	
 
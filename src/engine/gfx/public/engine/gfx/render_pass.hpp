@@ -1,7 +1,10 @@
 #pragma once
 
 #include "engine/hash.hpp"
+#include "description_key.hpp"
 #include "texture.hpp"
+#include "gfx_pipeline.hpp"
+#include "engine/containers/small_vector.hpp"
 #include <array>
 #include <variant>
 #include <algorithm>
@@ -85,19 +88,26 @@ struct AttachmentReference
 	}
 };
 
+/**
+ * Per-attachment lists of render passes and framebuffers, built each time a render pass begins
+ * Sized for every color attachment plus the depth/stencil attachment so they stay off the heap
+ */
+template<typename T>
+using AttachmentVector = SmallVector<T, max_attachments_per_framebuffer + 1>;
+
 struct SubpassDescription
 {
-	std::vector<AttachmentReference> input_attachments;
-	std::vector<AttachmentReference> color_attachments;
-	std::vector<AttachmentReference> resolve_attachments;
+	AttachmentVector<AttachmentReference> input_attachments;
+	AttachmentVector<AttachmentReference> color_attachments;
+	AttachmentVector<AttachmentReference> resolve_attachments;
 	AttachmentReference depth_stencil_attachment;
-	std::vector<uint32_t> preserve_attachments;
+	AttachmentVector<uint32_t> preserve_attachments;
 
-	SubpassDescription(const std::vector<AttachmentReference>& in_input_attachments = {},
-		const std::vector<AttachmentReference>& in_color_attachments = {},
-		const std::vector<AttachmentReference>& in_resolve_attachments = {},
+	SubpassDescription(const AttachmentVector<AttachmentReference>& in_input_attachments = {},
+		const AttachmentVector<AttachmentReference>& in_color_attachments = {},
+		const AttachmentVector<AttachmentReference>& in_resolve_attachments = {},
 		const AttachmentReference& in_depth_stencil_attachment = AttachmentReference(),
-		const std::vector<uint32_t>& in_preserve_attachments = {}) :
+		const AttachmentVector<uint32_t>& in_preserve_attachments = {}) :
 		input_attachments(in_input_attachments), color_attachments(in_color_attachments),
 		resolve_attachments(in_resolve_attachments), depth_stencil_attachment(in_depth_stencil_attachment),
 		preserve_attachments(in_preserve_attachments) {}
@@ -114,11 +124,11 @@ struct SubpassDescription
 
 struct RenderPassCreateInfo
 {
-	std::vector<AttachmentDescription> attachments;
-	std::vector<SubpassDescription> subpasses;
+	AttachmentVector<AttachmentDescription> attachments;
+	SmallVector<SubpassDescription, 1> subpasses;
 
-	RenderPassCreateInfo(const std::vector<AttachmentDescription>& in_attachments,
-		const std::vector<SubpassDescription>& in_subpasses) : attachments(in_attachments),
+	RenderPassCreateInfo(const AttachmentVector<AttachmentDescription>& in_attachments,
+		const SmallVector<SubpassDescription, 1>& in_subpasses) : attachments(in_attachments),
 		subpasses(in_subpasses) {}
 
 	bool operator==(const RenderPassCreateInfo& in_info) const
@@ -155,12 +165,46 @@ union ClearValue
 		: clear_depth_stencil_value(in_clear_depth_stencil_value) {}
 };
 
+/** Keys */
+inline void write_description(DescriptionKeyBuilder& in_builder, const AttachmentDescription& in_description)
+{
+	in_builder.write(in_description.format);
+	in_builder.write(in_description.samples);
+	in_builder.write(in_description.load_op);
+	in_builder.write(in_description.store_op);
+	in_builder.write(in_description.stencil_load_op);
+	in_builder.write(in_description.stencil_store_op);
+	in_builder.write(in_description.initial_layout);
+	in_builder.write(in_description.final_layout);
+}
+
+inline void write_description(DescriptionKeyBuilder& in_builder, const AttachmentReference& in_ref)
+{
+	in_builder.write(in_ref.attachment);
+	in_builder.write(in_ref.layout);
+}
+
+inline void write_description(DescriptionKeyBuilder& in_builder, const SubpassDescription& in_subpass)
+{
+	in_builder.write_range(in_subpass.input_attachments);
+	in_builder.write_range(in_subpass.color_attachments);
+	in_builder.write_range(in_subpass.resolve_attachments);
+	write_description(in_builder, in_subpass.depth_stencil_attachment);
+	in_builder.write_range(in_subpass.preserve_attachments);
+}
+
+inline void write_description(DescriptionKeyBuilder& in_builder, const RenderPassCreateInfo& in_create_info)
+{
+	in_builder.write_range(in_create_info.attachments);
+	in_builder.write_range(in_create_info.subpasses);
+}
+
 /**
  * A framebuffer (containers of texture views)
  */
 struct Framebuffer
 {
-	std::vector<BackendDeviceResource> attachments;
+	AttachmentVector<BackendDeviceResource> attachments;
 	uint32_t width;
 	uint32_t height;
 	uint32_t layers;
@@ -187,69 +231,12 @@ namespace std
 {
 
 
-template<> struct hash<ze::gfx::AttachmentDescription>
-{
-	uint64_t operator()(const ze::gfx::AttachmentDescription& in_description) const noexcept
-	{
-		uint64_t hash = 0;
-		ze::hash_combine(hash, in_description.format);
-		ze::hash_combine(hash, in_description.samples);
-		ze::hash_combine(hash, in_description.load_op);
-		ze::hash_combine(hash, in_description.store_op);
-		ze::hash_combine(hash, in_description.stencil_load_op);
-		ze::hash_combine(hash, in_description.stencil_store_op);
-		ze::hash_combine(hash, in_description.initial_layout);
-		ze::hash_combine(hash, in_description.final_layout);
-		return hash;
-	}
-};
-
-template<> struct hash<ze::gfx::AttachmentReference>
-{
-	uint64_t operator()(const ze::gfx::AttachmentReference& in_ref) const noexcept
-	{
-		uint64_t hash = 0;
-		ze::hash_combine(hash, in_ref.attachment);
-		ze::hash_combine(hash, in_ref.layout);
-		return hash;
-	}
-};
-
-template<> struct hash<ze::gfx::SubpassDescription>
-{
-	uint64_t operator()(const ze::gfx::SubpassDescription& in_subpass) const noexcept
-	{
-		uint64_t hash = 0;
-		for(const auto& attachment : in_subpass.input_attachments)
-			ze::hash_combine(hash, attachment);
-
-		for(const auto& attachment : in_subpass.color_attachments)
-			ze::hash_combine(hash, attachment);
-
-		for(const auto& attachment : in_subpass.resolve_attachments)
-			ze::hash_combine(hash, attachment);
-
-		ze::hash_combine(hash, in_subpass.depth_stencil_attachment);
-
-		for(const auto& attachment : in_subpass.resolve_attachments)
-			ze::hash_combine(hash, attachment);
-
-		return hash;
-	}
-};
-
 template<> struct hash<ze::gfx::RenderPassCreateInfo>
 {
 	uint64_t operator()(const ze::gfx::RenderPassCreateInfo& in_create_info) const noexcept
 	{
-		uint64_t hash = 0;
-		for(const auto& attachment : in_create_info.attachments)
-			ze::hash_combine(hash, attachment);
-
-		for(const auto& subpass : in_create_info.subpasses)
-			ze::hash_combine(hash, subpass);
-		
-		return hash;
+		ze::gfx::DescriptionKeyBuilder builder;
+		return build_description_key(builder, in_create_info).hash;
 	}
 };
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "gfx_pipeline.hpp"
+#include "description_key.hpp"
+#include <limits>
+
 namespace ze::gfx
 {
 
@@ -59,6 +63,54 @@ struct SamplerCreateInfo
 		mip_lod_bias(in_mip_lod_bias), compare_op(in_compare_op),
 		enable_anisotropy(in_enable_aniostropy), max_anisotropy(in_max_anisotropy),
 		min_lod(in_min_lod), max_lod(in_max_lod), border_color(in_border_color) {}
+
+	bool operator==(const SamplerCreateInfo& in_other) const
+	{
+		return min_filter == in_other.min_filter &&
+			mag_filter == in_other.mag_filter &&
+			mip_map_mode == in_other.mip_map_mode &&
+			address_mode_u == in_other.address_mode_u &&
+			address_mode_v == in_other.address_mode_v &&
+			address_mode_w == in_other.address_mode_w &&
+			mip_lod_bias == in_other.mip_lod_bias &&
+			compare_op == in_other.compare_op &&
+			enable_anisotropy == in_other.enable_anisotropy &&
+			max_anisotropy == in_other.max_anisotropy &&
+			min_lod == in_other.min_lod &&
+			max_lod == in_other.max_lod &&
+			border_color == in_other.border_color;
+	}
+};
+
+inline void write_description(DescriptionKeyBuilder& in_builder, const SamplerCreateInfo& in_create_info)
+{
+	in_builder.write(in_create_info.min_filter);
+	in_builder.write(in_create_info.mag_filter);
+	in_builder.write(in_create_info.mip_map_mode);
+	in_builder.write(in_create_info.address_mode_u);
+	in_builder.write(in_create_info.address_mode_v);
+	in_builder.write(in_create_info.address_mode_w);
+	in_builder.write(in_create_info.mip_lod_bias);
+	in_builder.write(in_create_info.compare_op);
+	in_builder.write(in_create_info.enable_anisotropy);
+	in_builder.write(in_create_info.max_anisotropy);
+	in_builder.write(in_create_info.min_lod);
+	in_builder.write(in_create_info.max_lod);
+	in_builder.write(in_create_info.border_color);
+}
+
+}
+
+namespace std
+{
+
+template<> struct hash<ze::gfx::SamplerCreateInfo>
+{
+	uint64_t operator()(const ze::gfx::SamplerCreateInfo& in_create_info) const noexcept
+	{
+		ze::gfx::DescriptionKeyBuilder builder;
+		return build_description_key(builder, in_create_info).hash;
+	}
 };
 
 }
\ No newline at end of file
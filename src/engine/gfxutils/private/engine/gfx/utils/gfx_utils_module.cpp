@@ -58,11 +58,13 @@ void GfxUtilsModule::load_required_shaders(shadersystem::ShaderManager& in_shade
 		"{} shader not found! Can't resume.",
 		in_name);
 
+	/** May already be compiling or compiled, see Engine startup */
 	const auto permutation = shader->get_permutation({});
-	permutation->compile();
+	if (permutation->get_state() != shadersystem::ShaderPermutationState::Available)
+		permutation->compile();
 
 	/** Wait for all shaders to be compiled */
-	while (permutation->is_compiling()) {}
+	permutation->wait_for_compilation();
 
 	ZE_ASSERTF(permutation->is_available(),
 		"{} shader permutation unavailable! Can't resume.", 
@@ -20,7 +20,7 @@ void generate_mipmaps(shadersystem::ShaderManager& in_shader_manager,
 {
 	ZE_CHECK(in_layer_count == 1);
 
-	if (const auto instance = in_shader_manager.get_shader("SPDMipmapsGen")->instantiate({}))
+	if (const auto instance = in_shader_manager.get_shader(ZE_NAME("SPDMipmapsGen"))->instantiate({}))
 	{
 		varAU2(dispatch_thread_group_count);
 		varAU2(work_group_offset);
@@ -50,14 +50,14 @@ void generate_mipmaps(shadersystem::ShaderManager& in_shader_manager,
 		const uint32_t dispatch_y = dispatch_thread_group_count[1];
 		const uint32_t dispatch_z = in_layer_count;
 
-		instance->set_parameter("work_group_count", work_group_and_mip_count[0]);
-		instance->set_parameter("mip_count", work_group_and_mip_count[1]);
-		instance->set_parameter("work_group_offset", { work_group_offset[0], work_group_offset[1] });
-		instance->set_parameter("global_atomic_counter", global_atomic_counter.get());
-		instance->set_parameter("src_texture", mips[0].get());
-		instance->set_parameter_uav("mips", std::span { mips.begin() + 1, mips.end() });
-		instance->set_parameter("sampler", sampler.get());
-		instance->set_parameter("inv_input_size", 
+		instance->set_parameter(ZE_NAME("work_group_count"), work_group_and_mip_count[0]);
+		instance->set_parameter(ZE_NAME("mip_count"), work_group_and_mip_count[1]);
+		instance->set_parameter(ZE_NAME("work_group_offset"), { work_group_offset[0], work_group_offset[1] });
+		instance->set_parameter(ZE_NAME("global_atomic_counter"), global_atomic_counter.get());
+		instance->set_parameter(ZE_NAME("src_texture"), mips[0].get());
+		instance->set_parameter_uav(ZE_NAME("mips"), std::span { mips.begin() + 1, mips.end() });
+		instance->set_parameter(ZE_NAME("sampler"), sampler.get());
+		instance->set_parameter(ZE_NAME("inv_input_size"), 
 			glm::vec2 
 			{
 				1.f / static_cast<float>(in_width),
@@ -60,16 +60,16 @@ public:
 
 			for (size_t i = 0; i < dispatch_count; ++i)
 			{
-				if (const auto instance = shader_manager.get_shader("ScatterUpload")->instantiate({}))
+				if (const auto instance = shader_manager.get_shader(ZE_NAME("ScatterUpload"))->instantiate({}))
 				{
-					instance->set_parameter("offset", static_cast<uint32_t>(i * max_threads_per_work_group));
-					instance->set_parameter("element_count", element_count);
-					instance->set_parameter("element_size", static_cast<uint32_t>(sizeof(ScatterElement)));
-					instance->set_parameter("data_offset_in_element", static_cast<uint32_t>(offsetof(ScatterElement, data)));
-					instance->set_parameter("data_size", static_cast<uint32_t>(sizeof(T)));
-					instance->set_parameter("threads_per_element", static_cast<uint32_t>(threads_per_element));
-					instance->set_parameter("upload_buffer", upload_buffer.get());
-					instance->set_parameter("dst_buffer", in_destination);
+					instance->set_parameter(ZE_NAME("offset"), static_cast<uint32_t>(i * max_threads_per_work_group));
+					instance->set_parameter(ZE_NAME("element_count"), element_count);
+					instance->set_parameter(ZE_NAME("element_size"), static_cast<uint32_t>(sizeof(ScatterElement)));
+					instance->set_parameter(ZE_NAME("data_offset_in_element"), static_cast<uint32_t>(offsetof(ScatterElement, data)));
+					instance->set_parameter(ZE_NAME("data_size"), static_cast<uint32_t>(sizeof(T)));
+					instance->set_parameter(ZE_NAME("threads_per_element"), static_cast<uint32_t>(threads_per_element));
+					instance->set_parameter(ZE_NAME("upload_buffer"), upload_buffer.get());
+					instance->set_parameter(ZE_NAME("dst_buffer"), in_destination);
 					instance->bind(in_list);
 					get_device()->cmd_dispatch(in_list, 1, 1, 1);
 				}
@@ -20,6 +20,7 @@ std::unique_ptr<shadersystem::ShaderInstance> shader_instance;
 PipelineVertexInputStateCreateInfo vertex_input_state;
 std::vector<std::unique_ptr<platform::Cursor>> mouse_cursors;
 ImGuiMouseCursor last_mouse_cursor;
+constinit ModuleRef<platform::ApplicationModule> application_module("Application");
 
 std::array color_blend_states = { PipelineColorBlendAttachmentState(
 	true,
@@ -44,11 +45,26 @@ std::vector<uint8_t> read_text_file(const std::string& in_name)
 	return buffer;
 }
 
+void build_font_atlas()
+{
+	ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+	if (fonts->IsBuilt())
+		return;
+
+	/** Registered before building, otherwise ImGui adds its default font first */
+	fonts->AddFontFromFileTTF("assets/fonts/ReadexPro-Light.ttf", 18.f);
+
+	uint8_t* data = nullptr;
+	int width = 0;
+	int height = 0;
+	fonts->GetTexDataAsRGBA32(&data, &width, &height);
+}
+
 void initialize(shadersystem::ShaderManager& in_shader_manager)
 {
 	IMGUI_CHECKVERSION();
 
-	const auto platform = get_module<platform::ApplicationModule>("Application");
+	const auto platform = application_module.get();
 
 	ImGuiIO& io = ImGui::GetIO();
 	io.BackendPlatformName = "zinoengine_imgui_application";
@@ -75,7 +91,7 @@ void initialize(shadersystem::ShaderManager& in_shader_manager)
 	ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
 	platform_io.Platform_CreateWindow = [](ImGuiViewport* viewport)
 	{
-		const auto platform = get_module<platform::ApplicationModule>("Application");
+		const auto platform = application_module.get();
 
 		auto* platform_data = new ViewportPlatformData;
 		viewport->PlatformUserData = platform_data;
@@ -195,7 +211,7 @@ void initialize(shadersystem::ShaderManager& in_shader_manager)
 			rendergraph::RenderGraph render_graph(renderer_data->registry);
 			draw_viewport(viewport, render_graph, false);
 
-			render_graph.set_backbuffer_attachment("backbuffer",
+			render_graph.set_backbuffer_attachment(ZE_NAME("backbuffer"),
 				get_device()->get_swapchain_backbuffer_view(renderer_data->window.get_swapchain()),
 				static_cast<uint32_t>(viewport->Size.x),
 				static_cast<uint32_t>(viewport->Size.y));
@@ -211,7 +227,7 @@ void initialize(shadersystem::ShaderManager& in_shader_manager)
 		}
 	};
 
-	io.Fonts->AddFontFromFileTTF("assets/fonts/ReadexPro-Light.ttf", 18.f);
+	build_font_atlas();
 
 	{
 		auto result = get_device()->create_sampler(SamplerInfo());
@@ -247,7 +263,7 @@ void initialize(shadersystem::ShaderManager& in_shader_manager)
 
 	/** Get shaders */
 	{
-		shader_instance = in_shader_manager.get_shader("ImGui")->instantiate({});
+		shader_instance = in_shader_manager.get_shader(ZE_NAME("ImGui"))->instantiate({});
 		const auto& shader_map = shader_instance->get_permutation().get_shader_map();
 		ZE_ASSERTF(shader_map.size() == 2, "Failed to create ImGui shaders, see log. Exiting.");
 	}
@@ -300,7 +316,7 @@ void update_main_viewport(platform::Window&, SwapchainHandle in_swapchain)
 
 void new_frame(float in_delta_time, platform::Window& in_main_window)
 {
-	const auto platform = get_module<platform::ApplicationModule>("Application");
+	const auto platform = application_module.get();
 
 	ImGuiIO& io = ImGui::GetIO();
 	io.DeltaTime = in_delta_time;
@@ -323,7 +339,7 @@ void new_frame(float in_delta_time, platform::Window& in_main_window)
 void update_mouse_cursor()
 {
 	ImGuiIO& io = ImGui::GetIO();
-	const auto platform = get_module<platform::ApplicationModule>("Application");
+	const auto platform = application_module.get();
 
 	const ImGuiMouseCursor cursor = ImGui::GetMouseCursor();
 	last_mouse_cursor = cursor;
@@ -399,12 +415,12 @@ gfx::rendergraph::RenderPass& draw_viewport(ImGuiViewport* viewport, gfx::render
 
 		/** Global data */
 		const glm::vec2 scale = { 2.f / draw_data->DisplaySize.x, 2.f / draw_data->DisplaySize.y };
-		shader_instance->set_parameter("translate", glm::vec2 
+		shader_instance->set_parameter(ZE_NAME("translate"), glm::vec2 
 			{
 				-1.f - draw_data->DisplayPos.x * scale.x,
 				-1.f - draw_data->DisplayPos.y * scale.y
 			});
-		shader_instance->set_parameter("scale", scale);
+		shader_instance->set_parameter(ZE_NAME("scale"), scale);
 	};
 
 	update_viewport_buffers(viewport->DrawData, renderer_data->draw_data);
@@ -412,7 +428,7 @@ gfx::rendergraph::RenderPass& draw_viewport(ImGuiViewport* viewport, gfx::render
 	return in_render_graph.add_gfx_pass("ImGui",
 		[&](rendergraph::RenderPass& render_pass)
 		{
-			render_pass.add_color_output("backbuffer",
+			render_pass.add_color_output(ZE_NAME("backbuffer"),
 				{},
 				in_load);
 		},
@@ -425,7 +441,7 @@ gfx::rendergraph::RenderPass& draw_viewport(ImGuiViewport* viewport, gfx::render
 				LogicOp::NoOp,
 				color_blend_states });
 
-			shader_instance->set_parameter("sampler", sampler);
+			shader_instance->set_parameter(ZE_NAME("sampler"), sampler);
 
 			const ImDrawData* draw_data = viewport->DrawData;
 
@@ -460,7 +476,7 @@ gfx::rendergraph::RenderPass& draw_viewport(ImGuiViewport* viewport, gfx::render
 							static_cast<uint32_t>(clip_rect.w - clip_rect.y)));
 
 						if (!cmd.TextureId)
-							shader_instance->set_parameter("texture", font_texture_view);
+							shader_instance->set_parameter(ZE_NAME("texture"), font_texture_view);
 
 						shader_instance->bind(list);
 						get_device()->cmd_draw_indexed(list,
@@ -517,7 +533,7 @@ void present_viewports()
 
 void update_monitors()
 {
-	const auto platform = get_module<platform::ApplicationModule>("Application");
+	const auto platform = application_module.get();
 	ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
 	platform_io.Monitors.resize(0);
 	for (uint32_t i = 0; i < platform->get_application().get_num_monitors(); ++i)
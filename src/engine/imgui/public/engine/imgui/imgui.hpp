@@ -74,8 +74,15 @@ struct ViewportRendererData
 	}
 };
 
+/**
+ * Register the engine fonts and build the font atlas pixels, without touching the device
+ * Can run on a job before initialize, as long as the ImGui context exists and nothing else uses it meanwhile
+ */
+void build_font_atlas();
+
 /**
  * Initialize ImGui renderer (create default font atlas and setup pipeline & shaders)
+ * Builds the font atlas if build_font_atlas wasn't called before
  */
 void initialize(shadersystem::ShaderManager& in_shader_manager);
 void initialize_main_viewport(platform::Window& in_window, gfx::SwapchainHandle in_swapchain);
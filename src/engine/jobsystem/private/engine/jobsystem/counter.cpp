@@ -0,0 +1,186 @@
+#include "engine/jobsystem/counter.hpp"
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/worker_thread.hpp"
+#include "engine/util/simple_pool.hpp"
+#include <thread>
+
+namespace ze::jobsystem
+{
+
+namespace detail
+{
+
+SimplePool<SuccessorNode, 256, true> successor_node_pool(MemoryTag::Jobs);
+
+bool SuccessorList::push(Job* in_job)
+{
+	return push_node(successor_node_pool.allocate(in_job, nullptr, nullptr, nullptr));
+}
+
+bool SuccessorList::push(FiberContext* in_fiber)
+{
+	return push_node(successor_node_pool.allocate(nullptr, in_fiber, nullptr, nullptr));
+}
+
+bool SuccessorList::push(std::binary_semaphore* in_semaphore)
+{
+	return push_node(successor_node_pool.allocate(nullptr, nullptr, in_semaphore, nullptr));
+}
+
+bool SuccessorList::push_node(SuccessorNode* in_node)
+{
+	SuccessorNode* current_head = head.load(std::memory_order_acquire);
+	do
+	{
+		if (current_head == get_closed_marker())
+		{
+			successor_node_pool.free(in_node);
+			return false;
+		}
+
+		in_node->next = current_head;
+	} while (!head.compare_exchange_weak(current_head, in_node, std::memory_order_acq_rel, std::memory_order_acquire));
+
+	return true;
+}
+
+SuccessorNode* SuccessorList::close()
+{
+	/** The list must not be touched past this point, its owner may be destroyed as soon as it is closed */
+	return head.exchange(get_closed_marker(), std::memory_order_acq_rel);
+}
+
+void SuccessorList::release(SuccessorNode* in_nodes)
+{
+	SuccessorNode* node = in_nodes;
+	while (node && node != get_closed_marker())
+	{
+		SuccessorNode* next = node->next;
+		if (node->job)
+			node->job->release_dependency();
+		else if (node->fiber)
+			resume_fiber(node->fiber);
+		else
+			node->semaphore->release();
+
+		successor_node_pool.free(node);
+		node = next;
+	}
+}
+
+void SuccessorList::reopen()
+{
+	SuccessorNode* expected = get_closed_marker();
+	head.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+}
+
+void Counter::increment(const uint32_t in_count)
+{
+	ZE_CHECK(in_count < transition_bit);
+
+	uint32_t current = value.load(std::memory_order_relaxed);
+	while (true)
+	{
+		if (current & transition_bit)
+		{
+			/** Another thread is closing the list, it is only held for a few instructions */
+			std::this_thread::yield();
+			current = value.load(std::memory_order_relaxed);
+		}
+		else if (current == 0)
+		{
+			if (value.compare_exchange_weak(current, transition_bit, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				successors.reopen();
+				value.store(in_count, std::memory_order_release);
+				return;
+			}
+		}
+		else if (value.compare_exchange_weak(current, current + in_count, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+}
+
+void Counter::decrement()
+{
+	uint32_t current = value.load(std::memory_order_relaxed);
+	while (true)
+	{
+		ZE_CHECK(current != 0 && !(current & transition_bit));
+		if (current == 1)
+		{
+			if (value.compare_exchange_weak(current, transition_bit, std::memory_order_acq_rel, std::memory_order_relaxed))
+				break;
+		}
+		else if (value.compare_exchange_weak(current, current - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	/**
+	 * Only the successors taken from the list are touched once the counter reads zero,
+	 * as a waiter may destroy it from then on
+	 */
+	detail::SuccessorNode* nodes = successors.close();
+	value.store(0, std::memory_order_release);
+	detail::SuccessorList::release(nodes);
+}
+
+bool Counter::add_successor(Job* in_job)
+{
+	if (successors.push(in_job))
+		return true;
+
+	wait_for_transition();
+	return false;
+}
+
+bool Counter::add_waiter(detail::FiberContext* in_fiber)
+{
+	if (successors.push(in_fiber))
+		return true;
+
+	wait_for_transition();
+	return false;
+}
+
+void Counter::wait_for_transition() const
+{
+	while (value.load(std::memory_order_acquire) & transition_bit)
+		std::this_thread::yield();
+}
+
+void Counter::wait()
+{
+	if (is_zero())
+		return;
+
+	if (detail::suspend_current_fiber(*this))
+		return;
+
+	/** In fiber mode, jobs only run on workers: other threads sleep until the counter reaches zero */
+	if (get_execution_mode() == ExecutionMode::Fibers && !is_worker_thread())
+	{
+		thread_local std::binary_semaphore semaphore(0);
+		if (successors.push(&semaphore))
+			semaphore.acquire();
+		else
+			wait_for_transition();
+
+		return;
+	}
+
+	while (!is_zero())
+	{
+		if (!try_execute_one_job())
+			std::this_thread::yield();
+	}
+}
+
+}
@@ -1,50 +1,115 @@
 #include "engine/jobsystem/job.hpp"
 #include "engine/jobsystem/jobsystem.hpp"
 #include "engine/jobsystem/worker_thread.hpp"
-#include <deque>
+#include "engine/jobsystem/lane_pool.hpp"
 #include "engine/debug/assertions.hpp"
-#include "engine/util/simple_pool.hpp"
+#include <vector>
 
 namespace ze::jobsystem
 {
 
-namespace detail
+void Job::schedule()
 {
+	release_dependency();
+}
 
-JobPool global_job_pool;
+void Job::depends_on(Job& in_predecessor)
+{
+	pending_dependencies.fetch_add(1, std::memory_order_relaxed);
+	if (!in_predecessor.successors.push(this))
+		pending_dependencies.fetch_sub(1, std::memory_order_relaxed);
+}
 
-JobPool& get_job_pool()
+void Job::depends_on(Counter& in_counter)
 {
-	return global_job_pool;
+	pending_dependencies.fetch_add(1, std::memory_order_relaxed);
+	if (!in_counter.add_successor(this))
+		pending_dependencies.fetch_sub(1, std::memory_order_relaxed);
 }
 
+void Job::signal_on_finish(Counter& in_counter)
+{
+	ZE_ASSERT(!counter);
+	counter = &in_counter;
+	counter->increment();
 }
 
-void Job::schedule()
+void Job::release_dependency()
+{
+	if (release_dependency_no_submit())
+		submit();
+}
+
+bool Job::release_dependency_no_submit()
+{
+	return pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+void Job::schedule_bulk(std::span<Job*> in_jobs)
 {
-	if (type == JobType::Normal)
+	/** Reused between calls to not allocate each time */
+	thread_local std::array<std::vector<Job*>, 3> ready_jobs;
+
+	size_t ready_count = 0;
+	for (Job* job : in_jobs)
 	{
-		get_current_or_random_worker().enqueue(this);
-		WorkerThread::get_global_sleep_var().notify_all();
+		if (!job->release_dependency_no_submit())
+			continue;
+
+		if (job->lane != JobLane::Compute || job->type != JobType::Normal)
+		{
+			job->submit();
+			continue;
+		}
+
+		ready_jobs[static_cast<size_t>(job->priority)].emplace_back(job);
+		++ready_count;
 	}
-	else
+
+	if (ready_count == 0)
+		return;
+
+	const size_t worker_count = get_worker_count();
+	const size_t chunk_count = std::min(worker_count, ready_count);
+
+	/** The calling worker gets the first chunk into its own deque, others go to inboxes */
+	const size_t first_worker = get_current_or_random_worker().get_index();
+	for (auto& jobs : ready_jobs)
 	{
-		execute();
+		if (jobs.empty())
+			continue;
+
+		const size_t jobs_chunk_count = std::min(chunk_count, jobs.size());
+		const size_t chunk_size = jobs.size() / jobs_chunk_count;
+		const size_t remainder = jobs.size() % jobs_chunk_count;
+		size_t offset = 0;
+		for (size_t i = 0; i < jobs_chunk_count; ++i)
+		{
+			const size_t count = chunk_size + (i < remainder ? 1 : 0);
+			get_worker_by_idx((first_worker + i) % worker_count).enqueue_bulk(jobs.data() + offset, count);
+			offset += count;
+		}
+
+		jobs.clear();
 	}
-}
 
-void Job::continuate(Job* continuation)
-{
-	ZE_ASSERT(continuation_count + 1 < Job::max_continuations);
-	continuations[continuation_count++] = continuation;
+	wake_workers(chunk_count);
 }
 
-void Job::wait() const
+void Job::submit()
 {
-	while(!is_finished())
+	if (lane != JobLane::Compute)
+	{
+		get_lane_pool(lane).enqueue(this);
+	}
+	else if (type == JobType::Normal)
+	{
+		get_current_or_random_worker().enqueue(this);
+		wake_workers(1);
+	}
+	else
 	{
-		WorkerThread::get_global_sleep_var().notify_one();
-		get_current_or_random_worker().flush_one();
+		execute();
 	}
 }
 
@@ -52,30 +117,29 @@ void Job::execute()
 {
 	function(*this);
 	finish();
-	detail::get_job_pool().free(this);
 }
 
 void Job::finish()
 {
-	--unfinished_jobs;
+	/** The job is freed once it and all of its childs finished, not before */
+	if (unfinished_jobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
 
-	if (is_finished())
-	{
-		/** Tell the parent that we finished */
-		if (parent)
-		{
-			parent->finish();
-		}
+	/** Tell the parent that we finished */
+	if (parent)
+		parent->finish();
 
-		/** Run dependents */
-		for (uint8_t i = 0; i < continuation_count; ++i)
-		{
-			if (Job* continuation = continuations[i])
-			{
-				continuation->schedule();
-			}
-		}
-	}
+	if (counter)
+		counter->decrement();
+
+	/** Run dependents */
+	successors.close_and_release();
+
+	detail::free_job(this);
+
+	/** Fibers busy-waiting (looping on try_execute_one_job until something finished) may now be able to continue */
+	if (get_execution_mode() == ExecutionMode::Fibers)
+		detail::wake_busy_waiting_workers();
 }
 
 }
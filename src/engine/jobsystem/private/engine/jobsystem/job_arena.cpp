@@ -0,0 +1,132 @@
+#include "engine/jobsystem/job_arena.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/worker_thread.hpp"
+#include "engine/memory/tracking.hpp"
+#include <memory>
+#include <mutex>
+
+namespace ze::jobsystem::detail
+{
+
+JobArena::~JobArena()
+{
+	for (void* chunk : chunks)
+		memory::deallocate(chunk, chunk_size, chunk_size, MemoryTag::Jobs);
+}
+
+void* JobArena::allocate()
+{
+	/** Reclaim every slot freed by other threads at once, only the owner pops so there is no ABA issue */
+	if (!local_free_list)
+		local_free_list = remote_free_list.exchange(nullptr, std::memory_order_acquire);
+
+	if (FreeSlot* slot = local_free_list)
+	{
+		local_free_list = slot->next;
+		return slot;
+	}
+
+	if (bump_ptr == bump_end)
+		allocate_chunk();
+
+	void* ptr = bump_ptr;
+	bump_ptr += slot_size;
+	return ptr;
+}
+
+void JobArena::free_local(void* in_ptr)
+{
+	FreeSlot* slot = static_cast<FreeSlot*>(in_ptr);
+	slot->next = local_free_list;
+	local_free_list = slot;
+}
+
+void JobArena::free_remote(void* in_ptr)
+{
+	FreeSlot* slot = static_cast<FreeSlot*>(in_ptr);
+	FreeSlot* head = remote_free_list.load(std::memory_order_relaxed);
+	do
+	{
+		slot->next = head;
+	} while (!remote_free_list.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void JobArena::allocate_chunk()
+{
+	uint8_t* chunk = static_cast<uint8_t*>(memory::allocate(chunk_size, chunk_size, MemoryTag::Jobs));
+	ZE_ASSERTF(chunk, "Out of memory while allocating a job arena chunk of {} bytes", chunk_size);
+	new (chunk) ChunkHeader { this };
+	chunks.emplace_back(chunk);
+
+	bump_ptr = chunk + header_size;
+	bump_end = bump_ptr + ((chunk_size - header_size) / slot_size) * slot_size;
+}
+
+/** Arenas are never destroyed before exit since jobs they allocated may outlive their thread */
+std::mutex arenas_mutex;
+std::vector<std::unique_ptr<JobArena>> arenas;
+std::vector<JobArena*> orphan_arenas;
+
+struct ThreadJobArena
+{
+	JobArena* arena = nullptr;
+
+	~ThreadJobArena()
+	{
+		if (arena)
+		{
+			std::scoped_lock lock(arenas_mutex);
+			orphan_arenas.emplace_back(arena);
+		}
+	}
+};
+
+thread_local ThreadJobArena thread_job_arena;
+
+JobArena& get_thread_job_arena()
+{
+	if (!thread_job_arena.arena)
+	{
+		std::scoped_lock lock(arenas_mutex);
+		if (!orphan_arenas.empty())
+		{
+			thread_job_arena.arena = orphan_arenas.back();
+			orphan_arenas.pop_back();
+		}
+		else
+		{
+			thread_job_arena.arena = arenas.emplace_back(std::make_unique<JobArena>()).get();
+		}
+	}
+
+	return *thread_job_arena.arena;
+}
+
+std::atomic_uint64_t external_jobs_allocated = 0;
+
+void* allocate_job_memory()
+{
+	if (is_worker_thread())
+		add_to_counter(get_worker_by_idx(WorkerThread::get_current_worker_idx()).get_counters().jobs_allocated, 1);
+	else
+		external_jobs_allocated.fetch_add(1, std::memory_order_relaxed);
+
+	return get_thread_job_arena().allocate();
+}
+
+uint64_t get_external_job_allocation_count()
+{
+	return external_jobs_allocated.load(std::memory_order_relaxed);
+}
+
+void free_job_memory(void* in_ptr)
+{
+	JobArena& arena = get_thread_job_arena();
+	JobArena* owner = JobArena::get_owner(in_ptr);
+	if (owner == &arena)
+		arena.free_local(in_ptr);
+	else
+		owner->free_remote(in_ptr);
+}
+
+}
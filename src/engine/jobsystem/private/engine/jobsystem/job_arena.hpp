@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <vector>
+#include "engine/jobsystem/job.hpp"
+
+namespace ze::jobsystem::detail
+{
+
+/**
+ * Per-thread job allocator
+ * Jobs are carved out of chunks aligned on their own size, so the arena owning a job is found by masking its address
+ * Jobs freed by the owning thread go to a local free list without any atomic operation,
+ * jobs freed by other threads are pushed to a lock-free remote list that the owner reclaims when it runs out of slots
+ */
+class JobArena
+{
+	struct FreeSlot
+	{
+		FreeSlot* next;
+	};
+
+	struct ChunkHeader
+	{
+		JobArena* owner;
+	};
+
+public:
+	static constexpr size_t chunk_size = 64 * 1024;
+	static constexpr size_t slot_size = sizeof(Job);
+
+	/** Slots start on the first cache line after the chunk header */
+	static constexpr size_t header_size = (sizeof(ChunkHeader) + job_alignement - 1) & ~(job_alignement - 1);
+
+	static_assert(slot_size % job_alignement == 0);
+	static_assert(header_size + slot_size <= chunk_size);
+
+	JobArena() = default;
+	~JobArena();
+
+	JobArena(const JobArena&) = delete;
+	JobArena& operator=(const JobArena&) = delete;
+
+	/**
+	 * [OWNER ONLY] Get memory for a job, aligned on job_alignement
+	 */
+	void* allocate();
+
+	/**
+	 * [OWNER ONLY] Return a job slot allocated by this arena
+	 */
+	void free_local(void* in_ptr);
+
+	/**
+	 * [THREAD SAFE] Return a job slot allocated by this arena from another thread
+	 */
+	void free_remote(void* in_ptr);
+
+	static JobArena* get_owner(void* in_ptr)
+	{
+		const uintptr_t chunk_address = reinterpret_cast<uintptr_t>(in_ptr) & ~(chunk_size - 1);
+		return reinterpret_cast<ChunkHeader*>(chunk_address)->owner;
+	}
+private:
+	void allocate_chunk();
+private:
+	FreeSlot* local_free_list = nullptr;
+	uint8_t* bump_ptr = nullptr;
+	uint8_t* bump_end = nullptr;
+	std::vector<void*> chunks;
+
+	alignas(std::hardware_destructive_interference_size) std::atomic<FreeSlot*> remote_free_list = nullptr;
+};
+
+/**
+ * Arena of the calling thread, arenas of exited threads are adopted by new threads
+ */
+JobArena& get_thread_job_arena();
+
+/**
+ * Number of jobs allocated by non-worker threads, workers keep their own count
+ */
+uint64_t get_external_job_allocation_count();
+
+}
@@ -0,0 +1,105 @@
+#include "engine/jobsystem/job_graph.hpp"
+#include "engine/debug/assertions.hpp"
+
+namespace ze::jobsystem
+{
+
+void JobGraph::add_dependency(const NodeIndex in_node, const NodeIndex in_predecessor)
+{
+	ZE_ASSERT(in_node < nodes.size() && in_predecessor < nodes.size() && in_node != in_predecessor);
+	ZE_ASSERT(!is_running());
+
+	nodes[in_predecessor].successors.emplace_back(in_node);
+	nodes[in_node].predecessor_count++;
+	dirty = true;
+}
+
+void JobGraph::compile()
+{
+	roots.clear();
+	pending_predecessors = std::make_unique<std::atomic_uint32_t[]>(nodes.size());
+
+	/** Kahn's algorithm, reusing pending_predecessors as scratch to validate the graph has no cycles */
+	std::vector<NodeIndex> ready;
+	for (NodeIndex i = 0; i < nodes.size(); ++i)
+	{
+		pending_predecessors[i].store(nodes[i].predecessor_count, std::memory_order_relaxed);
+		if (nodes[i].predecessor_count == 0)
+		{
+			roots.emplace_back(i);
+			ready.emplace_back(i);
+		}
+	}
+
+	size_t visited_count = 0;
+	while (!ready.empty())
+	{
+		const NodeIndex node = ready.back();
+		ready.pop_back();
+		visited_count++;
+
+		for (const NodeIndex successor : nodes[node].successors)
+		{
+			if (pending_predecessors[successor].fetch_sub(1, std::memory_order_relaxed) == 1)
+				ready.emplace_back(successor);
+		}
+	}
+
+	ZE_ASSERTF(visited_count == nodes.size(), "JobGraph contains a cycle ({} nodes unreachable)", nodes.size() - visited_count);
+	dirty = false;
+}
+
+void JobGraph::submit()
+{
+	ZE_ASSERT(!is_running());
+
+	if (nodes.empty())
+		return;
+
+	if (dirty)
+		compile();
+
+	for (NodeIndex i = 0; i < nodes.size(); ++i)
+		pending_predecessors[i].store(nodes[i].predecessor_count, std::memory_order_relaxed);
+
+	counter.increment(static_cast<uint32_t>(nodes.size()));
+
+	root_jobs.clear();
+	for (const NodeIndex root : roots)
+		root_jobs.emplace_back(create_node_job(root));
+
+	Job::schedule_bulk(root_jobs);
+}
+
+Job* JobGraph::create_node_job(const NodeIndex in_node)
+{
+	return new_job<NodeJobData>(&JobGraph::execute_node, JobType::Normal, nodes[in_node].priority,
+		this, in_node);
+}
+
+void JobGraph::spawn_node(const NodeIndex in_node)
+{
+	create_node_job(in_node)->schedule();
+}
+
+void JobGraph::run_node(const NodeIndex in_node)
+{
+	const Node& node = nodes[in_node];
+	node.func();
+
+	for (const NodeIndex successor : node.successors)
+	{
+		if (pending_predecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			spawn_node(successor);
+	}
+
+	counter.decrement();
+}
+
+void JobGraph::execute_node(Job& in_job)
+{
+	const NodeJobData& data = *in_job.get_userdata<NodeJobData>();
+	data.graph->run_node(data.node);
+}
+
+}
@@ -2,31 +2,114 @@
 #include "engine/jobsystem/job.hpp"
 #include "engine/jobsystem/jobsystem.hpp"
 #include "engine/jobsystem/worker_thread.hpp"
+#include "engine/jobsystem/parker.hpp"
+#include "engine/jobsystem/job_arena.hpp"
+#include "engine/jobsystem/lane_pool.hpp"
+#include "engine/jobsystem/task.hpp"
 #include "engine/random.hpp"
+#if ZE_FEATURE(PROFILING)
+#include <deque>
+#include <Tracy.hpp>
+#endif
 
 namespace ze::jobsystem
 {
 
-ZE_DEFINE_LOG_CATEGORY(jobsystem);
+/** Workers are heap allocated since their address is captured by their thread */
+std::vector<std::unique_ptr<WorkerThread>> worker_threads;
+Parker parker;
 
-std::vector<WorkerThread> worker_threads;
+/** Indexed by JobLane, Compute jobs go to the workers */
+std::array<std::unique_ptr<LanePool>, job_lane_count> lane_pools;
+ExecutionMode execution_mode = ExecutionMode::Threads;
 
-void initialize()
+void initialize(const InitializeInfo& in_info)
 {
-	const uint32_t num_cores = std::thread::hardware_concurrency();
-	logger::info(log_jobsystem, "{} cores detected, spawning {} workers",
-		num_cores, num_cores - 1);
-	worker_threads.reserve(num_cores);
-	for(size_t i = 0; i < num_cores - 1; ++i)
+	execution_mode = in_info.execution_mode;
+
+	const uint32_t num_cores = hal::get_logical_core_count();
+	const uint64_t all_cores = num_cores >= 64 ? ~uint64_t(0) : (uint64_t(1) << num_cores) - 1;
+	const uint64_t worker_cores = in_info.reserved_cores != 0 ? all_cores & ~in_info.reserved_cores : 0;
+
+	std::vector<uint32_t> pinnable_cores;
+	for (uint32_t i = 0; i < std::min(num_cores, 64U); ++i)
+		if (!(in_info.reserved_cores & (uint64_t(1) << i)))
+			pinnable_cores.emplace_back(i);
+
+	/** Workers then have no affinity and share the reserved cores */
+	if (pinnable_cores.empty())
+		logger::warn(log_jobsystem, "Every core is reserved (mask {:#x}), workers will run on reserved cores",
+			in_info.reserved_cores);
+
+	size_t num_workers = in_info.worker_count;
+	if (num_workers == 0)
 	{
-		worker_threads.emplace_back(i);
+		num_workers = in_info.reserved_cores != 0 ? pinnable_cores.size() : num_cores - 1;
+		num_workers = std::max<size_t>(num_workers, 1);
+	}
+
+	logger::info(log_jobsystem, "{} cores detected ({} reserved), spawning {} workers ({}{})",
+		num_cores,
+		num_cores - pinnable_cores.size(),
+		num_workers,
+		execution_mode == ExecutionMode::Fibers ? "fibers" : "threads",
+		in_info.pin_workers ? ", pinned" : "");
+	parker.initialize(num_workers);
+	worker_threads.reserve(num_workers);
+	for(size_t i = 0; i < num_workers; ++i)
+	{
+		uint64_t affinity = worker_cores;
+		if (i < in_info.worker_affinities.size() && in_info.worker_affinities[i] != 0)
+			affinity = in_info.worker_affinities[i];
+		else if (in_info.pin_workers && !pinnable_cores.empty())
+			affinity = uint64_t(1) << pinnable_cores[i % pinnable_cores.size()];
+
+		worker_threads.emplace_back(std::make_unique<WorkerThread>(i,
+			affinity,
+			in_info.worker_priority,
+			in_info.fiber_stack_size));
 	}
+
+	lane_pools[static_cast<size_t>(JobLane::IO)] = std::make_unique<LanePool>("IO",
+		std::max<size_t>(in_info.io_thread_count, 1),
+		hal::ThreadPriority::Normal,
+		false);
+	lane_pools[static_cast<size_t>(JobLane::Background)] = std::make_unique<LanePool>("Background",
+		std::max<size_t>(in_info.background_thread_count, 1),
+		in_info.background_priority,
+		true);
+	detail::start_poll_thread();
 }
 
 void shutdown()
 {
+	const ParkingStats stats = parker.get_stats();
+	logger::info(log_jobsystem, "Workers parked {} times, {} wake-ups ({} wasted), average wake-up latency {:.1f} us (max {:.1f} us)",
+		stats.parks,
+		stats.wakeups,
+		stats.wasted_wakeups,
+		stats.get_average_wakeup_latency_ns() / 1000.0,
+		static_cast<double>(stats.max_wakeup_latency_ns) / 1000.0);
+
+	const WorkerStats total = get_stats().total;
+	logger::info(log_jobsystem, "{} jobs executed, workers busy {:.1f}% of the time, {:.1f}% of {} steal attempts succeeded",
+		total.jobs_executed,
+		total.get_busy_ratio() * 100.0,
+		total.get_steal_success_ratio() * 100.0,
+		total.steal_attempts);
+
+	/** Polled coroutines are resumed as jobs, stop before the workers */
+	detail::stop_poll_thread();
+
+	/** Lanes first, their jobs may still wait for compute jobs */
+	for (auto& lane_pool : lane_pools)
+		lane_pool.reset();
+
+	for (auto& worker : worker_threads)
+		worker->request_stop();
+
+	parker.unpark_all();
 	worker_threads.clear();
-	WorkerThread::get_global_sleep_var().notify_all();
 }
 
 size_t get_worker_count()
@@ -36,16 +119,141 @@ size_t get_worker_count()
 
 WorkerThread& get_worker_by_idx(size_t in_index)
 {
-	return worker_threads[in_index];
+	return *worker_threads[in_index];
 }
 
 WorkerThread& get_current_or_random_worker()
 {
-	if (WorkerThread::get_current_worker_idx() != -1Ui64)
+	if (is_worker_thread())
 		return get_worker_by_idx(WorkerThread::get_current_worker_idx());
 
     const auto idx = random_SM64<size_t>(0, get_worker_count() - 1);
 	return get_worker_by_idx(idx);
 }
 
-}
\ No newline at end of file
+Parker& get_parker()
+{
+	return parker;
+}
+
+LanePool& get_lane_pool(JobLane in_lane)
+{
+	ZE_CHECK(in_lane != JobLane::Compute);
+	return *lane_pools[static_cast<size_t>(in_lane)];
+}
+
+void wake_workers(size_t in_count)
+{
+	parker.unpark(in_count);
+}
+
+bool has_idle_workers()
+{
+	return parker.has_idle_workers();
+}
+
+ParkingStats get_parking_stats()
+{
+	return parker.get_stats();
+}
+
+Stats get_stats()
+{
+	Stats stats;
+	stats.workers.reserve(worker_threads.size());
+	for (const auto& worker : worker_threads)
+	{
+		const detail::WorkerCounters& counters = worker->get_counters();
+		WorkerStats& worker_stats = stats.workers.emplace_back();
+		worker_stats.jobs_executed = counters.jobs_executed.load(std::memory_order_relaxed);
+		worker_stats.busy_ns = counters.busy_ns.load(std::memory_order_relaxed);
+		worker_stats.idle_ns = counters.idle_ns.load(std::memory_order_relaxed);
+		worker_stats.steal_ns = counters.steal_ns.load(std::memory_order_relaxed);
+		worker_stats.steal_attempts = counters.steal_attempts.load(std::memory_order_relaxed);
+		worker_stats.steal_successes = counters.steal_successes.load(std::memory_order_relaxed);
+		worker_stats.jobs_allocated = counters.jobs_allocated.load(std::memory_order_relaxed);
+		worker_stats.fibers_created = counters.fibers_created.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < worker_stats.max_queue_depths.size(); ++i)
+			worker_stats.max_queue_depths[i] = counters.max_queue_depths[i].load(std::memory_order_relaxed);
+
+		stats.total.jobs_executed += worker_stats.jobs_executed;
+		stats.total.busy_ns += worker_stats.busy_ns;
+		stats.total.idle_ns += worker_stats.idle_ns;
+		stats.total.steal_ns += worker_stats.steal_ns;
+		stats.total.steal_attempts += worker_stats.steal_attempts;
+		stats.total.steal_successes += worker_stats.steal_successes;
+		stats.total.jobs_allocated += worker_stats.jobs_allocated;
+		stats.total.fibers_created += worker_stats.fibers_created;
+		for (size_t i = 0; i < worker_stats.max_queue_depths.size(); ++i)
+			stats.total.max_queue_depths[i] = std::max(stats.total.max_queue_depths[i], worker_stats.max_queue_depths[i]);
+	}
+
+	stats.external_jobs_allocated = detail::get_external_job_allocation_count();
+	stats.io_jobs_executed = get_lane_pool(JobLane::IO).get_jobs_executed();
+	stats.background_jobs_executed = get_lane_pool(JobLane::Background).get_jobs_executed();
+	stats.parking = parker.get_stats();
+	return stats;
+}
+
+void plot_stats()
+{
+#if ZE_FEATURE(PROFILING)
+	/** Tracy keeps plot name pointers, so names are never destroyed nor moved */
+	static std::deque<std::string> busy_plot_names;
+	static std::vector<WorkerStats> previous_workers;
+
+	const Stats stats = get_stats();
+	while (busy_plot_names.size() < stats.workers.size())
+		busy_plot_names.emplace_back(fmt::format("Worker {} busy %", busy_plot_names.size()));
+	previous_workers.resize(stats.workers.size());
+
+	uint64_t executed_jobs = 0;
+	for (size_t i = 0; i < stats.workers.size(); ++i)
+	{
+		const WorkerStats& current = stats.workers[i];
+		const WorkerStats& previous = previous_workers[i];
+		const uint64_t busy_ns = current.busy_ns - previous.busy_ns;
+		const uint64_t total_ns = busy_ns + current.idle_ns - previous.idle_ns;
+		TracyPlot(busy_plot_names[i].c_str(),
+			total_ns > 0 ? 100.0 * static_cast<double>(busy_ns) / static_cast<double>(total_ns) : 0.0);
+		executed_jobs += current.jobs_executed - previous.jobs_executed;
+	}
+
+	TracyPlot("Jobs executed", static_cast<int64_t>(executed_jobs));
+	TracyPlot("Max high priority queue depth", static_cast<int64_t>(stats.total.max_queue_depths[0]));
+	TracyPlot("Max normal priority queue depth", static_cast<int64_t>(stats.total.max_queue_depths[1]));
+	TracyPlot("Max low priority queue depth", static_cast<int64_t>(stats.total.max_queue_depths[2]));
+	previous_workers = stats.workers;
+#endif
+}
+
+ExecutionMode get_execution_mode()
+{
+	return execution_mode;
+}
+
+bool is_worker_thread()
+{
+	return WorkerThread::get_current_worker_idx() != std::numeric_limits<size_t>::max();
+}
+
+bool try_execute_one_job()
+{
+	if (is_worker_thread())
+		return get_worker_by_idx(WorkerThread::get_current_worker_idx()).flush_one();
+
+	/** In fiber mode jobs only run on worker fibers, so they can always be suspended */
+	if (execution_mode == ExecutionMode::Fibers)
+		return false;
+
+	/** Non-worker threads can't touch worker deques bottoms, they can only steal */
+	if (Job* job = WorkerThread::steal_from_any(std::numeric_limits<size_t>::max()))
+	{
+		job->execute();
+		return true;
+	}
+
+	return false;
+}
+
+}
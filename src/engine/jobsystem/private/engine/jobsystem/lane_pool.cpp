@@ -0,0 +1,117 @@
+#include "engine/jobsystem/lane_pool.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/worker_thread.hpp"
+#include "engine/jobsystem/parker.hpp"
+#include "engine/logger/deferred.hpp"
+#include "fmt/format.h"
+#include <chrono>
+#if ZE_FEATURE(PROFILING)
+#include <Tracy.hpp>
+#endif
+
+namespace ze::jobsystem
+{
+
+/**
+ * Longest a job waits for the compute workers before running anyway
+ * Workers blocked on a lane job (e.g Counter::wait on a shader compile) spin instead of parking, so waiting for an
+ * idle worker alone could wait forever
+ */
+static constexpr auto max_compute_yield_time = std::chrono::milliseconds(2);
+
+bool is_compute_saturated()
+{
+	if (has_idle_workers())
+		return false;
+
+	for (size_t i = 0; i < get_worker_count(); ++i)
+		if (get_worker_by_idx(i).has_pending_jobs())
+			return true;
+
+	return false;
+}
+
+LanePool::LanePool(const std::string& in_name,
+	size_t in_thread_count,
+	hal::ThreadPriority in_priority,
+	bool in_yield_to_compute)
+	: name(in_name),
+	priority(in_priority),
+	yield_to_compute(in_yield_to_compute),
+	active(true),
+	jobs_executed(0),
+	pending_jobs(0)
+{
+	threads.reserve(in_thread_count);
+	for (size_t i = 0; i < in_thread_count; ++i)
+		threads.emplace_back([this, i] { run(i); });
+}
+
+LanePool::~LanePool()
+{
+	active = false;
+	if (yield_to_compute)
+		get_parker().notify_idle_waiters();
+	pending_jobs.release(static_cast<std::ptrdiff_t>(threads.size()));
+	for (auto& thread : threads)
+		thread.join();
+}
+
+void LanePool::enqueue(Job* in_job)
+{
+	queues[static_cast<size_t>(in_job->get_priority())].enqueue(in_job);
+	pending_jobs.release();
+}
+
+Job* LanePool::try_dequeue()
+{
+	for (auto& queue : queues)
+	{
+		Job* job = nullptr;
+		if (queue.try_dequeue(job))
+			return job;
+	}
+
+	return nullptr;
+}
+
+void LanePool::run(size_t in_index)
+{
+	const std::string thread_name = fmt::format("{} Thread {}", name, in_index);
+	hal::set_thread_name(std::this_thread::get_id(), thread_name);
+#if ZE_FEATURE(PROFILING)
+	tracy::SetThreadName(thread_name.c_str());
+#endif
+	if (priority != hal::ThreadPriority::Normal && !hal::set_current_thread_priority(priority))
+		ZE_LOG_DEFERRED(Warn, log_jobsystem, "Failed to set {} priority", thread_name);
+
+	while (true)
+	{
+		pending_jobs.acquire();
+
+		/** Sleep until a worker parks, which happens once the compute queues are drained, or until the deadline */
+		if (yield_to_compute)
+		{
+			const auto should_yield = [this]() { return active && is_compute_saturated(); };
+			const auto deadline = std::chrono::steady_clock::now() + max_compute_yield_time;
+			while (should_yield() && get_parker().wait_for_idle_worker(should_yield, deadline)) {}
+		}
+
+		/** Each release matches one job that may not be visible yet, except the ones from the destructor */
+		Job* job = try_dequeue();
+		while (!job && active)
+		{
+			std::this_thread::yield();
+			job = try_dequeue();
+		}
+
+		/** Stopping, jobs still queued are drained first */
+		if (!job)
+			break;
+
+		job->execute();
+		jobs_executed.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+}
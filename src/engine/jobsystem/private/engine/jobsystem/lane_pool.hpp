@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrentqueue/concurrentqueue.h"
+#include "engine/jobsystem/job.hpp"
+#include "engine/hal/thread.hpp"
+
+namespace ze::jobsystem
+{
+
+/**
+ * Threads executing the jobs of a lane other than Compute
+ * The thread count is the lane concurrency limit, jobs are taken by priority then FIFO
+ * Threads sleep on a semaphore released once per enqueued job
+ */
+class LanePool
+{
+	static constexpr size_t priority_count = 3;
+
+public:
+	/**
+	 * \param in_yield_to_compute Don't start jobs while every worker is busy and compute jobs are waiting,
+	 * threads sleep until a worker parks meanwhile (at most max_compute_yield_time per job)
+	 */
+	LanePool(const std::string& in_name,
+		size_t in_thread_count,
+		hal::ThreadPriority in_priority,
+		bool in_yield_to_compute);
+	~LanePool();
+
+	LanePool(const LanePool&) = delete;
+	LanePool& operator=(const LanePool&) = delete;
+
+	/**
+	 * [THREAD SAFE] Queue a job, waking a sleeping thread
+	 */
+	void enqueue(Job* in_job);
+
+	[[nodiscard]] size_t get_thread_count() const { return threads.size(); }
+	[[nodiscard]] uint64_t get_jobs_executed() const { return jobs_executed.load(std::memory_order_relaxed); }
+private:
+	void run(size_t in_index);
+	Job* try_dequeue();
+private:
+	std::string name;
+	hal::ThreadPriority priority;
+	bool yield_to_compute;
+	std::atomic_bool active;
+	std::atomic_uint64_t jobs_executed;
+	std::counting_semaphore<> pending_jobs;
+	std::array<moodycamel::ConcurrentQueue<Job*>, priority_count> queues;
+	std::vector<std::thread> threads;
+};
+
+LanePool& get_lane_pool(JobLane in_lane);
+
+}
@@ -0,0 +1,121 @@
+#include "engine/jobsystem/parker.hpp"
+#include <chrono>
+
+namespace ze::jobsystem
+{
+
+int64_t get_parker_time_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Parker::initialize(const size_t in_worker_count)
+{
+	slots = std::make_unique<Slot[]>(in_worker_count);
+	slot_count = in_worker_count;
+	idle_head = 0;
+}
+
+void Parker::unpark(size_t in_count)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	while (in_count > 0)
+	{
+		const uint32_t worker_idx = pop_idle();
+		if (worker_idx == invalid_idx)
+			return;
+
+		Slot& slot = slots[worker_idx];
+		slot.in_idle_stack.store(false);
+		slot.notify_time_ns.store(get_parker_time_ns(), std::memory_order_relaxed);
+
+		/** The worker may have found work by itself after publishing itself as idle, try the next one */
+		State expected = State::Parked;
+		if (slot.state.compare_exchange_strong(expected, State::Notified))
+		{
+			slot.state.notify_one();
+			in_count--;
+		}
+	}
+}
+
+void Parker::unpark_worker(size_t in_worker_idx)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	/** The worker stays in the idle stack, unpark will skip it as it isn't parked anymore */
+	Slot& slot = slots[in_worker_idx];
+	slot.notify_time_ns.store(get_parker_time_ns(), std::memory_order_relaxed);
+
+	State expected = State::Parked;
+	if (slot.state.compare_exchange_strong(expected, State::Notified))
+		slot.state.notify_one();
+}
+
+void Parker::unpark_all()
+{
+	for (size_t i = 0; i < slot_count; ++i)
+	{
+		slots[i].notify_time_ns.store(get_parker_time_ns(), std::memory_order_relaxed);
+		slots[i].state.store(State::Notified);
+		slots[i].state.notify_one();
+	}
+}
+
+ParkingStats Parker::get_stats() const
+{
+	ParkingStats stats;
+	stats.parks = parks.load(std::memory_order_relaxed);
+	stats.wakeups = wakeups.load(std::memory_order_relaxed);
+	stats.wasted_wakeups = wasted_wakeups.load(std::memory_order_relaxed);
+	stats.total_wakeup_latency_ns = total_wakeup_latency_ns.load(std::memory_order_relaxed);
+	stats.max_wakeup_latency_ns = max_wakeup_latency_ns.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void Parker::push_idle(uint32_t in_worker_idx)
+{
+	uint64_t head = idle_head.load(std::memory_order_relaxed);
+	uint64_t new_head;
+	do
+	{
+		slots[in_worker_idx].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+		new_head = ((head >> 32) + 1) << 32 | (in_worker_idx + 1);
+	} while (!idle_head.compare_exchange_weak(head, new_head));
+}
+
+uint32_t Parker::pop_idle()
+{
+	uint64_t head = idle_head.load();
+	uint64_t new_head;
+	do
+	{
+		const uint32_t top = static_cast<uint32_t>(head);
+		if (top == 0)
+			return invalid_idx;
+
+		const uint32_t next = slots[top - 1].next.load(std::memory_order_relaxed);
+		new_head = ((head >> 32) + 1) << 32 | next;
+	} while (!idle_head.compare_exchange_weak(head, new_head));
+
+	return static_cast<uint32_t>(head) - 1;
+}
+
+void Parker::record_wakeup(const Slot& in_slot)
+{
+	wakeups.fetch_add(1, std::memory_order_relaxed);
+
+	const int64_t latency = get_parker_time_ns() - in_slot.notify_time_ns.load(std::memory_order_relaxed);
+	if (latency <= 0)
+		return;
+
+	total_wakeup_latency_ns.fetch_add(static_cast<uint64_t>(latency), std::memory_order_relaxed);
+
+	uint64_t max_latency = max_wakeup_latency_ns.load(std::memory_order_relaxed);
+	while (static_cast<uint64_t>(latency) > max_latency &&
+		!max_wakeup_latency_ns.compare_exchange_weak(max_latency, static_cast<uint64_t>(latency), std::memory_order_relaxed)) {}
+}
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <limits>
+#include "engine/jobsystem/jobsystem.hpp"
+
+namespace ze::jobsystem
+{
+
+/**
+ * Parks idle workers using std::atomic::wait (futex/WaitOnAddress) and wakes them one by one
+ * Parked workers are tracked in a lock-free (tagged Treiber) idle stack so waking a worker
+ * never touches a mutex and never wakes more workers than requested
+ */
+class Parker
+{
+	enum class State : uint32_t
+	{
+		Running,
+		Parked,
+		Notified,
+	};
+
+	struct alignas(std::hardware_destructive_interference_size) Slot
+	{
+		std::atomic<State> state = State::Running;
+		std::atomic_uint32_t next = 0;
+		std::atomic_bool in_idle_stack = false;
+		std::atomic_int64_t notify_time_ns = 0;
+	};
+
+public:
+	void initialize(const size_t in_worker_count);
+
+	/**
+	 * [WORKER ONLY] Park the calling worker until another thread wakes it
+	 * \param in_should_abort Checked after the worker is published as idle, to not miss jobs enqueued concurrently
+	 * \return true if the worker has been woken up by unpark, false if it didn't sleep
+	 */
+	template<typename ShouldAbortFunc>
+	bool park(const size_t in_worker_idx, ShouldAbortFunc&& in_should_abort)
+	{
+		Slot& slot = slots[in_worker_idx];
+		slot.state.store(State::Parked);
+		if (!slot.in_idle_stack.exchange(true))
+			push_idle(static_cast<uint32_t>(in_worker_idx));
+
+		/** Pairs with the fence in unpark: either we see the new job, or the waker sees us in the idle stack */
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (in_should_abort())
+		{
+			State expected = State::Parked;
+			if (slot.state.compare_exchange_strong(expected, State::Running))
+				return false;
+		}
+		else
+		{
+			parks.fetch_add(1, std::memory_order_relaxed);
+			if (idle_waiters.load(std::memory_order_relaxed) != 0)
+				notify_idle_waiters();
+
+			while (slot.state.load() == State::Parked)
+				slot.state.wait(State::Parked);
+		}
+
+		/** Someone notified us */
+		record_wakeup(slot);
+		slot.state.store(State::Running);
+		return true;
+	}
+
+	/**
+	 * [THREAD SAFE] Wake up to in_count parked workers
+	 */
+	void unpark(size_t in_count);
+
+	/**
+	 * [THREAD SAFE] Wake a specific worker if it is parked
+	 */
+	void unpark_worker(size_t in_worker_idx);
+
+	/**
+	 * Wake every worker regardless of their state, used for shutdown
+	 */
+	void unpark_all();
+
+	/**
+	 * [THREAD SAFE] Sleep until a worker parks or in_deadline is reached, if in_condition still holds once the
+	 * calling thread is registered
+	 * Used by lane threads yielding to saturated workers: workers park once the compute queues are drained
+	 * \return false if the deadline has been reached
+	 */
+	template<typename ConditionFunc>
+	bool wait_for_idle_worker(ConditionFunc&& in_condition, const std::chrono::steady_clock::time_point& in_deadline)
+	{
+		std::unique_lock lock(idle_mutex);
+		idle_waiters.fetch_add(1);
+
+		/** Pairs with the fence in park: either we see the worker in the idle stack, or it sees us waiting */
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const uint32_t epoch = idle_epoch.load();
+		const bool woken = idle_condition.wait_until(lock, in_deadline, [&]()
+		{
+			return idle_epoch.load() != epoch || !in_condition();
+		});
+
+		idle_waiters.fetch_sub(1);
+		return woken;
+	}
+
+	/**
+	 * [THREAD SAFE] Wake every thread in wait_for_idle_worker
+	 */
+	void notify_idle_waiters()
+	{
+		{
+			std::scoped_lock lock(idle_mutex);
+			idle_epoch.fetch_add(1);
+		}
+		idle_condition.notify_all();
+	}
+
+	[[nodiscard]] bool has_idle_workers() const { return static_cast<uint32_t>(idle_head.load(std::memory_order_relaxed)) != 0; }
+
+	void record_wasted_wakeup() { wasted_wakeups.fetch_add(1, std::memory_order_relaxed); }
+
+	[[nodiscard]] ParkingStats get_stats() const;
+private:
+	void push_idle(uint32_t in_worker_idx);
+	[[nodiscard]] uint32_t pop_idle();
+	void record_wakeup(const Slot& in_slot);
+
+	static constexpr uint32_t invalid_idx = std::numeric_limits<uint32_t>::max();
+private:
+	std::unique_ptr<Slot[]> slots;
+	size_t slot_count = 0;
+
+	/** Low 32 bits: top worker index + 1 (0 = empty), high 32 bits: ABA tag */
+	alignas(std::hardware_destructive_interference_size) std::atomic_uint64_t idle_head = 0;
+
+	alignas(std::hardware_destructive_interference_size) std::atomic_uint64_t parks = 0;
+	std::atomic_uint64_t wakeups = 0;
+	std::atomic_uint64_t wasted_wakeups = 0;
+	std::atomic_uint64_t total_wakeup_latency_ns = 0;
+	std::atomic_uint64_t max_wakeup_latency_ns = 0;
+
+	/** Incremented each time a worker parks while threads wait for an idle worker */
+	alignas(std::hardware_destructive_interference_size) std::atomic_uint32_t idle_epoch = 0;
+	std::atomic_uint32_t idle_waiters = 0;
+	std::mutex idle_mutex;
+	std::condition_variable idle_condition;
+};
+
+Parker& get_parker();
+
+}
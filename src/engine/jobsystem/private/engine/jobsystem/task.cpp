@@ -0,0 +1,139 @@
+#include "engine/jobsystem/task.hpp"
+#include "engine/hal/thread.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#if ZE_FEATURE(PROFILING)
+#include <Tracy.hpp>
+#endif
+
+namespace ze::jobsystem::detail
+{
+
+struct ResumeJobData
+{
+	void* address;
+};
+
+void resume_coroutine_job(Job& in_job)
+{
+	std::coroutine_handle<>::from_address(in_job.get_userdata<ResumeJobData>()->address).resume();
+}
+
+void schedule_coroutine(std::coroutine_handle<> in_handle, const JobPriority in_priority, const JobLane in_lane)
+{
+	Job* job = new_job<ResumeJobData>(&resume_coroutine_job, JobType::Normal, in_priority, in_handle.address());
+	job->set_lane(in_lane);
+	job->schedule();
+}
+
+void CounterAwaiter::await_suspend(std::coroutine_handle<> in_handle) const
+{
+	Job* job = new_job<ResumeJobData>(&resume_coroutine_job, JobType::Normal, priority, in_handle.address());
+	job->depends_on(counter);
+	job->schedule();
+}
+
+namespace
+{
+
+/** Delay between two polls, doubled each time no entry was ready */
+constexpr std::chrono::microseconds min_poll_backoff(50);
+constexpr std::chrono::microseconds max_poll_backoff(2000);
+
+struct PollState
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::vector<PollEntry*> entries;
+
+	/** Set when entries are added, so they are polled without waiting for the backoff */
+	bool has_new_entries = false;
+	bool active = false;
+	std::thread thread;
+};
+
+PollState poll_state;
+
+/**
+ * Entries are polled from a dedicated thread rather than a lane job, sleeping between polls would hold a lane thread
+ * (e.g the only background thread, also compiling shaders)
+ */
+void run_poll_thread()
+{
+	hal::set_thread_name(std::this_thread::get_id(), "Poll Thread");
+#if ZE_FEATURE(PROFILING)
+	tracy::SetThreadName("Poll Thread");
+#endif
+
+	std::vector<PollEntry*> entries;
+	std::chrono::microseconds backoff = min_poll_backoff;
+	std::unique_lock lock(poll_state.mutex);
+	while (poll_state.active)
+	{
+		if (poll_state.entries.empty())
+		{
+			poll_state.condition.wait(lock, []() { return !poll_state.active || !poll_state.entries.empty(); });
+			backoff = min_poll_backoff;
+			continue;
+		}
+
+		entries.swap(poll_state.entries);
+		poll_state.has_new_entries = false;
+		lock.unlock();
+
+		/** Polled without the lock as checking an entry may be slow, a resumed coroutine may destroy its entry */
+		const size_t entry_count = entries.size();
+		std::erase_if(entries, [](PollEntry* in_entry)
+		{
+			if (!in_entry->poll(*in_entry))
+				return false;
+
+			schedule_coroutine(in_entry->handle);
+			return true;
+		});
+
+		lock.lock();
+		const bool progressed = entries.size() != entry_count;
+		poll_state.entries.insert(poll_state.entries.end(), entries.begin(), entries.end());
+		entries.clear();
+
+		backoff = progressed ? min_poll_backoff : std::min(backoff * 2, max_poll_backoff);
+		poll_state.condition.wait_for(lock, backoff, []() { return !poll_state.active || poll_state.has_new_entries; });
+	}
+}
+
+}
+
+void add_poll_entry(PollEntry& in_entry)
+{
+	{
+		std::scoped_lock lock(poll_state.mutex);
+		poll_state.entries.emplace_back(&in_entry);
+		poll_state.has_new_entries = true;
+	}
+	poll_state.condition.notify_one();
+}
+
+void start_poll_thread()
+{
+	std::scoped_lock lock(poll_state.mutex);
+	poll_state.active = true;
+	poll_state.thread = std::thread(&run_poll_thread);
+}
+
+void stop_poll_thread()
+{
+	{
+		std::scoped_lock lock(poll_state.mutex);
+		poll_state.active = false;
+	}
+	poll_state.condition.notify_one();
+
+	if (poll_state.thread.joinable())
+		poll_state.thread.join();
+}
+
+}
@@ -1,10 +1,14 @@
 #include "engine/jobsystem/worker_thread.hpp"
 #include "engine/jobsystem/job.hpp"
 #include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/parker.hpp"
 #include "engine/hal/thread.hpp"
-#include <random>
+#include "engine/hal/fiber.hpp"
 #include "fmt/format.h"
 #include "engine/random.hpp"
+#include "engine/profiling/profiler.hpp"
+#include "engine/logger/deferred.hpp"
+#include <chrono>
 #if ZE_FEATURE(PROFILING)
 #include <Tracy.hpp>
 #endif
@@ -12,102 +16,470 @@
 namespace ze::jobsystem
 {
 
-WorkerThread::WorkerThread(size_t in_index)
+/**
+ * Per-thread xorshift64* RNG used to pick the first steal victim
+ * Avoids sharing random_SM64's global seed between every thief
+ */
+thread_local uint64_t steal_rng_state = 0;
+
+/** Power of two */
+static constexpr uint32_t inbox_depth_sample_rate = 64;
+
+/** Power of two */
+static constexpr uint32_t steal_time_sample_rate = 64;
+
+size_t next_steal_random()
+{
+	if (steal_rng_state == 0)
+		steal_rng_state = ze::detail::random_SM64() | 1;
+
+	steal_rng_state ^= steal_rng_state >> 12;
+	steal_rng_state ^= steal_rng_state << 25;
+	steal_rng_state ^= steal_rng_state >> 27;
+	return static_cast<size_t>(steal_rng_state * UINT64_C(0x2545F4914F6CDD1D));
+}
+
+namespace detail
+{
+
+void resume_fiber(FiberContext* in_fiber)
+{
+	in_fiber->worker->resume(in_fiber);
+}
+
+bool suspend_current_fiber(Counter& in_counter)
+{
+	if (!is_worker_thread())
+		return false;
+
+	return get_worker_by_idx(WorkerThread::get_current_worker_idx()).suspend_current_fiber(in_counter);
+}
+
+/** Workers with busy_waiting set, so finishing jobs only scan workers when one is waiting */
+std::atomic_uint32_t busy_waiting_worker_count = 0;
+
+void wake_busy_waiting_workers()
+{
+	/** Pairs with the fence in set_busy_waiting: either we see the worker waiting, or its fibers see the job done */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (busy_waiting_worker_count.load(std::memory_order_relaxed) == 0)
+		return;
+
+	for (size_t i = 0; i < get_worker_count(); ++i)
+		get_worker_by_idx(i).wake_if_busy_waiting();
+}
+
+}
+
+WorkerThread::WorkerThread(size_t in_index,
+	uint64_t in_affinity,
+	hal::ThreadPriority in_priority,
+	size_t in_fiber_stack_size)
 	: index(in_index),
+	affinity(in_affinity),
+	priority(in_priority),
+	fiber_stack_size(in_fiber_stack_size),
 	active(true),
-	thread([&] { run(); })
+	scheduler_fiber(nullptr),
+	current_fiber(nullptr),
+	pending_action(FiberAction::None),
+	waiting_counter(nullptr),
+	busy_waiting(false),
+	yielded_fibers_to_check(0)
 {
-	for(size_t i = 0; i < std::thread::hardware_concurrency(); ++i)
-	{
-		high_consumer_tokens.emplace_back(high_job_queue);
-		normal_consumer_tokens.emplace_back(normal_job_queue);
-		low_consumer_tokens.emplace_back(low_job_queue);
-	}
+	/** Start the thread last so every queue is constructed before it runs */
+	thread = std::thread([this] { run(); });
 }
 
 WorkerThread::~WorkerThread()
 {
-	active = false;
-	thread.detach();
+	/** request_stop and Parker::unpark_all must have been called before */
+	if (thread.joinable())
+		thread.join();
 }
 
 void WorkerThread::run()
 {
 	current_worker_idx = index;
-	hal::set_thread_name(thread.get_id(), fmt::format("Worker Thread {}", index));
+	hal::set_thread_name(std::this_thread::get_id(), fmt::format("Worker Thread {}", index));
+	if (affinity != 0 && !hal::set_current_thread_affinity(affinity))
+		ZE_LOG_DEFERRED(Warn, log_jobsystem, "Failed to set worker {} affinity to {:#x}", index, affinity);
+
+	if (priority != hal::ThreadPriority::Normal && !hal::set_current_thread_priority(priority))
+		ZE_LOG_DEFERRED(Warn, log_jobsystem, "Failed to set worker {} priority", index);
+
 #if ZE_FEATURE(PROFILING)
 	tracy::SetThreadName(fmt::format("Worker Thread {}", index).c_str());
 #endif
 
+	if (get_execution_mode() == ExecutionMode::Fibers)
+	{
+		scheduler_fiber = hal::convert_thread_to_fiber();
+		for (size_t i = 0; i < initial_fiber_count; ++i)
+			free_fibers.emplace_back(create_fiber());
+	}
+
+	bool woken_up = false;
+	auto last_time = std::chrono::steady_clock::now();
 	while (active)
 	{
-		if (!flush_one())
+		if (flush_one())
 		{
-			std::unique_lock lock(sleep_mutex);
-			global_sleep_var.wait(lock);
+			woken_up = false;
+			continue;
 		}
+
+		/** The clock is only read when switching between busy and idle, not per job */
+		const auto busy_end_time = std::chrono::steady_clock::now();
+		detail::add_to_counter(counters.busy_ns,
+			std::chrono::duration_cast<std::chrono::nanoseconds>(busy_end_time - last_time).count());
+		last_time = busy_end_time;
+
+		if (woken_up)
+			get_parker().record_wasted_wakeup();
+
+		woken_up = get_parker().park(index, [this]()
+		{
+			if (!active)
+				return true;
+
+			for (size_t i = 0; i < get_worker_count(); ++i)
+				if (get_worker_by_idx(i).has_pending_jobs())
+					return true;
+
+			/** A job finished since our yielded fibers were last resumed */
+			return !yielded_fibers.empty() && !busy_waiting.load();
+		});
+
+		const auto park_end_time = std::chrono::steady_clock::now();
+		detail::add_to_counter(counters.idle_ns,
+			std::chrono::duration_cast<std::chrono::nanoseconds>(park_end_time - last_time).count());
+		last_time = park_end_time;
+	}
+
+	if (scheduler_fiber)
+	{
+		for (const auto& fiber : fibers)
+			hal::destroy_fiber(fiber->fiber);
+
+		fibers.clear();
+		free_fibers.clear();
+		yielded_fibers.clear();
+		hal::convert_fiber_to_thread(scheduler_fiber);
+		scheduler_fiber = nullptr;
 	}
 }
 
 bool WorkerThread::flush_one()
 {
-	if (Job* job = const_cast<Job*>(try_get_or_steal_job()))
+	if (scheduler_fiber)
+	{
+		/** A job is waiting for something, yield its fiber instead of nesting another job on its stack */
+		if (current_fiber)
+		{
+			switch_to_scheduler(FiberAction::Yield);
+			return true;
+		}
+
+		return schedule_fiber();
+	}
+
+	if (Job* job = try_get_or_steal_job())
+	{
+		execute(job);
+		return true;
+	}
+
+	return false;
+}
+
+void WorkerThread::execute(Job* in_job)
+{
+	ZE_PROFILE_SCOPE("Job");
+	detail::add_to_counter(counters.jobs_executed, 1);
+	in_job->execute();
+}
+
+bool WorkerThread::schedule_fiber()
+{
+	/** Fibers whose counter reached zero first, then new jobs, then fibers that are busy-waiting */
+	detail::FiberContext* fiber = nullptr;
+	if (ready_fibers.try_dequeue(fiber))
 	{
-		job->execute();
+		clear_busy_waiting();
+		switch_to_fiber(fiber);
+		return true;
+	}
+
+	if (Job* job = try_get_or_steal_job())
+	{
+		clear_busy_waiting();
+		fiber = acquire_fiber();
+		fiber->job = job;
+		switch_to_fiber(fiber);
+		return true;
+	}
+
+	if (!yielded_fibers.empty())
+	{
+		/**
+		 * Yielded fibers wait for other jobs to finish, resuming them in a loop would keep the worker from parking
+		 * Once each of them has been resumed since the worker was published as busy-waiting, it parks instead
+		 */
+		if (yielded_fibers_to_check == 0)
+		{
+			if (busy_waiting.load(std::memory_order_relaxed))
+				return false;
+
+			set_busy_waiting();
+			yielded_fibers_to_check = yielded_fibers.size();
+		}
+
+		--yielded_fibers_to_check;
+		fiber = yielded_fibers.front();
+		yielded_fibers.pop_front();
+		switch_to_fiber(fiber);
 		return true;
 	}
 
 	return false;
 }
 
-void WorkerThread::enqueue(const Job* job)
+void WorkerThread::set_busy_waiting()
+{
+	if (!busy_waiting.exchange(true))
+		detail::busy_waiting_worker_count.fetch_add(1);
+
+	/** Pairs with the fence in wake_busy_waiting_workers */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void WorkerThread::clear_busy_waiting()
+{
+	yielded_fibers_to_check = 0;
+	if (busy_waiting.load(std::memory_order_relaxed) && busy_waiting.exchange(false))
+		detail::busy_waiting_worker_count.fetch_sub(1);
+}
+
+bool WorkerThread::wake_if_busy_waiting()
 {
-	switch(job->get_priority())
+	if (!busy_waiting.load(std::memory_order_relaxed) || !busy_waiting.exchange(false))
+		return false;
+
+	detail::busy_waiting_worker_count.fetch_sub(1);
+	get_parker().unpark_worker(index);
+	return true;
+}
+
+detail::FiberContext* WorkerThread::create_fiber()
+{
+	auto& context = fibers.emplace_back(std::make_unique<detail::FiberContext>());
+	context->worker = this;
+	context->fiber = hal::create_fiber(fiber_stack_size, &WorkerThread::fiber_main, context.get());
+	detail::add_to_counter(counters.fibers_created, 1);
+	return context.get();
+}
+
+detail::FiberContext* WorkerThread::acquire_fiber()
+{
+	if (free_fibers.empty())
+		return create_fiber();
+
+	detail::FiberContext* fiber = free_fibers.back();
+	free_fibers.pop_back();
+	return fiber;
+}
+
+void WorkerThread::switch_to_fiber(detail::FiberContext* in_fiber)
+{
+	current_fiber = in_fiber;
+	hal::switch_to_fiber(scheduler_fiber, in_fiber->fiber);
+	current_fiber = nullptr;
+
+	/** The fiber is not running anymore, it can now be handed to other threads */
+	const FiberAction action = pending_action;
+	pending_action = FiberAction::None;
+	switch (action)
 	{
-	case JobPriority::High:
-		high_job_queue.enqueue(job);
+	case FiberAction::Recycle:
+		free_fibers.emplace_back(in_fiber);
+		break;
+	case FiberAction::Wait:
+		if (!waiting_counter->add_waiter(in_fiber))
+			ready_fibers.enqueue(in_fiber);
+		waiting_counter = nullptr;
 		break;
-	case JobPriority::Normal:
-		normal_job_queue.enqueue(job);
+	case FiberAction::Yield:
+		yielded_fibers.emplace_back(in_fiber);
 		break;
-	case JobPriority::Low:
-		low_job_queue.enqueue(job);
+	case FiberAction::None:
 		break;
 	}
 }
 
-const Job* WorkerThread::try_get_or_steal_job()
+void WorkerThread::switch_to_scheduler(const FiberAction in_action)
+{
+	pending_action = in_action;
+	hal::switch_to_fiber(current_fiber->fiber, scheduler_fiber);
+}
+
+void WorkerThread::fiber_main(void* in_userdata)
 {
-	const Job* job = nullptr;
-	if(!try_dequeue(job))
+	detail::FiberContext* context = static_cast<detail::FiberContext*>(in_userdata);
+	while (true)
 	{
-		const auto worker_idx = random_SM64<size_t>(0, get_worker_count() - 1);
-		auto& worker_to_steal = get_worker_by_idx(worker_idx);
+		context->worker->execute(context->job);
+		context->job = nullptr;
+		context->worker->switch_to_scheduler(FiberAction::Recycle);
+	}
+}
 
-		if (this != &worker_to_steal)
-		{
-			const Job* stolen_job = nullptr;
-			if(worker_to_steal.try_dequeue(stolen_job))
-				return stolen_job;
-		}
+void WorkerThread::resume(detail::FiberContext* in_fiber)
+{
+	ready_fibers.enqueue(in_fiber);
+	get_parker().unpark_worker(index);
+}
+
+bool WorkerThread::suspend_current_fiber(Counter& in_counter)
+{
+	if (!scheduler_fiber || !current_fiber)
+		return false;
+
+	waiting_counter = &in_counter;
+	switch_to_scheduler(FiberAction::Wait);
+	return true;
+}
 
-		std::this_thread::yield();
+void WorkerThread::enqueue(Job* job)
+{
+	const size_t priority = static_cast<size_t>(job->get_priority());
+	if (current_worker_idx == index)
+	{
+		deques[priority].push(job);
+		detail::update_max_counter(counters.max_queue_depths[priority], deques[priority].get_size());
+	}
+	else
+	{
+		inboxes[priority].enqueue(job);
+
+		/** size_approx visits every producer, so inbox depths are only sampled */
+		thread_local uint32_t inbox_enqueue_count = 0;
+		if ((++inbox_enqueue_count & (inbox_depth_sample_rate - 1)) == 0)
+			detail::update_max_counter(counters.max_queue_depths[priority], inboxes[priority].size_approx());
+	}
+}
+
+void WorkerThread::enqueue_bulk(Job* const* in_jobs, size_t in_count)
+{
+	if (in_count == 0)
+		return;
+
+	const size_t priority = static_cast<size_t>(in_jobs[0]->get_priority());
+	if (current_worker_idx == index)
+	{
+		for (size_t i = 0; i < in_count; ++i)
+			deques[priority].push(in_jobs[i]);
+
+		detail::update_max_counter(counters.max_queue_depths[priority], deques[priority].get_size());
+	}
+	else
+	{
+		inboxes[priority].enqueue_bulk(in_jobs, in_count);
+		detail::update_max_counter(counters.max_queue_depths[priority], inboxes[priority].size_approx());
+	}
+}
+
+Job* WorkerThread::steal()
+{
+	for (size_t i = 0; i < priority_count; ++i)
+	{
+		if (auto job = deques[i].steal())
+			return *job;
+
+		Job* job = nullptr;
+		if (inboxes[i].try_dequeue(job))
+			return job;
+	}
+
+	return nullptr;
+}
+
+bool WorkerThread::has_pending_jobs() const
+{
+	for (size_t i = 0; i < priority_count; ++i)
+	{
+		if (!deques[i].is_empty() || inboxes[i].size_approx() > 0)
+			return true;
+	}
+
+	return ready_fibers.size_approx() > 0;
+}
+
+Job* WorkerThread::steal_from_any(size_t in_thief_idx)
+{
+	const size_t worker_count = get_worker_count();
+	if (worker_count == 0)
 		return nullptr;
+
+	/** Only workers have counters */
+	const bool is_worker_thief = in_thief_idx < worker_count;
+
+	/** Reading the clock costs about as much as a failed sweep, so only one sweep in steal_time_sample_rate is timed */
+	thread_local uint32_t steal_sweep_count = 0;
+	const bool is_timed = is_worker_thief && (++steal_sweep_count & (steal_time_sample_rate - 1)) == 0;
+	const auto start_time = is_timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+	uint64_t attempts = 0;
+	Job* job = nullptr;
+
+	/** Visit every other worker once, round-robin from a random start */
+	const size_t start = next_steal_random() % worker_count;
+	for (size_t i = 0; i < worker_count && !job; ++i)
+	{
+		const size_t victim_idx = (start + i) % worker_count;
+		if (victim_idx == in_thief_idx)
+			continue;
+
+		++attempts;
+		job = get_worker_by_idx(victim_idx).steal();
+	}
+
+	if (is_worker_thief)
+	{
+		detail::WorkerCounters& thief_counters = get_worker_by_idx(in_thief_idx).counters;
+		detail::add_to_counter(thief_counters.steal_attempts, attempts);
+		detail::add_to_counter(thief_counters.steal_successes, job ? 1 : 0);
+		if (is_timed)
+		{
+			detail::add_to_counter(thief_counters.steal_ns, steal_time_sample_rate *
+				std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count());
+		}
 	}
 
 	return job;
 }
 
-bool WorkerThread::try_dequeue(const Job*& job)
+Job* WorkerThread::try_get_or_steal_job()
 {
-	if (high_job_queue.try_dequeue(high_consumer_tokens[index], job))
-		return true;
+	Job* job = nullptr;
+	if (try_dequeue(job))
+		return job;
 
-	if (normal_job_queue.try_dequeue(normal_consumer_tokens[index], job))
-		return true;
+	return steal_from_any(index);
+}
 
-	if (low_job_queue.try_dequeue(low_consumer_tokens[index], job))
-		return true;
+bool WorkerThread::try_dequeue(Job*& job)
+{
+	for (size_t i = 0; i < priority_count; ++i)
+	{
+		if (auto popped_job = deques[i].pop())
+		{
+			job = *popped_job;
+			return true;
+		}
+
+		if (inboxes[i].try_dequeue(job))
+			return true;
+	}
 
 	return false;
 }
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <semaphore>
+
+namespace ze::jobsystem
+{
+
+class Job;
+
+namespace detail
+{
+
+struct FiberContext;
+
+/** Either a job to release, a suspended fiber to resume or a sleeping thread to wake */
+struct SuccessorNode
+{
+	Job* job;
+	FiberContext* fiber;
+	std::binary_semaphore* semaphore;
+	SuccessorNode* next;
+};
+
+/**
+ * Lock-free list of jobs waiting for something to complete (a job or a counter)
+ * Once closed, successors are released and new successors don't need to wait anymore
+ */
+class SuccessorList
+{
+public:
+	SuccessorList(const bool in_closed = false) : head(in_closed ? get_closed_marker() : nullptr) {}
+
+	/**
+	 * [THREAD SAFE] Add a successor
+	 * \return false if the list is already closed, in_job doesn't need to wait
+	 */
+	bool push(Job* in_job);
+
+	/**
+	 * [THREAD SAFE] Add a suspended fiber, resumed when the list is closed
+	 * \return false if the list is already closed, in_fiber doesn't need to wait
+	 */
+	bool push(FiberContext* in_fiber);
+
+	/**
+	 * [THREAD SAFE] Add a sleeping thread, in_semaphore is released when the list is closed
+	 * \return false if the list is already closed, the thread doesn't need to wait
+	 */
+	bool push(std::binary_semaphore* in_semaphore);
+
+	/**
+	 * [THREAD SAFE] Close the list and release a dependency of every successor
+	 */
+	void close_and_release() { release(close()); }
+
+	/**
+	 * [THREAD SAFE] Close the list without releasing its successors yet
+	 * \return The successors to pass to release
+	 */
+	[[nodiscard]] SuccessorNode* close();
+
+	/**
+	 * Release a dependency of every successor returned by close
+	 */
+	static void release(SuccessorNode* in_nodes);
+
+	/**
+	 * Reopen a closed list so it can accept successors again
+	 */
+	void reopen();
+
+	[[nodiscard]] bool is_closed() const { return head.load(std::memory_order_acquire) == get_closed_marker(); }
+private:
+	bool push_node(SuccessorNode* in_node);
+
+	static SuccessorNode* get_closed_marker() { return reinterpret_cast<SuccessorNode*>(uintptr_t(1)); }
+private:
+	std::atomic<SuccessorNode*> head;
+};
+
+}
+
+/**
+ * Atomic counter that jobs can signal on completion and wait for
+ * Jobs depending on a counter are scheduled once it reaches zero
+ * Reaching zero and leaving it again are done under a transition bit so the successor list is closed and reopened
+ * atomically with the value: a counter can be incremented while it concurrently reaches zero (e.g a reused JobGroup)
+ */
+class Counter
+{
+public:
+	explicit Counter(const uint32_t in_value = 0) : value(in_value), successors(in_value == 0) {}
+
+	Counter(const Counter&) = delete;
+	Counter& operator=(const Counter&) = delete;
+
+	/**
+	 * [THREAD SAFE] Increment the counter, reopening it to successors if it was zero
+	 */
+	void increment(const uint32_t in_count = 1);
+
+	/**
+	 * Decrement the counter, releasing jobs waiting for it when reaching zero
+	 */
+	void decrement();
+
+	/**
+	 * Make in_job wait for this counter to reach zero
+	 * \return false if the counter is already zero
+	 */
+	bool add_successor(Job* in_job);
+
+	/**
+	 * Resume in_fiber once this counter reaches zero
+	 * \return false if the counter is already zero
+	 */
+	bool add_waiter(detail::FiberContext* in_fiber);
+
+	/**
+	 * Wait for the counter to reach zero
+	 * Jobs running on a fiber are suspended until then
+	 * Other threads execute jobs in the meantime, or sleep in fiber mode
+	 */
+	void wait();
+
+	/** Zero once the successors have been released, a counter in transition is not zero yet */
+	[[nodiscard]] bool is_zero() const { return value.load(std::memory_order_acquire) == 0; }
+	[[nodiscard]] uint32_t get_value() const { return value.load(std::memory_order_relaxed) & ~transition_bit; }
+private:
+	/** Set while the successor list is being closed or reopened, other increments wait for it */
+	static constexpr uint32_t transition_bit = 1U << 31;
+
+	/**
+	 * Called when the list was found closed: wait for a decrement closing it to publish zero,
+	 * so the caller can't destroy the counter while the decrement still uses it
+	 */
+	void wait_for_transition() const;
+
+	std::atomic_uint32_t value;
+	detail::SuccessorList successors;
+};
+
+}
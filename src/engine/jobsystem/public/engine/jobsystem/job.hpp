@@ -4,7 +4,9 @@
 #include <array>
 #include <memory>
 #include <type_traits>
-#include "engine/util/simple_pool.hpp"
+#include <new>
+#include <span>
+#include "counter.hpp"
 
 namespace ze::jobsystem
 {
@@ -34,6 +36,23 @@ enum class JobPriority
 	Low,
 };
 
+/**
+ * Threads a job runs on
+ */
+enum class JobLane
+{
+	/** Short, frame-critical jobs executed by the workers */
+	Compute,
+
+	/** Jobs blocking on I/O, executed by a small dedicated pool */
+	IO,
+
+	/** Long-running jobs (shader compilation, asset decoding...), executed by low priority threads yielding to compute work */
+	Background,
+};
+
+static constexpr size_t job_lane_count = 3;
+
 #pragma warning(disable: 4324)
 
 /**
@@ -45,23 +64,22 @@ class alignas(job_alignement) Job
 public:
 	using Function = void(*)(Job& job);
 	static constexpr size_t userdata_size = 128;
-	static constexpr size_t max_continuations = 16;
 	static constexpr size_t max_childs = 255;
 
 	Job(Function in_function, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
-		: type(in_type), parent(nullptr), function(in_function), priority(in_priority), unfinished_jobs(1) {}
+		: type(in_type), parent(nullptr), function(in_function), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr) {}
 
 	template<typename UserDataType, typename... UserDataArgs>
 		requires (std::is_standard_layout_v<UserDataType> && sizeof(UserDataType) <= userdata_size)
 	Job(Function in_function, JobType in_type, const JobPriority in_priority = JobPriority::Normal, UserDataArgs&&... in_args)
-		: type(in_type), parent(nullptr), function(in_function), priority(in_priority), unfinished_jobs(1)
+		: type(in_type), parent(nullptr), function(in_function), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr)
 	{
 		new (get_userdata<UserDataType>()) UserDataType(std::forward<UserDataArgs>(in_args)...);
 	}
 
 	template<typename Lambda>
 	Job(Lambda in_lambda, JobType in_type, const JobPriority in_priority) :
-		type(in_type), parent(nullptr), function(nullptr), priority(in_priority), unfinished_jobs(1)
+		type(in_type), parent(nullptr), function(nullptr), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr)
 	{
 		function = [](Job& job)
 		{
@@ -74,7 +92,7 @@ public:
 
 	/** Child jobs ctor */
 	Job(Function in_function, Job* in_parent, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
-		: type(in_type), parent(in_parent), function(in_function), priority(in_priority), unfinished_jobs(1)
+		: type(in_type), parent(in_parent), function(in_function), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr)
 	{
 		++in_parent->unfinished_jobs;
 	}
@@ -82,7 +100,7 @@ public:
 	template<typename UserDataType, typename... UserDataArgs>
 		requires (std::is_standard_layout_v<UserDataType> && sizeof(UserDataType) <= userdata_size)
 	Job(Function in_function, Job* in_parent, JobType in_type, const JobPriority in_priority = JobPriority::Normal, UserDataArgs&&... in_args)
-		: type(in_type), parent(in_parent), function(in_function), priority(in_priority), unfinished_jobs(1)
+		: type(in_type), parent(in_parent), function(in_function), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr)
 	{
 		++in_parent->unfinished_jobs;
 		new (get_userdata<UserDataType>()) UserDataType(std::forward<UserDataArgs>(in_args)...);
@@ -90,7 +108,7 @@ public:
 
 	template<typename Lambda>
 	Job(Lambda in_lambda, Job* in_parent, JobType in_type, const JobPriority in_priority) :
-		type(in_type), parent(in_parent), function(nullptr), priority(in_priority), unfinished_jobs(1)
+		type(in_type), parent(in_parent), function(nullptr), priority(in_priority), unfinished_jobs(1), pending_dependencies(1), counter(nullptr)
 	{
 		++in_parent->unfinished_jobs;
 		function = [](Job& job)
@@ -103,9 +121,53 @@ public:
 	}
 public:
 	void execute();
+
+	/**
+	 * Release the job, it will be enqueued (or directly executed if lightweight) once all of its dependencies finished
+	 */
 	void schedule();
-	void continuate(Job* continuation);
-	void wait() const;
+
+	/**
+	 * Schedule many jobs at once
+	 * Ready compute jobs are split in contiguous chunks, one per worker, each pushed with a single bulk enqueue,
+	 * then the needed number of sleeping workers is woken up once
+	 * Jobs must not be accessed after this since they may already be freed
+	 */
+	static void schedule_bulk(std::span<Job*> in_jobs);
+
+	/**
+	 * Run in_continuation once this job and its childs finished
+	 */
+	void continuate(Job* in_continuation) { in_continuation->depends_on(*this); }
+
+	/**
+	 * Don't run this job before in_predecessor (and its childs) finished
+	 * Must be called before this job and in_predecessor are scheduled
+	 */
+	void depends_on(Job& in_predecessor);
+
+	/**
+	 * Don't run this job before in_counter reaches zero
+	 * Must be called before this job is scheduled
+	 */
+	void depends_on(Counter& in_counter);
+
+	/**
+	 * Increment in_counter now and decrement it once this job (and its childs) finished
+	 * Must be called before this job is scheduled
+	 */
+	void signal_on_finish(Counter& in_counter);
+
+	/**
+	 * Run this job on another lane, must be called before the job is scheduled
+	 * Lightweight jobs on a lane other than Compute are still enqueued
+	 */
+	void set_lane(const JobLane in_lane) { lane = in_lane; }
+
+	/**
+	 * Called when a predecessor finished, schedule the job when no dependencies are left
+	 */
+	void release_dependency();
 
 	template<typename T>
 	[[nodiscard]] const T* get_userdata() const
@@ -113,22 +175,32 @@ public:
 		return reinterpret_cast<const T*>(userdata.data());
 	}
 
+	template<typename T>
+	[[nodiscard]] T* get_userdata()
+	{
+		return reinterpret_cast<T*>(userdata.data());
+	}
+
 	JobPriority get_priority() const { return priority; }
-	bool is_finished() const { return unfinished_jobs == 0; }
-	bool is_running() const { return unfinished_jobs > 0; }
+	JobLane get_lane() const { return lane; }
 private:
+	[[nodiscard]] bool release_dependency_no_submit();
+	void submit();
 	void finish();
 private:
 	JobType type;
 	Job* parent;
 	Function function;
 	JobPriority priority;
+	JobLane lane = JobLane::Compute;
 
 	/** Unfinished job counts, accounting for childs. 0 = finished, 1 = not finished, > 1 not finished + childs not finished */
 	std::atomic_uint8_t unfinished_jobs;
-	std::atomic_uint8_t dependance_count;
-	std::atomic_uint8_t continuation_count;
-	std::array<Job*, max_continuations> continuations;
+
+	/** Predecessors that didn't finish yet, plus one released by schedule() */
+	std::atomic_uint32_t pending_dependencies;
+	Counter* counter;
+	detail::SuccessorList successors;
 	std::array<uint8_t, userdata_size> userdata;
 };
 
@@ -137,14 +209,29 @@ private:
 namespace detail
 {
 
-using JobPool = SimplePool<Job, 256, true>;
-JobPool& get_job_pool();
+/**
+ * Jobs are allocated from the calling thread's arena and can be freed from any thread
+ */
+void* allocate_job_memory();
+void free_job_memory(void* in_ptr);
+
+template<typename... Args>
+Job* allocate_job(Args&&... in_args)
+{
+	return new (allocate_job_memory()) Job(std::forward<Args>(in_args)...);
+}
+
+inline void free_job(Job* in_job)
+{
+	in_job->~Job();
+	free_job_memory(in_job);
+}
 
 }
 
 inline Job* new_job(Job::Function in_function, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
 {
-	return detail::get_job_pool().allocate(in_function, in_type, in_priority);
+	return detail::allocate_job(in_function, in_type, in_priority);
 }
 
 template<typename UserDataType, typename... UserDataArgs>
@@ -159,12 +246,12 @@ Job* new_job(Job::Function in_function, JobType in_type, const JobPriority in_pr
 template<typename Lambda>
 Job* new_job(Lambda in_lambda, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
 {
-	return detail::get_job_pool().allocate(in_lambda, in_type, in_priority);
+	return detail::allocate_job(in_lambda, in_type, in_priority);
 }
 
 inline Job* new_child_job(Job::Function in_function, Job* in_parent, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
 {
-	return detail::get_job_pool().allocate(in_function, in_parent, in_type, in_priority);
+	return detail::allocate_job(in_function, in_parent, in_type, in_priority);
 }
 
 template<typename UserDataType, typename... UserDataArgs>
@@ -179,7 +266,7 @@ Job* new_child_job(Job::Function in_function, Job* in_parent, JobType in_type, c
 template<typename Lambda>
 Job* new_child_job(Lambda in_lambda, Job* in_parent, JobType in_type, const JobPriority in_priority = JobPriority::Normal)
 {
-	return detail::get_job_pool().allocate(in_lambda, in_parent, in_type, in_priority);
+	return detail::allocate_job(in_lambda, in_parent, in_type, in_priority);
 }
 
 
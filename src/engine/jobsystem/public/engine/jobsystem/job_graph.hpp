@@ -0,0 +1,94 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "job.hpp"
+#include "counter.hpp"
+
+namespace ze::jobsystem
+{
+
+/**
+ * A directed acyclic graph of jobs that is built once and can be submitted again and again (e.g every frame)
+ * Submitting doesn't allocate except for the pooled jobs executing the nodes
+ * Nodes must not be added while the graph is running
+ */
+class JobGraph
+{
+public:
+	using NodeIndex = uint32_t;
+
+	JobGraph() = default;
+	JobGraph(const JobGraph&) = delete;
+	JobGraph& operator=(const JobGraph&) = delete;
+
+	template<typename Func>
+		requires std::is_invocable_v<Func>
+	NodeIndex add(Func&& in_func, const JobPriority in_priority = JobPriority::Normal)
+	{
+		nodes.emplace_back(std::forward<Func>(in_func), in_priority);
+		dirty = true;
+		return static_cast<NodeIndex>(nodes.size() - 1);
+	}
+
+	/**
+	 * Don't run in_node before in_predecessor finished
+	 */
+	void add_dependency(const NodeIndex in_node, const NodeIndex in_predecessor);
+
+	/**
+	 * Schedule root nodes, remaining nodes are scheduled as their predecessors finish
+	 */
+	void submit();
+
+	/**
+	 * Wait for every node to finish, executing jobs in the meantime
+	 */
+	void wait() { counter.wait(); }
+
+	void submit_and_wait()
+	{
+		submit();
+		wait();
+	}
+
+	[[nodiscard]] bool is_running() const { return !counter.is_zero(); }
+	[[nodiscard]] size_t get_node_count() const { return nodes.size(); }
+
+	/** Counter reaching zero once the graph finished, jobs can depend on it */
+	Counter& get_counter() { return counter; }
+private:
+	struct Node
+	{
+		std::function<void()> func;
+		JobPriority priority;
+		std::vector<NodeIndex> successors;
+		uint32_t predecessor_count;
+
+		Node(std::function<void()>&& in_func, const JobPriority in_priority)
+			: func(std::move(in_func)), priority(in_priority), predecessor_count(0) {}
+	};
+
+	struct NodeJobData
+	{
+		JobGraph* graph;
+		NodeIndex node;
+	};
+
+	/** Rebuild the per-submit state after the graph changed, validating that it is acyclic */
+	void compile();
+	Job* create_node_job(const NodeIndex in_node);
+	void spawn_node(const NodeIndex in_node);
+	void run_node(const NodeIndex in_node);
+	static void execute_node(Job& in_job);
+private:
+	std::vector<Node> nodes;
+	std::vector<NodeIndex> roots;
+	std::vector<Job*> root_jobs;
+	std::unique_ptr<std::atomic_uint32_t[]> pending_predecessors;
+	Counter counter;
+	bool dirty = false;
+};
+
+}
@@ -1,28 +1,36 @@
 #pragma once
 
+#include <vector>
 #include "job.hpp"
+#include "counter.hpp"
 
 namespace ze::jobsystem
 {
 
+/**
+ * A set of jobs scheduled together, completion is tracked by a single counter
+ */
 class JobGroup
 {
 public:
 	void add(jobsystem::Job* in_job)
 	{
+		in_job->signal_on_finish(counter);
 		jobs.emplace_back(in_job);
 	}
 
+	/**
+	 * Schedule every added job in bulk, jobs must not be accessed after this since they may already be freed
+	 */
 	void schedule()
 	{
-		for (const auto& job : jobs)
-			job->schedule();
+		Job::schedule_bulk(jobs);
+		jobs.clear();
 	}
 
 	void wait()
 	{
-		for(const auto& job : jobs)
-			job->wait();
+		counter.wait();
 	}
 
 	void schedule_and_wait()
@@ -30,8 +38,12 @@ public:
 		schedule();
 		wait();
 	}
+
+	/** Counter reaching zero once every job of this group finished, jobs can depend on it */
+	Counter& get_counter() { return counter; }
 private:
 	std::vector<jobsystem::Job*> jobs;
+	Counter counter;
 };
 
-}
\ No newline at end of file
+}
@@ -1,14 +1,187 @@
 #pragma once
 
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "engine/hal/thread.hpp"
+#include "engine/logger/logger.hpp"
+
 namespace ze::jobsystem
 {
 
+ZE_DEFINE_LOG_CATEGORY(jobsystem);
+
 class WorkerThread;
 
-void initialize();
+enum class ExecutionMode
+{
+	/** Jobs run on the worker thread stacks, waiting threads execute other jobs in the meantime */
+	Threads,
+
+	/**
+	 * Jobs run on pooled fibers, waiting on a counter suspends the fiber
+	 * and the worker picks up other work instead of growing its stack
+	 */
+	Fibers,
+};
+
+/**
+ * Counters of the worker parking subsystem, since initialize()
+ */
+struct ParkingStats
+{
+	/** Number of times a worker went to sleep */
+	uint64_t parks = 0;
+
+	/** Number of times a sleeping worker has been woken up */
+	uint64_t wakeups = 0;
+
+	/** Wake-ups where the worker didn't find any job to execute */
+	uint64_t wasted_wakeups = 0;
+
+	/** Time between a wake-up request and the worker resuming */
+	uint64_t total_wakeup_latency_ns = 0;
+	uint64_t max_wakeup_latency_ns = 0;
+
+	[[nodiscard]] double get_average_wakeup_latency_ns() const
+	{
+		return wakeups > 0 ? static_cast<double>(total_wakeup_latency_ns) / static_cast<double>(wakeups) : 0.0;
+	}
+};
+
+/**
+ * Counters of a single worker, since initialize()
+ * Times are wall-clock nanoseconds measured by the worker loop:
+ * busy covers executing and looking for jobs, idle covers parking
+ */
+struct WorkerStats
+{
+	uint64_t jobs_executed = 0;
+	uint64_t busy_ns = 0;
+	uint64_t idle_ns = 0;
+
+	/**
+	 * Time spent looking for jobs in other workers queues, whether it succeeded or not
+	 * Estimated from a sample of the steal sweeps
+	 */
+	uint64_t steal_ns = 0;
+
+	/** One attempt per victim probed */
+	uint64_t steal_attempts = 0;
+	uint64_t steal_successes = 0;
+
+	/** Highest number of queued jobs observed, per JobPriority */
+	std::array<uint64_t, 3> max_queue_depths = {};
+
+	/** Jobs allocated from this worker's arena */
+	uint64_t jobs_allocated = 0;
+
+	/** Fiber mode only */
+	uint64_t fibers_created = 0;
+
+	[[nodiscard]] double get_busy_ratio() const
+	{
+		const uint64_t total_ns = busy_ns + idle_ns;
+		return total_ns > 0 ? static_cast<double>(busy_ns) / static_cast<double>(total_ns) : 0.0;
+	}
+
+	[[nodiscard]] double get_steal_success_ratio() const
+	{
+		return steal_attempts > 0 ? static_cast<double>(steal_successes) / static_cast<double>(steal_attempts) : 0.0;
+	}
+};
+
+struct Stats
+{
+	std::vector<WorkerStats> workers;
+
+	/** Sum of every worker, max for queue depths */
+	WorkerStats total;
+
+	/** Jobs allocated by non-worker threads */
+	uint64_t external_jobs_allocated = 0;
+
+	uint64_t io_jobs_executed = 0;
+	uint64_t background_jobs_executed = 0;
+
+	ParkingStats parking;
+};
+
+/**
+ * Worker topology and execution options
+ * Affinity masks address logical cores, bit i = core i (first 64 cores only)
+ */
+struct InitializeInfo
+{
+	ExecutionMode execution_mode = ExecutionMode::Threads;
+
+	/**
+	 * Number of workers, 0 to spawn one per logical core
+	 * minus one for the main thread (or minus the reserved cores if any)
+	 */
+	size_t worker_count = 0;
+
+	/** Cores kept for other threads (main, render, IO...), workers never run on them */
+	uint64_t reserved_cores = 0;
+
+	/** Pin each worker to a single non-reserved core, round-robin */
+	bool pin_workers = false;
+
+	/** Explicit affinity of worker i, overrides pin_workers when non-zero */
+	std::vector<uint64_t> worker_affinities;
+
+	hal::ThreadPriority worker_priority = hal::ThreadPriority::Normal;
+
+	/** Threads of the IO lane, at least one */
+	size_t io_thread_count = 2;
+
+	/** Threads of the background lane, at least one */
+	size_t background_thread_count = 1;
+	hal::ThreadPriority background_priority = hal::ThreadPriority::Low;
+
+	/** Fiber mode only */
+	size_t fiber_stack_size = 256 * 1024;
+};
+
+void initialize(const InitializeInfo& in_info = {});
 void shutdown();
 size_t get_worker_count();
 WorkerThread& get_worker_by_idx(size_t in_index);
 WorkerThread& get_current_or_random_worker();
+bool is_worker_thread();
+ExecutionMode get_execution_mode();
+
+/**
+ * Execute one pending job on the calling thread
+ * Workers look into their own queues first, other threads can only steal
+ * Jobs running on a fiber yield it instead, so other jobs don't pile up on its stack
+ * In fiber mode, non-worker threads never execute jobs
+ * \return false if no job could be found
+ */
+bool try_execute_one_job();
+
+/**
+ * Wake up to in_count sleeping workers, should be called after new jobs have been enqueued
+ */
+void wake_workers(size_t in_count = 1);
+
+/**
+ * [THREAD SAFE] Returns true if at least one worker is sleeping (approximate)
+ */
+[[nodiscard]] bool has_idle_workers();
+
+[[nodiscard]] ParkingStats get_parking_stats();
+
+/**
+ * [THREAD SAFE] Snapshot of every worker counters, values are read individually and may be slightly inconsistent
+ */
+[[nodiscard]] Stats get_stats();
+
+/**
+ * Send per-worker busy ratio and queue depths to Tracy since the last call, meant to be called once per frame
+ * Does nothing when profiling is disabled
+ */
+void plot_stats();
 
-}
\ No newline at end of file
+}
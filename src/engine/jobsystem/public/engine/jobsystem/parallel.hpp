@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "job.hpp"
+#include "jobsystem.hpp"
+#include "worker_thread.hpp"
+
+namespace ze::jobsystem
+{
+
+/**
+ * Half-open range of indices [begin, end)
+ */
+struct IndexRange
+{
+	size_t begin;
+	size_t end;
+
+	IndexRange(const size_t in_begin, const size_t in_end) : begin(in_begin), end(in_end) {}
+
+	[[nodiscard]] size_t size() const { return end - begin; }
+};
+
+namespace detail
+{
+
+/** Jobs spawned by a parallel algorithm call, the calling thread helps executing jobs until it reaches 0 */
+struct ParallelContext
+{
+	std::atomic_uint32_t pending_jobs;
+
+	ParallelContext() : pending_jobs(1) {}
+
+	void wait()
+	{
+		while (pending_jobs.load(std::memory_order_acquire) > 0)
+		{
+			if (!try_execute_one_job())
+				std::this_thread::yield();
+		}
+	}
+};
+
+/**
+ * Number of times a range is split upfront, enough to give each worker a few chunks (like TBB's auto_partitioner)
+ * Further splits only happen lazily when there is demand
+ */
+inline uint32_t get_initial_split_depth()
+{
+	return static_cast<uint32_t>(std::bit_width((get_worker_count() + 1) * 4));
+}
+
+/**
+ * Lazy binary splitting heuristic: split when thieves took everything from our deque
+ * (or when a worker is sleeping if we are not a worker)
+ */
+inline bool has_split_demand()
+{
+	if (is_worker_thread())
+		return !get_worker_by_idx(WorkerThread::get_current_worker_idx()).has_pending_jobs();
+
+	return has_idle_workers();
+}
+
+/**
+ * Recursively splits a range and runs Body::run_chunk on grain-sized chunks
+ * The right half of each split is spawned as a job that can be stolen, the left half is processed locally
+ * Every job processes a contiguous range, handed to Body::finish_range along with its accumulator
+ */
+template<typename Body>
+struct RangeJobData
+{
+	Body* body;
+	ParallelContext* context;
+	size_t begin;
+	size_t end;
+	size_t grain;
+	uint32_t split_depth;
+	size_t spawner_worker_idx;
+
+	static void spawn(Body* in_body, ParallelContext* in_context, size_t in_begin, size_t in_end,
+		size_t in_grain, uint32_t in_split_depth)
+	{
+		in_context->pending_jobs.fetch_add(1, std::memory_order_relaxed);
+		Job* job = new_job(&RangeJobData::execute, JobType::Normal);
+		new (job->get_userdata<RangeJobData>()) RangeJobData { in_body, in_context, in_begin, in_end, in_grain,
+			in_split_depth, WorkerThread::get_current_worker_idx() };
+		job->schedule();
+	}
+
+	static void execute(Job& in_job)
+	{
+		RangeJobData data = *in_job.get_userdata<RangeJobData>();
+
+		/** Stolen ranges are split again so the thief can share them too */
+		if (data.spawner_worker_idx != WorkerThread::get_current_worker_idx())
+			data.split_depth++;
+
+		data.run();
+		data.context->pending_jobs.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void run()
+	{
+		const size_t range_begin = begin;
+		auto accumulator = body->make_accumulator();
+		while (begin < end)
+		{
+			while (end - begin > grain && (split_depth > 0 || has_split_demand()))
+			{
+				if (split_depth > 0)
+					split_depth--;
+
+				const size_t middle = begin + (end - begin) / 2;
+				spawn(body, context, middle, end, grain, split_depth);
+				end = middle;
+			}
+
+			const size_t chunk_end = std::min(begin + grain, end);
+			body->run_chunk(IndexRange(begin, chunk_end), accumulator);
+			begin = chunk_end;
+		}
+
+		body->finish_range(IndexRange(range_begin, end), std::move(accumulator));
+	}
+};
+
+template<typename Body>
+void run_parallel_range(Body& in_body, size_t in_begin, size_t in_end, size_t in_grain)
+{
+	if (in_begin >= in_end)
+		return;
+
+	ParallelContext context;
+	RangeJobData<Body> root { &in_body, &context, in_begin, in_end, std::max<size_t>(in_grain, 1),
+		get_initial_split_depth(), WorkerThread::get_current_worker_idx() };
+	root.run();
+	context.pending_jobs.fetch_sub(1, std::memory_order_acq_rel);
+	context.wait();
+}
+
+template<typename Func>
+struct ForBody
+{
+	struct NoAccumulator {};
+
+	const Func& func;
+
+	NoAccumulator make_accumulator() const { return {}; }
+
+	void run_chunk(const IndexRange& in_range, NoAccumulator&)
+	{
+		if constexpr (std::is_invocable_v<const Func&, IndexRange>)
+		{
+			func(in_range);
+		}
+		else
+		{
+			for (size_t i = in_range.begin; i < in_range.end; ++i)
+				func(i);
+		}
+	}
+
+	void finish_range(const IndexRange&, NoAccumulator&&) {}
+};
+
+/**
+ * Each job accumulates the contiguous range it processed locally,
+ * then partials are combined in range order so the reduction only needs to be associative
+ */
+template<typename T, typename Func, typename Reduction>
+struct ReduceBody
+{
+	const T& identity;
+	const Func& func;
+	const Reduction& reduction;
+	std::mutex partials_mutex;
+	std::vector<std::pair<size_t, T>> partials;
+
+	T make_accumulator() const { return identity; }
+
+	void run_chunk(const IndexRange& in_range, T& in_accumulator)
+	{
+		in_accumulator = func(in_range, std::move(in_accumulator));
+	}
+
+	void finish_range(const IndexRange& in_range, T&& in_accumulator)
+	{
+		std::scoped_lock lock(partials_mutex);
+		partials.emplace_back(in_range.begin, std::move(in_accumulator));
+	}
+
+	T combine()
+	{
+		std::sort(partials.begin(), partials.end(),
+			[](const auto& in_left, const auto& in_right) { return in_left.first < in_right.first; });
+
+		T result = identity;
+		for (auto& [begin, value] : partials)
+			result = reduction(std::move(result), std::move(value));
+
+		return result;
+	}
+};
+
+template<typename T, typename Compare>
+struct SortJobData
+{
+	T* first;
+	T* last;
+	size_t grain;
+	const Compare* compare;
+	ParallelContext* context;
+
+	static void spawn(T* in_first, T* in_last, size_t in_grain, const Compare* in_compare, ParallelContext* in_context)
+	{
+		in_context->pending_jobs.fetch_add(1, std::memory_order_relaxed);
+		Job* job = new_job(&SortJobData::execute, JobType::Normal);
+		new (job->get_userdata<SortJobData>()) SortJobData { in_first, in_last, in_grain, in_compare, in_context };
+		job->schedule();
+	}
+
+	static void execute(Job& in_job)
+	{
+		SortJobData data = *in_job.get_userdata<SortJobData>();
+		data.run();
+		data.context->pending_jobs.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	/**
+	 * Parallel quicksort: partition around a median-of-three pivot,
+	 * spawn the left side and keep going on the right side, small ranges use std::sort
+	 */
+	void run()
+	{
+		const Compare& comp = *compare;
+		while (static_cast<size_t>(last - first) > grain)
+		{
+			T* middle = first + (last - first) / 2;
+			T* back = last - 1;
+			if (comp(*middle, *first))
+				std::iter_swap(middle, first);
+			if (comp(*back, *middle))
+			{
+				std::iter_swap(back, middle);
+				if (comp(*middle, *first))
+					std::iter_swap(middle, first);
+			}
+
+			const T pivot = *middle;
+
+			/** Three-way partition so ranges with many equal keys still shrink */
+			T* lower_end = std::partition(first, last, [&](const T& in_elem) { return comp(in_elem, pivot); });
+			T* equal_end = std::partition(lower_end, last, [&](const T& in_elem) { return !comp(pivot, in_elem); });
+
+			if (lower_end - first > 1)
+				spawn(first, lower_end, grain, compare, context);
+
+			first = equal_end;
+		}
+
+		std::sort(first, last, comp);
+	}
+};
+
+}
+
+/**
+ * Run in_func over [in_begin, in_end) in parallel
+ * in_func is called with either each index (size_t) or each chunk (IndexRange) of at most in_grain indices
+ * The range is recursively split in halves, a few times upfront then only when other workers run out of work
+ * The calling thread participates and returns once every index has been processed
+ */
+template<typename Func>
+void parallel_for(size_t in_begin, size_t in_end, size_t in_grain, const Func& in_func)
+{
+	detail::ForBody<Func> body { in_func };
+	detail::run_parallel_range(body, in_begin, in_end, in_grain);
+}
+
+template<typename Func>
+void parallel_for(const IndexRange& in_range, size_t in_grain, const Func& in_func)
+{
+	parallel_for(in_range.begin, in_range.end, in_grain, in_func);
+}
+
+/**
+ * Parallel reduction over [in_begin, in_end)
+ * \param in_func (IndexRange, T accumulator) -> T, accumulates a chunk
+ * \param in_reduction (T, T) -> T, must be associative
+ */
+template<typename T, typename Func, typename Reduction>
+T parallel_reduce(size_t in_begin, size_t in_end, size_t in_grain, const T& in_identity,
+	const Func& in_func, const Reduction& in_reduction)
+{
+	detail::ReduceBody<T, Func, Reduction> body { in_identity, in_func, in_reduction, {}, {} };
+	detail::run_parallel_range(body, in_begin, in_end, in_grain);
+	return body.combine();
+}
+
+template<typename T, typename Func, typename Reduction>
+T parallel_reduce(const IndexRange& in_range, size_t in_grain, const T& in_identity,
+	const Func& in_func, const Reduction& in_reduction)
+{
+	return parallel_reduce(in_range.begin, in_range.end, in_grain, in_identity, in_func, in_reduction);
+}
+
+/**
+ * Sort in_elements in parallel (unstable)
+ * \param in_grain Ranges smaller than this are sorted serially
+ */
+template<typename T, typename Compare = std::less<>>
+void parallel_sort(std::span<T> in_elements, const Compare& in_compare = {}, size_t in_grain = 2048)
+{
+	if (in_elements.empty())
+		return;
+
+	detail::ParallelContext context;
+	detail::SortJobData<T, Compare> root { in_elements.data(), in_elements.data() + in_elements.size(),
+		std::max<size_t>(in_grain, 2), &in_compare, &context };
+	root.run();
+	context.pending_jobs.fetch_sub(1, std::memory_order_acq_rel);
+	context.wait();
+}
+
+}
@@ -0,0 +1,416 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "job.hpp"
+#include "counter.hpp"
+
+namespace ze::jobsystem
+{
+
+template<typename T>
+class Task;
+
+namespace detail
+{
+
+/**
+ * Schedule a job resuming in_handle on a thread of in_lane
+ */
+void schedule_coroutine(std::coroutine_handle<> in_handle,
+	const JobPriority in_priority = JobPriority::Normal,
+	const JobLane in_lane = JobLane::Compute);
+
+class TaskPromiseBase
+{
+public:
+	struct FinalAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+
+		template<typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> in_handle) noexcept
+		{
+			return in_handle.promise().on_completed();
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_always initial_suspend() const noexcept { return {}; }
+	FinalAwaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() const noexcept { std::abort(); }
+
+	/**
+	 * Called once the task is suspended at its final point
+	 * The awaiter may destroy the task as soon as it is notified, so nothing of the frame is touched afterwards
+	 */
+	std::coroutine_handle<> on_completed() noexcept
+	{
+		if (join_count)
+		{
+			const std::coroutine_handle<> awaiter = continuation;
+			if (join_count->fetch_sub(1, std::memory_order_acq_rel) == 1)
+				return awaiter;
+
+			return std::noop_coroutine();
+		}
+
+		if (continuation)
+			return continuation;
+
+		if (Counter* completion_counter = counter)
+			completion_counter->decrement();
+
+		return std::noop_coroutine();
+	}
+
+	/** Coroutine to resume once completed (co_await or when_all) */
+	std::coroutine_handle<> continuation;
+
+	/** when_all: tasks left, the last one resumes the continuation */
+	std::atomic_uint32_t* join_count = nullptr;
+
+	/** Task::schedule: counter decremented once completed */
+	Counter* counter = nullptr;
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+	Task<T> get_return_object() noexcept;
+
+	template<typename U>
+		requires std::is_constructible_v<T, U&&>
+	void return_value(U&& in_value)
+	{
+		value.emplace(std::forward<U>(in_value));
+	}
+
+	T& get_result() & { return *value; }
+	T&& get_result() && { return std::move(*value); }
+private:
+	std::optional<T> value;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+	Task<void> get_return_object() noexcept;
+
+	void return_void() const noexcept {}
+	void get_result() const noexcept {}
+};
+
+struct JoinEntry
+{
+	std::coroutine_handle<> handle;
+	TaskPromiseBase* promise;
+};
+
+/**
+ * Schedules every task on a worker, the last task to complete resumes the awaiting coroutine
+ */
+class WhenAllAwaiter
+{
+public:
+	explicit WhenAllAwaiter(std::vector<JoinEntry>&& in_entries) : entries(std::move(in_entries)), pending_count(0) {}
+
+	bool await_ready() const noexcept { return entries.empty(); }
+
+	bool await_suspend(std::coroutine_handle<> in_awaiter) noexcept
+	{
+		/** One extra count so no task can resume us before every task has been scheduled */
+		pending_count.store(static_cast<uint32_t>(entries.size()) + 1, std::memory_order_relaxed);
+		for (const JoinEntry& entry : entries)
+		{
+			entry.promise->continuation = in_awaiter;
+			entry.promise->join_count = &pending_count;
+			schedule_coroutine(entry.handle);
+		}
+
+		return pending_count.fetch_sub(1, std::memory_order_acq_rel) != 1;
+	}
+
+	void await_resume() const noexcept {}
+private:
+	std::vector<JoinEntry> entries;
+	std::atomic_uint32_t pending_count;
+};
+
+struct ScheduleAwaiter
+{
+	JobPriority priority;
+	JobLane lane;
+
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> in_handle) const { schedule_coroutine(in_handle, priority, lane); }
+	void await_resume() const noexcept {}
+};
+
+/**
+ * A suspended coroutine waiting for a condition the job system can't be notified of (e.g a GPU fence)
+ */
+struct PollEntry
+{
+	/** \return true once the coroutine can be resumed */
+	bool (*poll)(PollEntry& in_entry);
+	std::coroutine_handle<> handle;
+};
+
+/**
+ * Poll in_entry until it is ready, then resume its coroutine on a worker
+ * Pending entries are polled together by the poll thread, which backs off exponentially while none of them is
+ * ready, so waiting never wakes compute workers nor holds lane threads
+ */
+void add_poll_entry(PollEntry& in_entry);
+
+/**
+ * Called by initialize/shutdown, pending entries are not polled anymore once stopped
+ */
+void start_poll_thread();
+void stop_poll_thread();
+
+/**
+ * Polls a predicate from the poll thread, resuming the coroutine once it returns true
+ */
+template<typename Predicate>
+class PollAwaiter : public PollEntry
+{
+public:
+	explicit PollAwaiter(Predicate&& in_predicate)
+		: PollEntry { &PollAwaiter::poll_predicate, {} }, predicate(std::move(in_predicate)) {}
+
+	bool await_ready() { return predicate(); }
+
+	void await_suspend(std::coroutine_handle<> in_handle)
+	{
+		handle = in_handle;
+		add_poll_entry(*this);
+	}
+
+	void await_resume() const noexcept {}
+private:
+	static bool poll_predicate(PollEntry& in_entry)
+	{
+		return static_cast<PollAwaiter&>(in_entry).predicate();
+	}
+private:
+	Predicate predicate;
+};
+
+/**
+ * Resumes the coroutine on a worker once a counter reaches zero
+ */
+class CounterAwaiter
+{
+public:
+	CounterAwaiter(Counter& in_counter, const JobPriority in_priority) : counter(in_counter), priority(in_priority) {}
+
+	bool await_ready() const { return counter.is_zero(); }
+	void await_suspend(std::coroutine_handle<> in_handle) const;
+	void await_resume() const noexcept {}
+private:
+	Counter& counter;
+	JobPriority priority;
+};
+
+}
+
+/**
+ * A lazily started coroutine returning a T
+ * Awaiting a task runs it inline and resumes the awaiter once it completes,
+ * use when_all to run several tasks in parallel on workers
+ * Exceptions are not supported
+ */
+template<typename T = void>
+class [[nodiscard]] Task
+{
+	template<bool Move>
+	struct Awaiter
+	{
+		std::coroutine_handle<detail::TaskPromise<T>> handle;
+
+		bool await_ready() const noexcept { return !handle || handle.done(); }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> in_awaiter) noexcept
+		{
+			handle.promise().continuation = in_awaiter;
+			return handle;
+		}
+
+		decltype(auto) await_resume()
+		{
+			if constexpr (Move)
+				return std::move(handle.promise()).get_result();
+			else
+				return handle.promise().get_result();
+		}
+	};
+
+public:
+	using promise_type = detail::TaskPromise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Task() = default;
+	explicit Task(Handle in_handle) : handle(in_handle) {}
+	~Task() { destroy(); }
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	Task(Task&& in_other) noexcept : handle(std::exchange(in_other.handle, nullptr)) {}
+
+	Task& operator=(Task&& in_other) noexcept
+	{
+		destroy();
+		handle = std::exchange(in_other.handle, nullptr);
+		return *this;
+	}
+
+	Awaiter<false> operator co_await() & noexcept { return { handle }; }
+	Awaiter<true> operator co_await() && noexcept { return { handle }; }
+
+	/**
+	 * Start the task on a worker, in_counter is incremented now and decremented once the task completed
+	 * The task must be kept alive until then
+	 */
+	void schedule(Counter& in_counter, const JobPriority in_priority = JobPriority::Normal)
+	{
+		in_counter.increment();
+		handle.promise().counter = &in_counter;
+		detail::schedule_coroutine(handle, in_priority);
+	}
+
+	[[nodiscard]] bool is_valid() const { return static_cast<bool>(handle); }
+	[[nodiscard]] bool is_done() const { return handle && handle.done(); }
+
+	/** Result of a completed task */
+	decltype(auto) get_result() & { return handle.promise().get_result(); }
+	decltype(auto) get_result() && { return std::move(handle.promise()).get_result(); }
+
+	[[nodiscard]] detail::JoinEntry get_join_entry() { return { handle, &handle.promise() }; }
+private:
+	void destroy()
+	{
+		if (handle)
+		{
+			handle.destroy();
+			handle = nullptr;
+		}
+	}
+private:
+	Handle handle;
+};
+
+namespace detail
+{
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+	return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+	return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+}
+
+/**
+ * Run every task in parallel on workers, resuming the awaiting coroutine once all of them completed
+ * Results are then available through Task::get_result
+ */
+template<typename... Ts>
+detail::WhenAllAwaiter when_all(Task<Ts>&... in_tasks)
+{
+	return detail::WhenAllAwaiter({ in_tasks.get_join_entry()... });
+}
+
+template<typename T>
+detail::WhenAllAwaiter when_all(std::span<Task<T>> in_tasks)
+{
+	std::vector<detail::JoinEntry> entries;
+	entries.reserve(in_tasks.size());
+	for (auto& task : in_tasks)
+		entries.emplace_back(task.get_join_entry());
+
+	return detail::WhenAllAwaiter(std::move(entries));
+}
+
+template<typename T>
+detail::WhenAllAwaiter when_all(std::vector<Task<T>>& in_tasks)
+{
+	return when_all(std::span<Task<T>>(in_tasks));
+}
+
+/**
+ * co_await to continue the coroutine on a worker
+ */
+inline detail::ScheduleAwaiter schedule_on_worker(const JobPriority in_priority = JobPriority::Normal)
+{
+	return { in_priority, JobLane::Compute };
+}
+
+/**
+ * co_await to continue the coroutine on a thread of in_lane (e.g blocking I/O or long-running work)
+ */
+inline detail::ScheduleAwaiter schedule_on_lane(const JobLane in_lane, const JobPriority in_priority = JobPriority::Normal)
+{
+	return { in_priority, in_lane };
+}
+
+/**
+ * co_await to suspend the coroutine until in_counter reaches zero, without blocking any thread
+ * The coroutine is resumed on a worker by a job depending on the counter
+ */
+inline detail::CounterAwaiter wait_for(Counter& in_counter, const JobPriority in_priority = JobPriority::Normal)
+{
+	return detail::CounterAwaiter(in_counter, in_priority);
+}
+
+/**
+ * co_await to suspend the coroutine until in_predicate returns true, without blocking any thread
+ * The predicate is polled from the poll thread, prefer wait_for when completion can signal a counter
+ */
+template<typename Predicate>
+	requires std::is_invocable_r_v<bool, Predicate&>
+detail::PollAwaiter<std::decay_t<Predicate>> wait_until(Predicate&& in_predicate)
+{
+	return detail::PollAwaiter<std::decay_t<Predicate>>(std::forward<Predicate>(in_predicate));
+}
+
+/**
+ * Run a task on a worker and wait for its result
+ * The calling thread executes jobs meanwhile (or its fiber is suspended)
+ */
+template<typename T>
+decltype(auto) sync_wait(Task<T>& in_task)
+{
+	Counter counter;
+	in_task.schedule(counter);
+	counter.wait();
+	return in_task.get_result();
+}
+
+template<typename T>
+T sync_wait(Task<T>&& in_task)
+{
+	Task<T> task = std::move(in_task);
+	Counter counter;
+	task.schedule(counter);
+	counter.wait();
+	return std::move(task).get_result();
+}
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <optional>
+#include <vector>
+#include <type_traits>
+
+namespace ze::jobsystem
+{
+
+/**
+ * Chase-Lev work-stealing deque (using the C11 memory model version from Lê et al., 2013)
+ * The owner thread pushes and pops from the bottom (LIFO), other threads steal from the top (FIFO)
+ * The buffer grows when full, old buffers are kept alive until destruction since thieves may still read them
+ */
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque
+{
+	class Buffer
+	{
+	public:
+		Buffer(const int64_t in_capacity)
+			: capacity(in_capacity), mask(in_capacity - 1), elements(std::make_unique<std::atomic<T>[]>(in_capacity)) {}
+
+		void put(const int64_t in_index, T in_element)
+		{
+			elements[in_index & mask].store(in_element, std::memory_order_relaxed);
+		}
+
+		T get(const int64_t in_index) const
+		{
+			return elements[in_index & mask].load(std::memory_order_relaxed);
+		}
+
+		std::unique_ptr<Buffer> grow(const int64_t in_bottom, const int64_t in_top) const
+		{
+			auto buffer = std::make_unique<Buffer>(capacity * 2);
+			for (int64_t i = in_top; i < in_bottom; ++i)
+				buffer->put(i, get(i));
+			return buffer;
+		}
+
+		[[nodiscard]] int64_t get_capacity() const { return capacity; }
+	private:
+		int64_t capacity;
+		int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> elements;
+	};
+
+public:
+	/** Capacity must be a power of two */
+	WorkStealingDeque(const int64_t in_capacity = 1024)
+		: top(0), bottom(0)
+	{
+		buffers.emplace_back(std::make_unique<Buffer>(in_capacity));
+		buffer = buffers.back().get();
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/**
+	 * [OWNER ONLY] Push an element to the bottom of the deque
+	 */
+	void push(T in_element)
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_acquire);
+		Buffer* current_buffer = buffer.load(std::memory_order_relaxed);
+
+		if (b - t > current_buffer->get_capacity() - 1)
+		{
+			buffers.emplace_back(current_buffer->grow(b, t));
+			current_buffer = buffers.back().get();
+			buffer.store(current_buffer, std::memory_order_release);
+		}
+
+		current_buffer->put(b, in_element);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * [OWNER ONLY] Pop the most recently pushed element
+	 */
+	std::optional<T> pop()
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* current_buffer = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		std::optional<T> element = current_buffer->get(b);
+		if (t == b)
+		{
+			/** Last element, race against thieves */
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				element = std::nullopt;
+
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		return element;
+	}
+
+	/**
+	 * [THREAD SAFE] Steal the oldest element
+	 * Returns std::nullopt if the deque is empty or if we lost a race against another thief/the owner
+	 */
+	std::optional<T> steal()
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return std::nullopt;
+
+		const T element = buffer.load(std::memory_order_acquire)->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return std::nullopt;
+
+		return element;
+	}
+
+	/** Approximate size, only reliable when called from the owner thread */
+	[[nodiscard]] size_t get_size() const
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? static_cast<size_t>(b - t) : 0;
+	}
+
+	[[nodiscard]] bool is_empty() const { return get_size() == 0; }
+private:
+	alignas(std::hardware_destructive_interference_size) std::atomic_int64_t top;
+	alignas(std::hardware_destructive_interference_size) std::atomic_int64_t bottom;
+	std::atomic<Buffer*> buffer;
+
+	/** Every allocated buffer, only touched by the owner */
+	std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+}
@@ -1,59 +1,239 @@
 #pragma once
 
 #include <thread>
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 #include "concurrentqueue/concurrentqueue.h"
+#include "work_stealing_deque.hpp"
+#include "engine/hal/thread.hpp"
+
+namespace ze::hal
+{
+
+struct Fiber;
+
+}
 
 namespace ze::jobsystem
 {
 
 class Job;
+class Counter;
+class WorkerThread;
+
+namespace detail
+{
+
+/**
+ * A pooled fiber executing jobs, always resumed on the worker owning it
+ */
+struct FiberContext
+{
+	hal::Fiber* fiber = nullptr;
+	WorkerThread* worker = nullptr;
+	Job* job = nullptr;
+};
+
+/**
+ * Telemetry counters of a worker, relaxed atomics so they can be read by any thread
+ * Most are only written by the worker itself, queue depths are also written by threads enqueuing to it
+ */
+struct alignas(std::hardware_destructive_interference_size) WorkerCounters
+{
+	std::atomic_uint64_t jobs_executed = 0;
+	std::atomic_uint64_t busy_ns = 0;
+	std::atomic_uint64_t idle_ns = 0;
+	std::atomic_uint64_t steal_ns = 0;
+	std::atomic_uint64_t steal_attempts = 0;
+	std::atomic_uint64_t steal_successes = 0;
+	std::atomic_uint64_t jobs_allocated = 0;
+	std::atomic_uint64_t fibers_created = 0;
+	alignas(std::hardware_destructive_interference_size) std::array<std::atomic_uint64_t, 3> max_queue_depths = {};
+};
+
+/**
+ * Add to a counter only written by the calling thread, without a locked read-modify-write
+ */
+inline void add_to_counter(std::atomic_uint64_t& in_counter, const uint64_t in_value)
+{
+	in_counter.store(in_counter.load(std::memory_order_relaxed) + in_value, std::memory_order_relaxed);
+}
+
+/**
+ * [THREAD SAFE] Raise a high-water mark
+ */
+inline void update_max_counter(std::atomic_uint64_t& in_counter, const uint64_t in_value)
+{
+	uint64_t current = in_counter.load(std::memory_order_relaxed);
+	while (in_value > current && !in_counter.compare_exchange_weak(current, in_value, std::memory_order_relaxed)) {}
+}
+
+/**
+ * [THREAD SAFE] Make a fiber suspended on a counter runnable again
+ */
+void resume_fiber(FiberContext* in_fiber);
+
+/**
+ * Suspend the calling job's fiber until in_counter reaches zero
+ * \return false if not called from a job running on a fiber
+ */
+bool suspend_current_fiber(Counter& in_counter);
+
+/**
+ * [THREAD SAFE] Wake workers parked with only busy-waiting fibers, called in fiber mode once a job finished
+ */
+void wake_busy_waiting_workers();
+
+}
 
 class WorkerThread
 {
+	static constexpr size_t priority_count = 3;
+	static constexpr size_t initial_fiber_count = 16;
+
+	/** What the scheduler fiber must do with the fiber that just switched back to it */
+	enum class FiberAction
+	{
+		None,
+
+		/** The job finished, the fiber can be reused */
+		Recycle,
+
+		/** The fiber waits for a counter */
+		Wait,
+
+		/** The fiber is busy-waiting, resume it when nothing else is runnable */
+		Yield,
+	};
+
 public:
-	WorkerThread(size_t in_index);
+	/**
+	 * \param in_affinity Cores the worker may run on, 0 to leave it unpinned
+	 */
+	WorkerThread(size_t in_index,
+		uint64_t in_affinity,
+		hal::ThreadPriority in_priority,
+		size_t in_fiber_stack_size);
 	~WorkerThread();
 
 	WorkerThread(const WorkerThread&) = delete;
 	WorkerThread& operator=(const WorkerThread&) = delete;
 
-	WorkerThread(WorkerThread&& other) noexcept : index(other.index),
-		active(other.active.load()),
-		thread(std::move(other.thread)),
-		high_job_queue(std::move(other.high_job_queue)),
-		normal_job_queue(std::move(other.normal_job_queue)),
-		low_job_queue(std::move(other.low_job_queue)),
-		high_consumer_tokens(std::move(other.high_consumer_tokens)),
-		normal_consumer_tokens(std::move(other.normal_consumer_tokens)),
-		low_consumer_tokens(std::move(other.low_consumer_tokens)) {}
-
+	/**
+	 * Try to execute one job (own queues first, then steal from other workers)
+	 * In fiber mode, the scheduler also resumes fibers that are ready, and jobs running on a fiber yield it
+	 * Must be called from the worker thread
+	 */
 	bool flush_one();
-	void enqueue(const Job* job);
 
-	auto& get_high_consumer_tokens() { return high_consumer_tokens; }
-	auto& get_normal_consumer_tokens() { return normal_consumer_tokens; }
-	auto& get_low_consumer_tokens() { return low_consumer_tokens; }
+	/**
+	 * [THREAD SAFE] Queue a suspended fiber of this worker to be resumed
+	 */
+	void resume(detail::FiberContext* in_fiber);
+
+	/**
+	 * Suspend the fiber currently running on this worker until in_counter reaches zero
+	 * \return false if this worker isn't running a fiber
+	 */
+	bool suspend_current_fiber(Counter& in_counter);
+
+	/**
+	 * Enqueue a job to this worker
+	 * Jobs enqueued from the worker thread itself go to its work-stealing deque,
+	 * jobs enqueued from other threads go to its inbox
+	 */
+	void enqueue(Job* job);
+
+	/**
+	 * Enqueue jobs of the same priority to this worker, with a single inbox operation from other threads
+	 */
+	void enqueue_bulk(Job* const* in_jobs, size_t in_count);
+
+	/**
+	 * [THREAD SAFE] Steal the oldest job of this worker, highest priority first
+	 */
+	Job* steal();
+
+	/**
+	 * Steal a job from any worker, trying them round-robin starting from a random one
+	 * \param in_thief_idx Index of the calling worker, skipped as a victim
+	 */
+	static Job* steal_from_any(size_t in_thief_idx);
+
+	/**
+	 * [THREAD SAFE] Check if this worker has any job queued (approximate)
+	 */
+	[[nodiscard]] bool has_pending_jobs() const;
+
+	/**
+	 * [THREAD SAFE] Wake this worker if it parked with only busy-waiting fibers
+	 * \return false if it wasn't waiting
+	 */
+	bool wake_if_busy_waiting();
+
+	/**
+	 * Ask the worker to exit its loop, the worker must then be woken up to notice it
+	 */
+	void request_stop() { active = false; }
 
-	static std::condition_variable& get_global_sleep_var() { return global_sleep_var;  }
 	static size_t get_current_worker_idx() { return current_worker_idx;  }
+	[[nodiscard]] size_t get_index() const { return index; }
+
+	[[nodiscard]] detail::WorkerCounters& get_counters() { return counters; }
+	[[nodiscard]] const detail::WorkerCounters& get_counters() const { return counters; }
 private:
 	void run();
-	const Job* try_get_or_steal_job();
-	bool try_dequeue(const Job*& job);
+	void execute(Job* in_job);
+	Job* try_get_or_steal_job();
+	bool try_dequeue(Job*& job);
+
+	bool schedule_fiber();
+	void set_busy_waiting();
+	void clear_busy_waiting();
+	detail::FiberContext* create_fiber();
+	detail::FiberContext* acquire_fiber();
+	void switch_to_fiber(detail::FiberContext* in_fiber);
+	void switch_to_scheduler(const FiberAction in_action);
+	static void fiber_main(void* in_userdata);
 private:
 	size_t index;
+	uint64_t affinity;
+	hal::ThreadPriority priority;
+	size_t fiber_stack_size;
 	std::atomic_bool active;
+
+	/** Jobs enqueued by this worker, per priority */
+	std::array<WorkStealingDeque<Job*>, priority_count> deques;
+
+	/** Jobs enqueued by other threads, per priority */
+	std::array<moodycamel::ConcurrentQueue<Job*>, priority_count> inboxes;
+
+	/** Fiber mode only: the thread's own fiber, running the scheduling loop */
+	hal::Fiber* scheduler_fiber;
+	detail::FiberContext* current_fiber;
+	FiberAction pending_action;
+	Counter* waiting_counter;
+	std::vector<std::unique_ptr<detail::FiberContext>> fibers;
+	std::vector<detail::FiberContext*> free_fibers;
+	std::deque<detail::FiberContext*> yielded_fibers;
+
+	/**
+	 * Set while the worker only has yielded fibers to run, a finishing job clears it and wakes the worker
+	 * Yielded fibers are all resumed once after it is set before the worker parks, so no completion is missed
+	 */
+	std::atomic_bool busy_waiting;
+	size_t yielded_fibers_to_check;
+
+	/** Fibers whose counter reached zero, pushed by any thread */
+	moodycamel::ConcurrentQueue<detail::FiberContext*> ready_fibers;
+
+	detail::WorkerCounters counters;
+
 	std::thread thread;
-	moodycamel::ConcurrentQueue<const Job*> high_job_queue;
-	moodycamel::ConcurrentQueue<const Job*> normal_job_queue;
-	moodycamel::ConcurrentQueue<const Job*> low_job_queue;
-	std::vector<moodycamel::ConsumerToken> high_consumer_tokens;
-	std::vector<moodycamel::ConsumerToken> normal_consumer_tokens;
-	std::vector<moodycamel::ConsumerToken> low_consumer_tokens;
-	std::mutex sleep_mutex;
-
-	inline static std::condition_variable global_sleep_var;
+
 	inline static thread_local size_t current_worker_idx = std::numeric_limits<size_t>::max();
 };
 
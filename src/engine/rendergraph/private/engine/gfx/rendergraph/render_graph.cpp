@@ -1,12 +1,13 @@
 #include "engine/gfx/rendergraph/render_graph.hpp"
 #include "engine/gfx/rendergraph/resource_registry.hpp"
+#include "engine/memory/tracking.hpp"
 
 namespace ze::gfx::rendergraph
 {
 
 RenderGraph::~RenderGraph() = default;
 
-AttachmentResource& RenderGraph::get_attachment_resource(const std::string& in_name)
+AttachmentResource& RenderGraph::get_attachment_resource(const Name in_name)
 {
 	auto it = resource_map.find(in_name);
 	if(it != resource_map.end())
@@ -27,7 +28,7 @@ TextureViewHandle RenderGraph::get_handle_from_resource(ResourceHandle in_resour
 	return get_handles_from_physical_attachment(resource->get_physical_index()).second;
 }
 
-void RenderGraph::set_backbuffer_attachment(const std::string& in_name, TextureViewHandle in_backbuffer, uint32_t in_width, uint32_t in_height)
+void RenderGraph::set_backbuffer_attachment(const Name in_name, TextureViewHandle in_backbuffer, uint32_t in_width, uint32_t in_height)
 {
 	backbuffer_resource_name = in_name;
 	backbuffer_attachment = in_backbuffer;
@@ -37,12 +38,14 @@ void RenderGraph::set_backbuffer_attachment(const std::string& in_name, TextureV
 
 void RenderGraph::validate()
 {
-	ZE_CHECK(!backbuffer_resource_name.empty());
+	ZE_CHECK(!backbuffer_resource_name.is_empty());
 	ZE_CHECK(resource_map.contains(backbuffer_resource_name));
 }
 
 void RenderGraph::compile()
 {
+	memory::ScopedTag tag(MemoryTag::RenderGraph);
+
 #if ZE_BUILD(IS_DEBUG)
 	validate();
 #endif
@@ -57,7 +60,7 @@ void RenderGraph::compile()
 
 	/** Traverse each pass dependencies recursively to get a (reversed) unordered list of referenced render passes */
 	{
-		const auto pass_list_copy = pass_list;
+		const FrameVector<RenderPass*> pass_list_copy(pass_list, get_frame_memory_resource());
 		for(auto& pass : pass_list_copy)
 			traverse_pass_dependencies(pass);
 	}
@@ -133,7 +136,7 @@ void RenderGraph::prune_duplicate_passes()
 
 void RenderGraph::order_passes()
 {
-	std::vector<RenderPass*> passes = std::move(pass_list);
+	FrameVector<RenderPass*> passes = std::move(pass_list);
 
 	auto schedule = [&](const size_t in_index)
 	{
@@ -224,7 +227,7 @@ void RenderGraph::build_barriers()
 			dst_layout(TextureLayout::Undefined) {}
 	};
 
-	std::vector<ResourceState> states;
+	FrameVector<ResourceState> states(get_frame_memory_resource());
 	states.reserve(physical_resources.size());
 
 	for(auto pass : pass_list)
@@ -266,6 +269,7 @@ void RenderGraph::build_barriers()
 
 void RenderGraph::execute(CommandListHandle in_list)
 {
+	memory::ScopedTag tag(MemoryTag::RenderGraph);
 	get_device()->cmd_begin_region(in_list, "Render Graph", { 0.5f, 0.35f, 0.75f, 1 });
 
 	for(size_t i = 0; i < pass_list.size(); ++i)
@@ -290,12 +294,12 @@ void RenderGraph::execute(CommandListHandle in_list)
 
 		/** Setup render pass */
 		RenderPassInfo info;
-		std::vector<RenderPassInfo::Subpass> subpasses;
-		std::vector<ClearValue> clear_values;
+		SmallVector<RenderPassInfo::Subpass, 1> subpasses;
+		AttachmentVector<ClearValue> clear_values;
 
-		std::vector<TextureViewHandle> color_attachments;
-		std::vector<uint32_t> color_attachments_refs;
-		std::vector<uint32_t> input_attachments_refs;
+		AttachmentVector<TextureViewHandle> color_attachments;
+		AttachmentVector<uint32_t> color_attachments_refs;
+		AttachmentVector<uint32_t> input_attachments_refs;
 
 		for(const auto attachment : pass->get_attachment_inputs())
 		{
@@ -304,7 +308,7 @@ void RenderGraph::execute(CommandListHandle in_list)
 			if (physical_resource.texture_usage_flags & TextureUsageFlagBits::DepthStencilAttachment)
 				continue;
 
-			if (resource->get_name() == "backbuffer")
+			if (resource->get_name() == backbuffer_resource_name)
 			{
 				color_attachments.emplace_back(backbuffer_attachment);
 			}
@@ -324,7 +328,7 @@ void RenderGraph::execute(CommandListHandle in_list)
 			const uint32_t width = physical_resource.texture_info.width == 0 ? backbuffer_width : physical_resource.texture_info.width;
 			const uint32_t height = physical_resource.texture_info.height == 0 ? backbuffer_height : physical_resource.texture_info.height;
 
-			if(resource->get_name() == "backbuffer")
+			if(resource->get_name() == backbuffer_resource_name)
 			{
 				color_attachments.emplace_back(backbuffer_attachment);
 			}
@@ -410,7 +414,7 @@ std::pair<TextureHandle, TextureViewHandle> RenderGraph::get_handles_from_physic
 			1,
 			SampleCountFlagBits::Count1,
 			physical_resource.texture_usage_flags
-		} }.set_debug_name(physical_resource.name));
+		} }.set_debug_name(physical_resource.name.get_string()));
 }
 
 }
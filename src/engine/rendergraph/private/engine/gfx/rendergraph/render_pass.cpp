@@ -7,7 +7,7 @@ RenderPass::RenderPass(RenderGraph& in_graph,
 	std::string in_name,
 	RenderPassQueueFlagBits in_target_queue) : graph(in_graph), name(in_name), target_queue(in_target_queue) {}
 
-ResourceHandle RenderPass::add_attachment_input(const std::string& in_name)
+ResourceHandle RenderPass::add_attachment_input(const Name in_name)
 {
 	auto& resource = graph.get_attachment_resource(in_name);
 
@@ -32,7 +32,7 @@ ResourceHandle RenderPass::add_attachment_input(const ResourceHandle& in_handle)
 	return in_handle;
 }
 
-void RenderPass::add_color_input(const std::string& in_name)
+void RenderPass::add_color_input(const Name in_name)
 {
 	auto& resource = graph.get_attachment_resource(in_name);
 	resource.add_read(this);
@@ -40,7 +40,7 @@ void RenderPass::add_color_input(const std::string& in_name)
 	color_inputs.emplace_back(resource.get_index());
 }
 
-ResourceHandle RenderPass::add_color_output(const std::string& in_name, const AttachmentInfo& in_attachment, bool in_force_load)
+ResourceHandle RenderPass::add_color_output(const Name in_name, const AttachmentInfo& in_attachment, bool in_force_load)
 {
 	auto& resource = graph.get_attachment_resource(in_name);
 	resource.set_info(in_attachment);
@@ -59,7 +59,7 @@ ResourceHandle RenderPass::add_color_output(const std::string& in_name, const At
 	return resource.get_index();
 }
 
-ResourceHandle RenderPass::set_depth_stencil_input(const std::string& in_name)
+ResourceHandle RenderPass::set_depth_stencil_input(const Name in_name)
 {
 	ZE_CHECK(depth_stencil_output == Resource::null_resource_idx);
 
@@ -72,7 +72,7 @@ ResourceHandle RenderPass::set_depth_stencil_input(const std::string& in_name)
 	return resource.get_index();
 }
 
-ResourceHandle RenderPass::set_depth_stencil_output(const std::string& in_name, const AttachmentInfo& in_attachment)
+ResourceHandle RenderPass::set_depth_stencil_output(const Name in_name, const AttachmentInfo& in_attachment)
 {
 	ZE_CHECK(depth_stencil_input == Resource::null_resource_idx);
 
@@ -4,7 +4,7 @@
 namespace ze::gfx::rendergraph
 {
 
-std::pair<TextureHandle, TextureViewHandle> PhysicalResourceRegistry::get_texture_handles(std::string in_name, TextureInfo in_info)
+std::pair<TextureHandle, TextureViewHandle> PhysicalResourceRegistry::get_texture_handles(const Name in_name, const TextureInfo& in_info)
 {
 	auto it = textures.find({ in_name, in_info });
 	if (it != textures.end())
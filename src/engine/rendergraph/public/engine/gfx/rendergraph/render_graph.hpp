@@ -1,6 +1,9 @@
 #pragma once
 
 #include "engine/gfx/device.hpp"
+#include "engine/memory/frame_arena.hpp"
+#include "engine/containers/inline_function.hpp"
+#include "engine/name.hpp"
 #include <any>
 #include <unordered_set>
 
@@ -39,7 +42,7 @@ class Resource
 public:
 	static constexpr uint32_t null_resource_idx = std::numeric_limits<uint32_t>::max();
 
-	Resource(const ResourceType in_type, const std::string& in_name, const uint32_t in_index = null_resource_idx)
+	Resource(const ResourceType in_type, const Name in_name, const uint32_t in_index = null_resource_idx)
 		: type(in_type), name(in_name), index(in_index), physical_index(Resource::null_resource_idx) {}
 	virtual ~Resource() = default;
 
@@ -57,7 +60,7 @@ public:
 	auto get_queue_flags() const { return queue_flags; }
 private:
 	ResourceType type;
-	std::string name;
+	Name name;
 	uint32_t index;
 	std::vector<RenderPass*> reads;
 	std::vector<RenderPass*> writes;
@@ -79,7 +82,7 @@ struct ResourceHandle
 class AttachmentResource : public Resource
 {
 public:
-	AttachmentResource(const std::string& in_name, 
+	AttachmentResource(const Name in_name, 
 		const uint32_t in_index = null_resource_idx) : Resource(ResourceType::Attachment, in_name, in_index) {}
 
 	void add_usage(TextureUsageFlagBits in_bit) { usage_flags |= in_bit; }
@@ -102,12 +105,12 @@ public:
 
 	virtual void execute(CommandListHandle in_list) = 0;
 
-	ResourceHandle add_attachment_input(const std::string& in_name);
+	ResourceHandle add_attachment_input(const Name in_name);
 	ResourceHandle add_attachment_input(const ResourceHandle& in_handle);
-	void add_color_input(const std::string& in_name);
-	ResourceHandle add_color_output(const std::string& in_name, const AttachmentInfo& in_attachment, bool in_force_load = false);
-	ResourceHandle set_depth_stencil_input(const std::string& in_name);
-	ResourceHandle set_depth_stencil_output(const std::string& in_name, const AttachmentInfo& in_attachment);
+	void add_color_input(const Name in_name);
+	ResourceHandle add_color_output(const Name in_name, const AttachmentInfo& in_attachment, bool in_force_load = false);
+	ResourceHandle set_depth_stencil_input(const Name in_name);
+	ResourceHandle set_depth_stencil_output(const Name in_name, const AttachmentInfo& in_attachment);
 
 	bool is_color_input(const ResourceHandle in_handle) const;
 	bool should_load(const ResourceHandle in_handle) const;
@@ -144,14 +147,14 @@ public:
 	RenderPassSimple(RenderGraph& in_graph,
 		std::string in_name,
 		RenderPassQueueFlagBits in_target_queue,
-		E in_execute_func) : RenderPass(in_graph, in_name, in_target_queue), execute_func(in_execute_func) {}
+		E in_execute_func) : RenderPass(in_graph, in_name, in_target_queue), execute_func(std::move(in_execute_func)) {}
 
 	void execute(CommandListHandle in_list) override
 	{
 		execute_func(in_list);
 	}
 private:
-	std::function<ExecuteFunc> execute_func;
+	InlineFunction<ExecuteFunc> execute_func;
 };
 
 template<typename T>
@@ -164,7 +167,7 @@ public:
 	RenderPassPayloaded(RenderGraph& in_graph,
 		std::string in_name,
 		RenderPassQueueFlagBits in_target_queue,
-		E in_execute_func) : RenderPass(in_graph, in_name, in_target_queue), execute_func(in_execute_func) {}
+		E in_execute_func) : RenderPass(in_graph, in_name, in_target_queue), execute_func(std::move(in_execute_func)) {}
 
 	void execute(CommandListHandle in_list) override
 	{
@@ -174,14 +177,14 @@ public:
 	T& get_data() { return data; }
 private:
 	T data;
-	std::function<ExecuteFunc> execute_func;
+	InlineFunction<ExecuteFunc> execute_func;
 };
 
 class RenderGraph
 {
 	struct PhysicalResource
 	{
-		std::string name;
+		Name name;
 		AttachmentInfo texture_info;
 		RenderPassQueueFlags queues;
 		TextureUsageFlags texture_usage_flags;
@@ -199,7 +202,10 @@ class RenderGraph
 		PipelineStageFlags dst_stage;
 	};
 public:
-	RenderGraph(PhysicalResourceRegistry& in_registry) : physical_resource_registry(in_registry) {}
+	RenderGraph(PhysicalResourceRegistry& in_registry) : physical_resource_registry(in_registry),
+		physical_resources(get_frame_memory_resource()),
+		pass_list(get_frame_memory_resource()),
+		render_pass_barriers(get_frame_memory_resource()) {}
 	~RenderGraph();
 
 	template<typename S, typename E>
@@ -207,7 +213,7 @@ public:
 		S in_setup_func,
 		E in_execute_func)
 	{
-		auto render_pass = std::make_unique<RenderPassSimple>(*this, in_name, RenderPassQueueFlagBits::Gfx, in_execute_func);
+		auto render_pass = std::make_unique<RenderPassSimple>(*this, in_name, RenderPassQueueFlagBits::Gfx, std::move(in_execute_func));
 		in_setup_func(*render_pass);
 		render_passes.emplace_back(std::move(render_pass));
 		return *render_passes.back();
@@ -218,17 +224,17 @@ public:
 		S in_setup_func,
 		E in_execute_func)
 	{
-		auto render_pass = std::make_unique<RenderPassPayloaded<T>>(*this, in_name, RenderPassQueueFlagBits::Gfx, in_execute_func);
+		auto render_pass = std::make_unique<RenderPassPayloaded<T>>(*this, in_name, RenderPassQueueFlagBits::Gfx, std::move(in_execute_func));
 		in_setup_func(*render_pass, render_pass->get_data());
 		render_passes.emplace_back(std::move(render_pass));
 		return *render_passes.back();
 	}
 
-	void set_backbuffer_attachment(const std::string& in_name, TextureViewHandle in_backbuffer, uint32_t in_width, uint32_t in_height);
+	void set_backbuffer_attachment(const Name in_name, TextureViewHandle in_backbuffer, uint32_t in_width, uint32_t in_height);
 	void compile();
 	void execute(CommandListHandle in_list);
 
-	AttachmentResource& get_attachment_resource(const std::string& in_name);
+	AttachmentResource& get_attachment_resource(const Name in_name);
 	AttachmentResource& get_attachment_resource(const ResourceHandle& in_idx) { return static_cast<AttachmentResource&>(*resources[in_idx.index]); }
 
 	TextureViewHandle get_handle_from_resource(ResourceHandle in_resource);
@@ -259,21 +265,25 @@ private:
 	PhysicalResourceRegistry& physical_resource_registry;
 	std::vector<std::unique_ptr<RenderPass>> render_passes;
 	std::vector<std::unique_ptr<Resource>> resources;
-	std::vector<PhysicalResource> physical_resources;
-	robin_hood::unordered_map<std::string, uint32_t> resource_map;
-	std::string backbuffer_resource_name;
+
+	/** Render graphs are rebuilt every frame, their per-pass data comes from the frame arena */
+	FrameVector<PhysicalResource> physical_resources;
+	robin_hood::unordered_map<Name, uint32_t> resource_map;
+	Name backbuffer_resource_name;
 	TextureViewHandle backbuffer_attachment;
 	uint32_t backbuffer_width;
 	uint32_t backbuffer_height;
-	std::vector<RenderPass*> pass_list;
+	FrameVector<RenderPass*> pass_list;
 
 	struct RenderPassBarriers
 	{
-		std::vector<Barrier> invalidates;
-		std::vector<Barrier> flushs;
+		FrameVector<Barrier> invalidates;
+		FrameVector<Barrier> flushs;
+
+		RenderPassBarriers() : invalidates(get_frame_memory_resource()), flushs(get_frame_memory_resource()) {}
 	};
 
-	std::vector<RenderPassBarriers> render_pass_barriers;
+	FrameVector<RenderPassBarriers> render_pass_barriers;
 };
 
 }
\ No newline at end of file
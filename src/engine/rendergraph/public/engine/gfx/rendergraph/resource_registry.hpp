@@ -2,6 +2,7 @@
 
 #include <unordered_map>
 #include "engine/gfx/device.hpp"
+#include "engine/name.hpp"
 
 namespace ze::gfx::rendergraph
 {
@@ -14,7 +15,7 @@ class PhysicalResourceRegistry
 public:
 	struct TextureKey
 	{
-		std::string name;
+		Name name;
 		TextureInfo create_info;
 
 		bool operator==(const TextureKey& in_other) const
@@ -48,7 +49,7 @@ public:
 		UniqueTextureView view;
 	};
 
-	std::pair<TextureHandle, TextureViewHandle> get_texture_handles(std::string in_name, TextureInfo in_info);
+	std::pair<TextureHandle, TextureViewHandle> get_texture_handles(const Name in_name, const TextureInfo& in_info);
 private:
 	robin_hood::unordered_map<TextureKey, TextureEntry, TextureKeyHash> textures;
 };
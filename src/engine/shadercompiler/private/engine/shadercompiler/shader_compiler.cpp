@@ -1,6 +1,7 @@
 #include "engine/shadercompiler/shader_compiler.hpp"
 #include <robin_hood.h>
 #include "engine/hal/thread.hpp"
+#include "engine/logger/deferred.hpp"
 
 namespace ze::gfx
 {
@@ -42,7 +43,8 @@ ShaderCompiler* get_shader_compiler(ShaderFormat in_format)
 
 ShaderCompilerOutput compile_shader(const ShaderCompilerInput& in_input)
 {
-	logger::info(log_shadercompiler, "Compiling shader {}", in_input.name);
+	/** Called by every permutation compile job, formatted on the logger thread */
+	ZE_LOG_DEFERRED(Info, log_shadercompiler, "Compiling shader {}", in_input.name);
 
 	if (auto result = get_shader_compiler(in_input.target_format))
 		return result->compile_shader(in_input);
@@ -10,7 +10,7 @@ ShaderInstance::ShaderInstance(ShaderPermutation& in_permutation)
 		permutation.compile();
 }
 
-bool ShaderInstance::set_parameter(const std::string& in_name, gfx::BufferHandle in_buffer)
+bool ShaderInstance::set_parameter(const Name in_name, gfx::BufferHandle in_buffer)
 {
 	if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 	{
@@ -27,7 +27,7 @@ bool ShaderInstance::set_parameter(const std::string& in_name, gfx::BufferHandle
 	return false;
 }
 
-bool ShaderInstance::set_parameter(const std::string& in_name, gfx::TextureViewHandle in_buffer)
+bool ShaderInstance::set_parameter(const Name in_name, gfx::TextureViewHandle in_buffer)
 {
 	if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 	{
@@ -44,7 +44,7 @@ bool ShaderInstance::set_parameter(const std::string& in_name, gfx::TextureViewH
 	return false;
 }
 
-bool ShaderInstance::set_parameter_uav(const std::string& in_name, const std::span<gfx::TextureViewHandle>& in_textures)
+bool ShaderInstance::set_parameter_uav(const Name in_name, const std::span<gfx::TextureViewHandle>& in_textures)
 {
 	if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 	{
@@ -60,7 +60,7 @@ bool ShaderInstance::set_parameter_uav(const std::string& in_name, const std::sp
 	return false;
 }
 
-bool ShaderInstance::set_parameter_uav(const std::string& in_name, const std::span<gfx::UniqueTextureView>& in_textures)
+bool ShaderInstance::set_parameter_uav(const Name in_name, const std::span<gfx::UniqueTextureView>& in_textures)
 {	
 	if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 	{
@@ -76,7 +76,7 @@ bool ShaderInstance::set_parameter_uav(const std::string& in_name, const std::sp
 	return false;
 }
 
-bool ShaderInstance::set_parameter(const std::string& in_name, gfx::SamplerHandle in_buffer)
+bool ShaderInstance::set_parameter(const Name in_name, gfx::SamplerHandle in_buffer)
 {
 	if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 	{
@@ -1,15 +1,27 @@
 #include "engine/shadersystem/shader_manager.hpp"
 #include "engine/module/module_manager.hpp"
 #include "engine/shadersystem/shader.hpp"
+#include "engine/memory/tracking.hpp"
 #include "engine/filesystem/filesystem_module.hpp"
 #include "zeshader_compiler.hpp"
 
 namespace ze::shadersystem
 {
 
-ShaderManager::ShaderManager(gfx::Device& in_device) : device(in_device) {}
+/** Shaders are scanned and built from several threads */
+constinit ModuleRef<filesystem::Module> filesystem_module("FileSystem");
+
+ShaderManager::ShaderManager() : device(nullptr), device_counter(1) {}
 ShaderManager::~ShaderManager() = default;
 
+void ShaderManager::set_device(gfx::Device& in_device)
+{
+	gfx::Device* previous_device = device.exchange(&in_device, std::memory_order_acq_rel);
+	ZE_CHECKF(!previous_device, "Shader manager device can only be set once");
+	if (!previous_device)
+		device_counter.decrement();
+}
+
 void ShaderManager::add_shader_directory(const std::string& in_name)
 {
 	logger::info(log_shadersystem, "Added shader search directory: \"{}\"", in_name);
@@ -20,7 +32,7 @@ void ShaderManager::add_shader_directory(const std::string& in_name)
 
 void ShaderManager::scan_directory(const std::string& in_directory)
 {
-	auto& filesystem = get_module<filesystem::Module>("FileSystem")->get_filesystem();
+	auto& filesystem = filesystem_module->get_filesystem();
 	if (!filesystem.iterate_directory(in_directory,
 		[&](const std::filesystem::path& in_path)
 		{
@@ -35,7 +47,8 @@ void ShaderManager::scan_directory(const std::string& in_directory)
 
 void ShaderManager::build_shader(const std::filesystem::path& in_path)
 {
-	auto& filesystem = get_module<filesystem::Module>("FileSystem")->get_filesystem();
+	memory::ScopedTag tag(MemoryTag::Shaders);
+	auto& filesystem = filesystem_module->get_filesystem();
 
 	auto file = filesystem.read(in_path);
 	if (file)
@@ -54,12 +67,14 @@ void ShaderManager::build_shader(const std::filesystem::path& in_path)
 
 void ShaderManager::register_shader(const ShaderDeclaration& in_declaration)
 {
-	std::scoped_lock lock(shader_map_mutex);
-	shader_map.insert({ in_declaration.name, std::make_unique<Shader>(*this, in_declaration) });
+	memory::ScopedTag tag(MemoryTag::Shaders);
+	const Name name(in_declaration.name);
+	std::unique_lock lock(shader_map_mutex);
+	shader_map.insert({ name, std::make_unique<Shader>(*this, in_declaration) });
 	logger::info(log_shadersystem, "Registered shader {}", in_declaration.name);
 }
 
-Shader* ShaderManager::get_shader(const std::string_view& in_name)
+Shader* ShaderManager::get_shader(const Name in_name)
 {
 	/**
 	 * First, attempt to get the shader from our shader map
@@ -72,10 +87,10 @@ Shader* ShaderManager::get_shader(const std::string_view& in_name)
 	return nullptr;
 }
 
-Shader* ShaderManager::get_shader_from_shader_map(const std::string_view& in_name)
+Shader* ShaderManager::get_shader_from_shader_map(const Name in_name)
 {
-	std::scoped_lock lock(shader_map_mutex);
-	auto it = shader_map.find(std::string(in_name));
+	std::shared_lock lock(shader_map_mutex);
+	auto it = shader_map.find(in_name);
 	if (it != shader_map.end())
 		return it->second.get();
 
@@ -3,8 +3,10 @@
 #include "shader_declaration.hpp"
 #include <bitset>
 #include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/task.hpp"
 #include "shader_permutation_id.hpp"
 #include "glm/vec2.hpp"
+#include "engine/name.hpp"
 
 namespace ze::shadersystem
 {
@@ -46,20 +48,26 @@ public:
 	ShaderPermutation(const ShaderPermutation&) = delete;
 	ShaderPermutation& operator=(const ShaderPermutation&) = delete;
 
-	/** Don't allow move as this may invalidate some this ptrs in lambdas for compiling */
+	/** Don't allow move as the compilation task references this */
 	ShaderPermutation(ShaderPermutation&&) = delete;
 	ShaderPermutation& operator=(ShaderPermutation&&) = delete;
 
 	void compile();
 
+	/** Wait for the compilation to finish, when called from a job the worker executes other jobs meanwhile */
+	void wait_for_compilation()
+	{
+		compilation_counter.wait();
+	}
+
 	/** Get shader map (BLOCKING !) */
 	[[nodiscard]] const ShaderMap& get_shader_map()
 	{
-		while(root_compilation_job->is_running()) {}
+		wait_for_compilation();
 		return shader_map;
 	}
 
-	const ParameterInfo* get_parameter_info(const std::string& in_name) const
+	const ParameterInfo* get_parameter_info(const Name in_name) const
 	{
 		auto it = parameter_infos.find(in_name);
 		if (it != parameter_infos.end())
@@ -75,14 +83,17 @@ public:
 	bool is_available() const { return state == ShaderPermutationState::Available; }
 	auto get_shader_stage_flags() const { return shader_stage_flags; }
 	auto get_parameters_size() const { return parameters_size; }
+private:
+	jobsystem::Task<> compile_async();
 private:
 	Shader& shader;
 	ShaderPermutationPassIdPair pass_id_pair;
 	std::atomic<ShaderPermutationState> state;
 	gfx::UniquePipelineLayout pipeline_layout;
 	ShaderMap shader_map;
-	jobsystem::Job* root_compilation_job;
-	robin_hood::unordered_map<std::string, ParameterInfo> parameter_infos;
+	jobsystem::Task<> compilation_task;
+	jobsystem::Counter compilation_counter;
+	robin_hood::unordered_map<Name, ParameterInfo> parameter_infos;
 	gfx::ShaderStageFlags shader_stage_flags;
 	size_t parameters_size;
 };
@@ -170,15 +181,15 @@ public:
 
 	void bind(gfx::CommandListHandle handle);
 
-	bool set_parameter(const std::string& in_name, gfx::BufferHandle in_buffer);
-	bool set_parameter(const std::string& in_name, gfx::TextureViewHandle in_buffer);
-	bool set_parameter(const std::string& in_name, gfx::SamplerHandle in_buffer);
-	bool set_parameter_uav(const std::string& in_name, const std::span<gfx::TextureViewHandle>& in_textures);
-	bool set_parameter_uav(const std::string& in_name, const std::span<gfx::UniqueTextureView>& in_textures);
+	bool set_parameter(const Name in_name, gfx::BufferHandle in_buffer);
+	bool set_parameter(const Name in_name, gfx::TextureViewHandle in_buffer);
+	bool set_parameter(const Name in_name, gfx::SamplerHandle in_buffer);
+	bool set_parameter_uav(const Name in_name, const std::span<gfx::TextureViewHandle>& in_textures);
+	bool set_parameter_uav(const Name in_name, const std::span<gfx::UniqueTextureView>& in_textures);
 
 	template<typename T>
 		requires std::is_standard_layout_v<T>
-	bool set_parameter(const std::string& in_name, T in_value)
+	bool set_parameter(const Name in_name, T in_value)
 	{
 		if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 		{
@@ -189,7 +200,7 @@ public:
 		return false;
 	}
 
-	bool set_parameter(const std::string& in_name, glm::vec2 in_value)
+	bool set_parameter(const Name in_name, glm::vec2 in_value)
 	{
 		if (const auto* parameter_info = permutation.get_parameter_info(in_name))
 		{
@@ -3,7 +3,10 @@
 #include "engine/result.hpp"
 #include "shader.hpp"
 #include "engine/gfx/shader_format.hpp"
+#include "engine/jobsystem/counter.hpp"
+#include <atomic>
 #include <filesystem>
+#include <shared_mutex>
 
 namespace ze::shadersystem
 {
@@ -11,9 +14,18 @@ namespace ze::shadersystem
 class ShaderManager
 {
 public:
-	ShaderManager(gfx::Device& in_device);
+	/**
+	 * Shaders can be scanned and compiled before the device is set, so it can be created meanwhile
+	 * Permutations compiled before wait for set_device to create their shaders
+	 */
+	ShaderManager();
 	~ShaderManager();
 
+	/**
+	 * [THREAD SAFE] Set the device shaders are created on, once
+	 */
+	void set_device(gfx::Device& in_device);
+
 	/**
 	 * Change the shader format
 	 * \warn This will NOT recompile all shaders, it MUST be set once before any shader loaded!
@@ -29,19 +41,31 @@ public:
 	/**
 	 * [THREAD SAFE] Request a shader
 	 */
-	[[nodiscard]] Shader* get_shader(const std::string_view& in_name);
+	[[nodiscard]] Shader* get_shader(const Name in_name);
 	[[nodiscard]] gfx::ShaderFormat get_shader_format() const { return shader_format; }
-	[[nodiscard]] gfx::Device& get_device() { return device; }
+	[[nodiscard]] bool has_device() const { return device.load(std::memory_order_acquire) != nullptr; }
+
+	/** Reaches zero once the device is set, permutations wait for it before creating their shaders */
+	[[nodiscard]] jobsystem::Counter& get_device_counter() { return device_counter; }
+
+	/** Expects the device to be set */
+	[[nodiscard]] gfx::Device& get_device()
+	{
+		gfx::Device* current_device = device.load(std::memory_order_acquire);
+		ZE_CHECK(current_device);
+		return *current_device;
+	}
 private:
 	void scan_directory(const std::string& in_directory);
 	void build_shader(const std::filesystem::path& in_path);
 	void register_shader(const ShaderDeclaration& in_declaration);
-	[[nodiscard]] Shader* get_shader_from_shader_map(const std::string_view& in_name);
+	[[nodiscard]] Shader* get_shader_from_shader_map(const Name in_name);
 private:
-	gfx::Device& device;
-	robin_hood::unordered_map<std::string, std::unique_ptr<Shader>> shader_map;
+	std::atomic<gfx::Device*> device;
+	jobsystem::Counter device_counter;
+	robin_hood::unordered_map<Name, std::unique_ptr<Shader>> shader_map;
 	std::vector<std::string> shader_directories;
-	std::mutex shader_map_mutex;
+	std::shared_mutex shader_map_mutex;
 	std::mutex shader_directories_mutex;
 	gfx::ShaderFormat shader_format;
 };
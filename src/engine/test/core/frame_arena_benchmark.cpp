@@ -0,0 +1,154 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+#include "engine/memory/frame_arena.hpp"
+#include "engine/containers/small_vector.hpp"
+#include "engine/containers/inline_function.hpp"
+
+using namespace ze;
+
+/**
+ * Frame-transient containers: std::vector against FrameVector and SmallVector, std::function against InlineFunction
+ * A frame mimics what RenderGraph::execute and Device::submit_queue build: a handful of small vectors per render pass
+ * The mallocs_per_frame counter counts global operator new calls
+ */
+
+thread_local size_t global_new_count = 0;
+
+void* operator new(size_t in_size)
+{
+	global_new_count++;
+	if (void* memory = std::malloc(in_size))
+		return memory;
+
+	std::abort();
+}
+
+void operator delete(void* in_ptr) noexcept
+{
+	std::free(in_ptr);
+}
+
+void operator delete(void* in_ptr, size_t) noexcept
+{
+	std::free(in_ptr);
+}
+
+static constexpr size_t passes_per_frame = 16;
+static constexpr size_t attachments_per_pass = 4;
+
+template<typename MakeVector>
+void build_frame(MakeVector&& in_make_vector)
+{
+	for (size_t pass = 0; pass < passes_per_frame; ++pass)
+	{
+		auto clear_values = in_make_vector.template operator()<uint64_t>();
+		auto color_attachments = in_make_vector.template operator()<uint64_t>();
+		auto color_attachments_refs = in_make_vector.template operator()<uint32_t>();
+		auto flushs = in_make_vector.template operator()<uint64_t>();
+
+		for (size_t i = 0; i < attachments_per_pass; ++i)
+		{
+			clear_values.emplace_back(i);
+			color_attachments.emplace_back(i);
+			color_attachments_refs.emplace_back(static_cast<uint32_t>(i));
+			flushs.emplace_back(i);
+		}
+
+		benchmark::DoNotOptimize(clear_values.data());
+		benchmark::DoNotOptimize(color_attachments.data());
+		benchmark::DoNotOptimize(color_attachments_refs.data());
+		benchmark::DoNotOptimize(flushs.data());
+	}
+
+	auto wait_semaphores = in_make_vector.template operator()<uint64_t>();
+	auto signal_semaphores = in_make_vector.template operator()<uint64_t>();
+	auto cmds = in_make_vector.template operator()<uint64_t>();
+	wait_semaphores.emplace_back(0);
+	signal_semaphores.emplace_back(0);
+	cmds.emplace_back(0);
+	benchmark::DoNotOptimize(cmds.data());
+}
+
+static void BM_FrameTransientStdVector(benchmark::State& state)
+{
+	const size_t new_count = global_new_count;
+	for (auto _ : state)
+	{
+		build_frame([]<typename T>() { return std::vector<T>(); });
+	}
+	state.counters["mallocs_per_frame"] = static_cast<double>(global_new_count - new_count) / static_cast<double>(state.iterations());
+}
+
+static void BM_FrameTransientFrameArena(benchmark::State& state)
+{
+	FrameArena arena;
+	FrameMemoryResource resource(arena);
+
+	const size_t new_count = global_new_count;
+	for (auto _ : state)
+	{
+		arena.reset();
+		build_frame([&]<typename T>() { return FrameVector<T>(&resource); });
+	}
+	state.counters["mallocs_per_frame"] = static_cast<double>(global_new_count - new_count) / static_cast<double>(state.iterations());
+	state.counters["used_bytes"] = static_cast<double>(arena.get_used_bytes());
+}
+
+static void BM_FrameTransientSmallVector(benchmark::State& state)
+{
+	const size_t new_count = global_new_count;
+	for (auto _ : state)
+	{
+		build_frame([]<typename T>() { return SmallVector<T, attachments_per_pass>(); });
+	}
+	state.counters["mallocs_per_frame"] = static_cast<double>(global_new_count - new_count) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_FrameTransientStdVector);
+BENCHMARK(BM_FrameTransientFrameArena);
+BENCHMARK(BM_FrameTransientSmallVector);
+
+/**
+ * Render passes are recreated every frame with their execute callback, which usually captures a few pointers
+ */
+template<typename Function>
+void build_frame_passes()
+{
+	uint64_t a = 0, b = 0, c = 0, d = 0;
+	std::vector<Function> passes;
+	passes.reserve(passes_per_frame);
+	for (size_t pass = 0; pass < passes_per_frame; ++pass)
+		passes.emplace_back([&a, &b, &c, &d](uint64_t in_list) { a += in_list; b += a; c += b; d += c; });
+
+	for (size_t pass = 0; pass < passes_per_frame; ++pass)
+		passes[pass](pass);
+
+	benchmark::DoNotOptimize(d);
+}
+
+static void BM_FramePassesStdFunction(benchmark::State& state)
+{
+	const size_t new_count = global_new_count;
+	for (auto _ : state)
+	{
+		build_frame_passes<std::function<void(uint64_t)>>();
+	}
+	state.counters["mallocs_per_frame"] = static_cast<double>(global_new_count - new_count) / static_cast<double>(state.iterations());
+}
+
+static void BM_FramePassesInlineFunction(benchmark::State& state)
+{
+	const size_t new_count = global_new_count;
+	for (auto _ : state)
+	{
+		build_frame_passes<InlineFunction<void(uint64_t)>>();
+	}
+	state.counters["mallocs_per_frame"] = static_cast<double>(global_new_count - new_count) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_FramePassesStdFunction);
+BENCHMARK(BM_FramePassesInlineFunction);
@@ -0,0 +1,60 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "engine/hash.hpp"
+
+using namespace ze;
+
+/**
+ * Byte span hashing throughput against robin_hood's hash_bytes, and the streaming hasher overhead
+ */
+
+static std::vector<uint8_t> make_bytes(size_t in_size)
+{
+	std::vector<uint8_t> bytes(in_size);
+	for (size_t i = 0; i < in_size; ++i)
+		bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+	return bytes;
+}
+
+static void BM_HashBytes(benchmark::State& state)
+{
+	const auto bytes = make_bytes(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(hash_bytes(bytes.data(), bytes.size()));
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashBytes)->RangeMultiplier(4)->Range(16, 16 << 10);
+
+static void BM_HashBytes128(benchmark::State& state)
+{
+	const auto bytes = make_bytes(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(hash_bytes_128(bytes.data(), bytes.size()));
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashBytes128)->RangeMultiplier(4)->Range(16, 16 << 10);
+
+static void BM_RobinHoodHashBytes(benchmark::State& state)
+{
+	const auto bytes = make_bytes(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(robin_hood::hash_bytes(bytes.data(), bytes.size()));
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RobinHoodHashBytes)->RangeMultiplier(4)->Range(16, 16 << 10);
+
+/** Same input fed in 4 bytes updates, like a key built field by field */
+static void BM_HasherFields(benchmark::State& state)
+{
+	const size_t field_count = static_cast<size_t>(state.range(0)) / sizeof(uint32_t);
+	for (auto _ : state)
+	{
+		Hasher hasher;
+		for (uint32_t i = 0; i < field_count; ++i)
+			hasher.update(i);
+		benchmark::DoNotOptimize(hasher.finish());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HasherFields)->RangeMultiplier(4)->Range(16, 1024);
@@ -0,0 +1,116 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/containers/inline_function.hpp"
+#include <array>
+#include <memory>
+
+using namespace ze;
+
+namespace
+{
+
+/** Counts live instances of a callable so leaks and double destructions show up */
+template<size_t Padding>
+struct TrackedCallable
+{
+	static inline int live_count = 0;
+
+	int value;
+	std::array<std::byte, Padding> padding {};
+
+	explicit TrackedCallable(const int in_value) : value(in_value) { ++live_count; }
+	TrackedCallable(const TrackedCallable& in_other) : value(in_other.value) { ++live_count; }
+	TrackedCallable(TrackedCallable&& in_other) noexcept : value(in_other.value) { ++live_count; }
+	~TrackedCallable() { --live_count; }
+
+	int operator()(const int in_arg) const { return value + in_arg; }
+};
+
+using SmallCallable = TrackedCallable<8>;
+using LargeCallable = TrackedCallable<128>;
+
+}
+
+TEST(Core, InlineFunctionInvoke)
+{
+	InlineFunction<int(int)> function;
+	EXPECT_FALSE(function);
+
+	function = [](int in_value) { return in_value * 2; };
+	EXPECT_TRUE(function);
+	EXPECT_EQ(function(21), 42);
+
+	function = nullptr;
+	EXPECT_FALSE(function);
+
+	/** Mutable callables keep their state between calls */
+	int calls = 0;
+	InlineFunction<int()> counter = [count = 0, &calls]() mutable { ++calls; return ++count; };
+	counter();
+	EXPECT_EQ(counter(), 2);
+	EXPECT_EQ(calls, 2);
+
+	/** Move-only captures */
+	InlineFunction<int()> unique = [ptr = std::make_unique<int>(5)]() { return *ptr; };
+	EXPECT_EQ(unique(), 5);
+}
+
+TEST(Core, InlineFunctionVoidDiscardsResult)
+{
+	int calls = 0;
+	InlineFunction<void()> function = [&calls]() { return ++calls; };
+	function();
+	EXPECT_EQ(calls, 1);
+}
+
+TEST(Core, InlineFunctionInlineStorage)
+{
+	{
+		InlineFunction<int(int)> function = SmallCallable(1);
+		EXPECT_EQ(SmallCallable::live_count, 1);
+		EXPECT_EQ(function(1), 2);
+
+		/** Moving relocates the callable and destroys the source one */
+		InlineFunction<int(int)> moved(std::move(function));
+		EXPECT_FALSE(function);
+		EXPECT_EQ(SmallCallable::live_count, 1);
+		EXPECT_EQ(moved(2), 3);
+
+		function = std::move(moved);
+		EXPECT_EQ(SmallCallable::live_count, 1);
+		EXPECT_EQ(function(3), 4);
+
+		function.reset();
+		EXPECT_EQ(SmallCallable::live_count, 0);
+	}
+
+	EXPECT_EQ(SmallCallable::live_count, 0);
+}
+
+TEST(Core, InlineFunctionHeapStorage)
+{
+	{
+		InlineFunction<int(int)> function = LargeCallable(10);
+		EXPECT_EQ(LargeCallable::live_count, 1);
+		EXPECT_EQ(function(1), 11);
+
+		/** Heap callables are relocated by moving the pointer, never copied */
+		InlineFunction<int(int)> moved(std::move(function));
+		EXPECT_EQ(LargeCallable::live_count, 1);
+		EXPECT_EQ(moved(2), 12);
+
+		/** Assigning destroys the previous callable */
+		moved = LargeCallable(20);
+		EXPECT_EQ(LargeCallable::live_count, 1);
+		EXPECT_EQ(moved(2), 22);
+
+		moved = SmallCallable(30);
+		EXPECT_EQ(LargeCallable::live_count, 0);
+		EXPECT_EQ(SmallCallable::live_count, 1);
+
+		function = LargeCallable(40);
+	}
+
+	EXPECT_EQ(LargeCallable::live_count, 0);
+	EXPECT_EQ(SmallCallable::live_count, 0);
+}
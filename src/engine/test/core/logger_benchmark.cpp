@@ -0,0 +1,78 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include "engine/logger/logger.hpp"
+#include "engine/logger/deferred.hpp"
+#include "engine/logger/sink.hpp"
+
+using namespace ze;
+
+/**
+ * Cost of a log call on the producer side, immediate and deferred, the sink discards messages
+ */
+
+ZE_DEFINE_LOG_CATEGORY(benchmark);
+
+class NullSink final : public logger::Sink
+{
+public:
+	void set_pattern(const std::string&) override {}
+	void log(const logger::Message& in_message) override { benchmark::DoNotOptimize(in_message.message.size()); }
+};
+
+static void add_null_sink()
+{
+	static bool sink_added = false;
+	if (!sink_added)
+	{
+		logger::add_sink(std::make_unique<NullSink>());
+		sink_added = true;
+	}
+}
+
+static void BM_LoggerInfo(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+		add_null_sink();
+
+	const uint64_t dropped = logger::get_dropped_message_count();
+	int64_t i = 0;
+	for (auto _ : state)
+		logger::info(log_benchmark, "Compiled shader {} in {} ms", i++, 1.5f);
+
+	logger::flush();
+	state.SetItemsProcessed(state.iterations());
+	if (state.thread_index() == 0)
+		state.counters["dropped"] = static_cast<double>(logger::get_dropped_message_count() - dropped);
+}
+BENCHMARK(BM_LoggerInfo)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_LoggerDeferred(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+		add_null_sink();
+
+	const uint64_t dropped = logger::get_dropped_message_count();
+	int64_t i = 0;
+	for (auto _ : state)
+		ZE_LOG_DEFERRED(Info, log_benchmark, "Compiled shader {} in {} ms", i++, 1.5f);
+
+	logger::flush();
+	state.SetItemsProcessed(state.iterations());
+	if (state.thread_index() == 0)
+		state.counters["dropped"] = static_cast<double>(logger::get_dropped_message_count() - dropped);
+}
+BENCHMARK(BM_LoggerDeferred)->ThreadRange(1, 16)->UseRealTime();
+
+/** Category muted at runtime, the arguments must not be formatted */
+static void BM_LoggerMuted(benchmark::State& state)
+{
+	logger::set_category_level("benchmark", logger::SeverityFlagBits::Error);
+
+	int64_t i = 0;
+	for (auto _ : state)
+		logger::info(log_benchmark, "Compiled shader {} in {} ms", i++, 1.5f);
+
+	logger::set_category_level("benchmark", logger::SeverityFlagBits::Verbose);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoggerMuted);
@@ -0,0 +1,188 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/memory/tracking.hpp"
+#include "engine/logger/logger.hpp"
+#include "engine/logger/sink.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace ze;
+
+namespace
+{
+
+/** Tags only these tests account to */
+constexpr MemoryTag batching_tag = MemoryTag::RenderGraph;
+constexpr MemoryTag budget_tag = MemoryTag::Filesystem;
+
+/** Counts over budget warnings, sinks can't be removed so it is added once for every test */
+class BudgetWarningSink final : public logger::Sink
+{
+public:
+	void set_pattern(const std::string&) override {}
+
+	void log(const logger::Message& in_message) override
+	{
+		if (in_message.severity == logger::SeverityFlagBits::Warn &&
+			in_message.message.find(std::to_string(budget_tag)) != std::string::npos)
+			warning_count++;
+	}
+
+	static inline std::atomic_uint32_t warning_count = 0;
+};
+
+uint32_t get_budget_warning_count()
+{
+	static const bool sink_added = []()
+	{
+		logger::add_sink(std::make_unique<BudgetWarningSink>());
+		return true;
+	}();
+	(void) sink_added;
+
+	logger::flush();
+	return BudgetWarningSink::warning_count.load();
+}
+
+/** Run in_function on a new thread, so no counter is pending when it starts and all of them are flushed on exit */
+template<typename F>
+void run_on_new_thread(F&& in_function)
+{
+	std::thread(std::forward<F>(in_function)).join();
+}
+
+}
+
+TEST(Core, MemoryTrackingBatching)
+{
+	run_on_new_thread([]()
+	{
+		const memory::TagStats before = memory::get_stats(batching_tag);
+
+		/** Small operations stay local to the thread until flushed */
+		memory::track_allocation(batching_tag, 1000);
+		EXPECT_EQ(memory::get_stats(batching_tag).allocation_count, before.allocation_count);
+
+		memory::flush_thread_stats();
+		memory::TagStats stats = memory::get_stats(batching_tag);
+		EXPECT_EQ(stats.allocation_count, before.allocation_count + 1);
+		EXPECT_EQ(stats.current_bytes, before.current_bytes + 1000);
+
+		/** Large operations are published right away */
+		memory::track_allocation(batching_tag, 128 * 1024);
+		stats = memory::get_stats(batching_tag);
+		EXPECT_EQ(stats.allocation_count, before.allocation_count + 2);
+		EXPECT_EQ(stats.current_bytes, before.current_bytes + 1000 + 128 * 1024);
+
+		memory::track_free(batching_tag, 128 * 1024);
+		stats = memory::get_stats(batching_tag);
+		EXPECT_EQ(stats.free_count, before.free_count + 1);
+		EXPECT_EQ(stats.current_bytes, before.current_bytes + 1000);
+
+		/** So are many small ones */
+		for (size_t i = 0; i < 4096; ++i)
+			memory::track_allocation(batching_tag, 1);
+		EXPECT_GE(memory::get_stats(batching_tag).allocation_count, before.allocation_count + 2 + 3 * 1024);
+
+		/** Left pending, published when the thread exits */
+		memory::track_free(batching_tag, 1000);
+	});
+
+	const memory::TagStats stats = memory::get_stats(batching_tag);
+	run_on_new_thread([]()
+	{
+		for (size_t i = 0; i < 4096; ++i)
+			memory::track_free(batching_tag, 1);
+	});
+	EXPECT_EQ(memory::get_stats(batching_tag).free_count, stats.free_count + 4096);
+	EXPECT_EQ(memory::get_stats(batching_tag).current_bytes, stats.current_bytes - 4096);
+}
+
+TEST(Core, MemoryTrackingPeak)
+{
+	run_on_new_thread([]()
+	{
+		const memory::TagStats before = memory::get_stats(batching_tag);
+
+		memory::track_allocation(batching_tag, 256 * 1024);
+		memory::track_allocation(batching_tag, 256 * 1024);
+		memory::track_free(batching_tag, 256 * 1024);
+		memory::track_free(batching_tag, 256 * 1024);
+
+		const memory::TagStats stats = memory::get_stats(batching_tag);
+		EXPECT_EQ(stats.current_bytes, before.current_bytes);
+		EXPECT_GE(stats.peak_bytes, before.current_bytes + 512 * 1024);
+		EXPECT_GE(stats.peak_bytes, before.peak_bytes);
+	});
+}
+
+TEST(Core, MemoryTrackingBudget)
+{
+	static constexpr size_t block_size = 128 * 1024;
+
+	run_on_new_thread([]()
+	{
+		const uint32_t initial_warnings = get_budget_warning_count();
+		const size_t base_bytes = memory::get_stats(budget_tag).current_bytes;
+		memory::set_budget(budget_tag, base_bytes + block_size + block_size / 2);
+		EXPECT_EQ(memory::get_stats(budget_tag).budget_bytes, base_bytes + block_size + block_size / 2);
+
+		/** Going over warns once, staying over doesn't warn again */
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings);
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings + 1);
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings + 1);
+
+		/** Going back under re-arms the warning */
+		memory::track_free(budget_tag, block_size);
+		memory::track_free(budget_tag, block_size);
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings + 2);
+
+		/** So does setting a budget */
+		memory::set_budget(budget_tag, base_bytes + block_size);
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings + 3);
+
+		/** Without a budget nothing is reported */
+		memory::set_budget(budget_tag, 0);
+		memory::track_allocation(budget_tag, block_size);
+		EXPECT_EQ(get_budget_warning_count(), initial_warnings + 3);
+		EXPECT_EQ(memory::get_stats(budget_tag).budget_bytes, 0);
+
+		memory::track_free(budget_tag, 3 * block_size);
+	});
+}
+
+TEST(Core, MemoryTrackingScopedTag)
+{
+	run_on_new_thread([]()
+	{
+		EXPECT_EQ(memory::get_current_tag(), MemoryTag::Untagged);
+		{
+			memory::ScopedTag outer(MemoryTag::Gfx);
+			EXPECT_EQ(memory::get_current_tag(), MemoryTag::Gfx);
+			{
+				memory::ScopedTag inner(MemoryTag::Shaders);
+				EXPECT_EQ(memory::get_current_tag(), MemoryTag::Shaders);
+				{
+					memory::ScopedTag same(MemoryTag::Shaders);
+					EXPECT_EQ(memory::get_current_tag(), MemoryTag::Shaders);
+				}
+				EXPECT_EQ(memory::get_current_tag(), MemoryTag::Shaders);
+			}
+			EXPECT_EQ(memory::get_current_tag(), MemoryTag::Gfx);
+		}
+		EXPECT_EQ(memory::get_current_tag(), MemoryTag::Untagged);
+	});
+
+	/** The tag is per thread */
+	memory::ScopedTag tag(MemoryTag::Gfx);
+	run_on_new_thread([]()
+	{
+		EXPECT_EQ(memory::get_current_tag(), MemoryTag::Untagged);
+	});
+	EXPECT_EQ(memory::get_current_tag(), MemoryTag::Gfx);
+}
@@ -0,0 +1,52 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include "engine/memory/tracking.hpp"
+
+using namespace ze;
+
+/**
+ * Overhead of tagged allocations against the system allocator, and cost of the accounting alone
+ * The counters are batched per thread so contended runs should scale like the system allocator
+ */
+
+static void BM_TaggedAllocate(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		void* ptr = memory::allocate(64, 16, MemoryTag::Core);
+		benchmark::DoNotOptimize(ptr);
+		memory::deallocate(ptr, 64, 16, MemoryTag::Core);
+	}
+}
+BENCHMARK(BM_TaggedAllocate)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_SystemAllocate(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		void* ptr = ::operator new(64, std::align_val_t(16));
+		benchmark::DoNotOptimize(ptr);
+		::operator delete(ptr, std::align_val_t(16));
+	}
+}
+BENCHMARK(BM_SystemAllocate)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_TrackAllocation(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		memory::track_allocation(MemoryTag::Core, 64);
+		memory::track_free(MemoryTag::Core, 64);
+	}
+}
+BENCHMARK(BM_TrackAllocation)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ScopedTag(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		memory::ScopedTag tag(MemoryTag::Shaders);
+		benchmark::DoNotOptimize(memory::get_current_tag());
+	}
+}
+BENCHMARK(BM_ScopedTag);
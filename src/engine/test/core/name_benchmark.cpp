@@ -0,0 +1,96 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include "engine/name.hpp"
+
+using namespace ze;
+
+/**
+ * Lookups keyed by strings against lookups keyed by interned names, like shader parameters and render graph resources
+ */
+
+static const char* const parameter_names[] =
+{
+	"translate", "scale", "sampler", "texture", "offset", "element_count", "element_size", "data_offset_in_element",
+	"data_size", "threads_per_element", "upload_buffer", "dst_buffer", "work_group_count", "mip_count",
+	"work_group_offset", "global_atomic_counter", "src_texture", "mips", "inv_input_size", "backbuffer",
+};
+
+template<typename Key>
+robin_hood::unordered_map<Key, uint32_t> make_parameter_map()
+{
+	robin_hood::unordered_map<Key, uint32_t> map;
+	uint32_t offset = 0;
+	for (const char* name : parameter_names)
+		map.insert({ Key(name), offset++ * 4 });
+	return map;
+}
+
+/** Each call builds a std::string from the literal, like the old set_parameter(const std::string&) */
+static void BM_StringMapLookup(benchmark::State& state)
+{
+	const auto map = make_parameter_map<std::string>();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(map.find("global_atomic_counter"));
+		benchmark::DoNotOptimize(map.find("scale"));
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_StringMapLookup);
+
+static void BM_NameMapLookup(benchmark::State& state)
+{
+	const auto map = make_parameter_map<Name>();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(map.find(ZE_NAME("global_atomic_counter")));
+		benchmark::DoNotOptimize(map.find(ZE_NAME("scale")));
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_NameMapLookup);
+
+static void BM_StringEquality(benchmark::State& state)
+{
+	std::string left = "global_atomic_counter";
+	std::string right = "global_atomic_countes";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(left);
+		benchmark::DoNotOptimize(right);
+		benchmark::DoNotOptimize(left == right);
+	}
+}
+BENCHMARK(BM_StringEquality);
+
+static void BM_NameEquality(benchmark::State& state)
+{
+	Name left = "global_atomic_counter";
+	Name right = "global_atomic_countes";
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(left);
+		benchmark::DoNotOptimize(right);
+		benchmark::DoNotOptimize(left == right);
+	}
+}
+BENCHMARK(BM_NameEquality);
+
+/** Creating a name from a runtime string that is already interned: hash and shared lookup */
+static void BM_NameFromString(benchmark::State& state)
+{
+	const std::string string = "global_atomic_counter";
+	(void)Name(string);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Name(string));
+}
+BENCHMARK(BM_NameFromString)->ThreadRange(1, 8);
+
+static void BM_NameGetString(benchmark::State& state)
+{
+	const Name name = "global_atomic_counter";
+	for (auto _ : state)
+		benchmark::DoNotOptimize(name.get_string());
+}
+BENCHMARK(BM_NameGetString);
@@ -0,0 +1,181 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/profiling/profiler.hpp"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace ze;
+
+namespace
+{
+
+/** Zone of in_duration_ns, events of a thread are sorted by end time */
+void add_event(profiler::CaptureThread& in_thread, const uint32_t in_zone, const uint64_t in_start_ns,
+	const uint64_t in_duration_ns)
+{
+	in_thread.events.push_back({ in_zone, in_start_ns, in_start_ns + in_duration_ns });
+}
+
+}
+
+TEST(Core, ProfilerZoneStats)
+{
+	profiler::Capture capture;
+	capture.zones.push_back({ "Short", "a.cpp", 1 });
+	capture.zones.push_back({ "Long", "b.cpp", 2 });
+	capture.zones.push_back({ "Short", "c.cpp", 3 });
+	capture.zones.push_back({ "Unused", "d.cpp", 4 });
+
+	/** Short takes 1..100 ms spread over two threads, Long 1000 ms once */
+	capture.threads.resize(2);
+	profiler::CaptureThread& thread_0 = capture.threads[0];
+	profiler::CaptureThread& thread_1 = capture.threads[1];
+	for (uint64_t i = 1; i <= 100; ++i)
+		add_event(i % 2 ? thread_0 : thread_1, 0, i * 1000000000, i * 1000000);
+	add_event(thread_1, 1, 0, 1000000000);
+
+	const auto stats = profiler::compute_zone_stats(capture);
+	ASSERT_EQ(stats.size(), 2);
+
+	/** Sorted by total time, zones without events are skipped */
+	EXPECT_EQ(stats[0].name, "Short");
+	EXPECT_EQ(stats[0].count, 100);
+	EXPECT_DOUBLE_EQ(stats[0].total_ms, 5050.0);
+	EXPECT_DOUBLE_EQ(stats[0].mean_ms, 50.5);
+	EXPECT_DOUBLE_EQ(stats[0].min_ms, 1.0);
+	EXPECT_DOUBLE_EQ(stats[0].max_ms, 100.0);
+	EXPECT_DOUBLE_EQ(stats[0].p50_ms, 50.0);
+	EXPECT_DOUBLE_EQ(stats[0].p99_ms, 99.0);
+
+	EXPECT_EQ(stats[1].name, "Long");
+	EXPECT_EQ(stats[1].count, 1);
+	EXPECT_DOUBLE_EQ(stats[1].p50_ms, 1000.0);
+	EXPECT_DOUBLE_EQ(stats[1].p99_ms, 1000.0);
+
+	/** Zones sharing a name are merged */
+	add_event(thread_0, 2, 0, 200000000);
+	const auto short_stats = profiler::get_zone_stats(capture, "Short");
+	ASSERT_TRUE(short_stats);
+	EXPECT_EQ(short_stats->count, 101);
+	EXPECT_DOUBLE_EQ(short_stats->max_ms, 200.0);
+	EXPECT_DOUBLE_EQ(short_stats->p50_ms, 51.0);
+
+	EXPECT_FALSE(profiler::get_zone_stats(capture, "Unused"));
+	EXPECT_FALSE(profiler::get_zone_stats(capture, "Missing"));
+}
+
+TEST(Core, ProfilerBinaryCaptureRoundTrip)
+{
+	profiler::Capture capture;
+	capture.duration_ns = 123456789;
+	capture.dropped_events = 7;
+	capture.frame_start_ns = { 0, 16000000, 32000000 };
+	capture.zones.push_back({ "Render", "renderer.cpp", 42 });
+	capture.zones.push_back({ "Update \"world\"", "world.cpp", 7 });
+
+	capture.threads.resize(2);
+	profiler::CaptureThread& main_thread = capture.threads[0];
+	main_thread.name = "Main";
+	main_thread.id = 0;
+	add_event(main_thread, 0, 100, 5000);
+	add_event(main_thread, 1, 200, 8000);
+
+	profiler::CaptureThread& worker_thread = capture.threads[1];
+	worker_thread.name = "Worker 1";
+	worker_thread.id = 3;
+	add_event(worker_thread, 1, 50, 10);
+
+	const std::string path = (std::filesystem::temp_directory_path() / "ze_test_capture.zeprof").string();
+	ASSERT_TRUE(profiler::write_binary_capture(capture, path));
+
+	const auto read_capture = profiler::read_binary_capture(path);
+	ASSERT_TRUE(read_capture);
+	EXPECT_EQ(read_capture->duration_ns, capture.duration_ns);
+	EXPECT_EQ(read_capture->dropped_events, capture.dropped_events);
+	EXPECT_EQ(read_capture->frame_start_ns, capture.frame_start_ns);
+
+	ASSERT_EQ(read_capture->zones.size(), capture.zones.size());
+	for (size_t i = 0; i < capture.zones.size(); ++i)
+	{
+		EXPECT_EQ(read_capture->zones[i].name, capture.zones[i].name);
+		EXPECT_EQ(read_capture->zones[i].file, capture.zones[i].file);
+		EXPECT_EQ(read_capture->zones[i].line, capture.zones[i].line);
+	}
+
+	ASSERT_EQ(read_capture->threads.size(), capture.threads.size());
+	for (size_t i = 0; i < capture.threads.size(); ++i)
+	{
+		const profiler::CaptureThread& expected = capture.threads[i];
+		const profiler::CaptureThread& thread = read_capture->threads[i];
+		EXPECT_EQ(thread.name, expected.name);
+		EXPECT_EQ(thread.id, expected.id);
+		ASSERT_EQ(thread.events.size(), expected.events.size());
+		for (size_t j = 0; j < expected.events.size(); ++j)
+		{
+			EXPECT_EQ(thread.events[j].zone, expected.events[j].zone);
+			EXPECT_EQ(thread.events[j].start_ns, expected.events[j].start_ns);
+			EXPECT_EQ(thread.events[j].end_ns, expected.events[j].end_ns);
+		}
+	}
+
+	/** Truncated files are rejected */
+	const auto size = std::filesystem::file_size(path);
+	std::filesystem::resize_file(path, size - 4);
+	EXPECT_FALSE(profiler::read_binary_capture(path));
+
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "not a capture";
+	}
+	EXPECT_FALSE(profiler::read_binary_capture(path));
+
+	std::filesystem::remove(path);
+	EXPECT_FALSE(profiler::read_binary_capture(path));
+}
+
+/** A thread recording more zones than its ring buffer holds keeps the newest ones and reports the others */
+TEST(Core, ProfilerRingOverflow)
+{
+	static constexpr size_t capacity = 16;
+	static constexpr size_t zone_count = 100;
+	static constexpr profiler::ZoneDesc desc { "Overflow", __FILE__, __LINE__ };
+
+	/** Only applies to threads recording their first zone after the call */
+	profiler::set_thread_buffer_capacity(capacity - 1);
+
+	profiler::begin_capture();
+	EXPECT_TRUE(profiler::is_capturing());
+	std::thread([]()
+	{
+		for (size_t i = 0; i < zone_count; ++i)
+			profiler::ScopedZone zone(&desc);
+	}).join();
+	const profiler::Capture capture = profiler::end_capture();
+	EXPECT_FALSE(profiler::is_capturing());
+
+	size_t event_count = 0;
+	for (const profiler::CaptureThread& thread : capture.threads)
+	{
+		event_count += thread.events.size();
+		for (size_t i = 1; i < thread.events.size(); ++i)
+			EXPECT_LE(thread.events[i - 1].end_ns, thread.events[i].end_ns);
+	}
+
+	/** The oldest slot may be being overwritten so it is dropped too, every zone is either kept or dropped */
+	EXPECT_EQ(event_count, capacity - 1);
+	EXPECT_EQ(capture.dropped_events, zone_count - event_count);
+
+	const auto stats = profiler::get_zone_stats(capture, "Overflow");
+	ASSERT_TRUE(stats);
+	EXPECT_EQ(stats->count, event_count);
+
+	/** Zones recorded outside of a capture are ignored */
+	{
+		profiler::ScopedZone zone(&desc);
+	}
+	profiler::begin_capture();
+	const profiler::Capture empty_capture = profiler::end_capture();
+	EXPECT_EQ(empty_capture.dropped_events, 0);
+	EXPECT_FALSE(profiler::get_zone_stats(empty_capture, "Overflow"));
+}
@@ -0,0 +1,51 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include "engine/profiling/profiler.hpp"
+
+using namespace ze;
+
+/**
+ * Cost of a profiler zone outside of a capture (the common case) and while capturing
+ */
+
+static void BM_ZoneIdle(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		ZE_PROFILE_SCOPE("Idle zone");
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_ZoneIdle);
+
+static void BM_ZoneCapturing(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+		profiler::begin_capture();
+
+	for (auto _ : state)
+	{
+		ZE_PROFILE_SCOPE("Captured zone");
+		benchmark::ClobberMemory();
+	}
+
+	if (state.thread_index() == 0)
+		benchmark::DoNotOptimize(profiler::end_capture());
+}
+BENCHMARK(BM_ZoneCapturing)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_CollectCapture(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		profiler::begin_capture();
+		for (int64_t i = 0; i < state.range(0); ++i)
+		{
+			ZE_PROFILE_SCOPE("Collected zone");
+			benchmark::ClobberMemory();
+		}
+		benchmark::DoNotOptimize(profiler::end_capture());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CollectCapture)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,100 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/util/simple_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ze;
+
+namespace
+{
+
+struct Slot
+{
+	size_t owner;
+	size_t value;
+};
+
+}
+
+TEST(Core, SimplePool)
+{
+	UnsafeSimplePool<Slot, 8> pool;
+
+	std::vector<Slot*> slots;
+	for (size_t i = 0; i < 100; ++i)
+		slots.emplace_back(pool.allocate(0, i));
+	EXPECT_EQ(pool.get_size(), 100);
+
+	for (size_t i = 0; i < slots.size(); ++i)
+		EXPECT_EQ(slots[i]->value, i);
+
+	for (Slot* slot : slots)
+		pool.free(slot);
+	EXPECT_EQ(pool.get_size(), 0);
+
+	/** Freed slots are reused */
+	Slot* slot = pool.allocate(0, 0);
+	EXPECT_NE(std::find(slots.begin(), slots.end(), slot), slots.end());
+	pool.free(slot);
+}
+
+/** Slots are allocated on one thread and freed on another, a slot handed out twice gets overwritten by its other owner */
+TEST(Core, ThreadSafeSimplePoolConcurrentAllocateFree)
+{
+	static constexpr size_t thread_count = 4;
+	static constexpr size_t iteration_count = 500;
+	static constexpr size_t batch_size = 48;
+
+	ThreadSafeSimplePool<Slot, 16> pool;
+	std::atomic_size_t corrupted_slots = 0;
+
+	/** Batches waiting to be freed by another thread */
+	std::mutex batches_mutex;
+	std::vector<std::vector<Slot*>> batches;
+
+	std::vector<std::thread> threads;
+	for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx)
+	{
+		threads.emplace_back([&, thread_idx]()
+		{
+			for (size_t iteration = 0; iteration < iteration_count; ++iteration)
+			{
+				std::vector<Slot*> slots;
+				for (size_t i = 0; i < batch_size; ++i)
+					slots.emplace_back(pool.allocate(thread_idx, i));
+
+				for (size_t i = 0; i < batch_size; ++i)
+					if (slots[i]->owner != thread_idx || slots[i]->value != i)
+						++corrupted_slots;
+
+				std::vector<Slot*> batch_to_free;
+				{
+					std::scoped_lock lock(batches_mutex);
+					if (!batches.empty())
+					{
+						batch_to_free = std::move(batches.back());
+						batches.pop_back();
+					}
+					batches.emplace_back(std::move(slots));
+				}
+
+				for (Slot* slot : batch_to_free)
+					pool.free(slot);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	for (const auto& batch : batches)
+		for (Slot* slot : batch)
+			pool.free(slot);
+
+	EXPECT_EQ(corrupted_slots, 0);
+	EXPECT_EQ(pool.get_size(), 0);
+}
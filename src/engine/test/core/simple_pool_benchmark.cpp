@@ -0,0 +1,105 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <mutex>
+#include <vector>
+#include "engine/util/simple_pool.hpp"
+
+using namespace ze;
+
+/**
+ * Pool allocation under contention: every thread allocates a batch of objects then frees them
+ * SimplePool against a mutex-guarded free list pool (its former implementation) and the system allocator
+ */
+
+static constexpr size_t batch_size = 64;
+
+struct PoolObject
+{
+	uint64_t data[8];
+};
+
+/** Mutex and std::vector free list, as SimplePool used to be */
+class MutexPool
+{
+public:
+	PoolObject* allocate()
+	{
+		std::scoped_lock lock(mutex);
+		if (free_list.empty())
+		{
+			chunks.emplace_back(std::make_unique<PoolObject[]>(256));
+			for (size_t i = 0; i < 256; ++i)
+				free_list.emplace_back(&chunks.back()[i]);
+		}
+
+		PoolObject* object = free_list.back();
+		free_list.pop_back();
+		return object;
+	}
+
+	void free(PoolObject* in_object)
+	{
+		std::scoped_lock lock(mutex);
+		free_list.emplace_back(in_object);
+	}
+private:
+	std::mutex mutex;
+	std::vector<std::unique_ptr<PoolObject[]>> chunks;
+	std::vector<PoolObject*> free_list;
+};
+
+ThreadSafeSimplePool<PoolObject> simple_pool;
+MutexPool mutex_pool;
+
+static void BM_SimplePoolAllocFree(benchmark::State& state)
+{
+	std::array<PoolObject*, batch_size> objects;
+	for (auto _ : state)
+	{
+		for (auto& object : objects)
+			object = simple_pool.allocate();
+
+		benchmark::DoNotOptimize(objects.data());
+
+		for (auto& object : objects)
+			simple_pool.free(object);
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_MutexPoolAllocFree(benchmark::State& state)
+{
+	std::array<PoolObject*, batch_size> objects;
+	for (auto _ : state)
+	{
+		for (auto& object : objects)
+			object = mutex_pool.allocate();
+
+		benchmark::DoNotOptimize(objects.data());
+
+		for (auto& object : objects)
+			mutex_pool.free(object);
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_NewDeleteAllocFree(benchmark::State& state)
+{
+	std::array<PoolObject*, batch_size> objects;
+	for (auto _ : state)
+	{
+		for (auto& object : objects)
+			object = new PoolObject;
+
+		benchmark::DoNotOptimize(objects.data());
+
+		for (auto& object : objects)
+			delete object;
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_SimplePoolAllocFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_MutexPoolAllocFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_NewDeleteAllocFree)->ThreadRange(1, 64)->UseRealTime();
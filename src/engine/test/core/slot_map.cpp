@@ -0,0 +1,141 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/containers/slot_map.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ze;
+
+TEST(Core, SlotMap)
+{
+	SlotMap<int> map;
+
+	const SlotMapHandle a = map.emplace(1);
+	const SlotMapHandle b = map.emplace(2);
+	const SlotMapHandle c = map.emplace(3);
+	EXPECT_EQ(map.get_size(), 3);
+	EXPECT_EQ(map[a], 1);
+	EXPECT_EQ(map[b], 2);
+	EXPECT_EQ(map[c], 3);
+
+	/** Erasing swaps the last element into the hole, handles still point to their element */
+	EXPECT_TRUE(map.erase(a));
+	EXPECT_EQ(map.get_size(), 2);
+	EXPECT_EQ(map[b], 2);
+	EXPECT_EQ(map[c], 3);
+	for (size_t i = 0; i < map.get_size(); ++i)
+		EXPECT_EQ(*map.get(map.get_handle(i)), map.get_elements()[i]);
+
+	EXPECT_FALSE(map.contains(SlotMapHandle()));
+	EXPECT_EQ(map.get(SlotMapHandle()), nullptr);
+}
+
+TEST(Core, SlotMapGenerationReuse)
+{
+	SlotMap<int> map;
+
+	const SlotMapHandle first = map.emplace(1);
+	EXPECT_TRUE(map.erase(first));
+
+	/** The slot is reused with a new generation, the old handle is stale */
+	const SlotMapHandle second = map.emplace(2);
+	EXPECT_EQ(second.index, first.index);
+	EXPECT_NE(second.generation, first.generation);
+
+	EXPECT_FALSE(map.contains(first));
+	EXPECT_EQ(map.get(first), nullptr);
+	EXPECT_FALSE(map.erase(first));
+	EXPECT_EQ(map[second], 2);
+
+	/** Clearing makes every handle stale */
+	map.clear();
+	EXPECT_TRUE(map.is_empty());
+	EXPECT_FALSE(map.contains(second));
+
+	const SlotMapHandle third = map.emplace(3);
+	EXPECT_EQ(third.index, first.index);
+	EXPECT_FALSE(map.contains(second));
+	EXPECT_EQ(map[third], 3);
+
+	EXPECT_EQ(SlotMapHandle::from_u64(third.to_u64()), third);
+}
+
+TEST(Core, ThreadSafeSlotMapGenerationReuse)
+{
+	ThreadSafeSlotMap<int, 4> map;
+
+	const SlotMapHandle first = map.emplace(1);
+	EXPECT_TRUE(map.erase(first));
+
+	const SlotMapHandle second = map.emplace(2);
+	EXPECT_EQ(second.index, first.index);
+	EXPECT_NE(second.generation, first.generation);
+
+	EXPECT_FALSE(map.contains(first));
+	EXPECT_EQ(map.get(first), nullptr);
+	EXPECT_FALSE(map.erase(first));
+	ASSERT_NE(map.get(second), nullptr);
+	EXPECT_EQ(*map.get(second), 2);
+
+	/** Handles past the allocated pages are rejected */
+	EXPECT_EQ(map.get(SlotMapHandle(100, 1)), nullptr);
+	EXPECT_EQ(map.get(SlotMapHandle()), nullptr);
+}
+
+/** Each thread checks its own elements while others insert and erase theirs, pages get allocated concurrently */
+TEST(Core, ThreadSafeSlotMapConcurrentEmplaceErase)
+{
+	static constexpr size_t thread_count = 4;
+	static constexpr size_t iteration_count = 200;
+	static constexpr size_t batch_size = 64;
+
+	ThreadSafeSlotMap<size_t, 16> map;
+	std::atomic_size_t errors = 0;
+
+	std::vector<std::thread> threads;
+	for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx)
+	{
+		threads.emplace_back([&, thread_idx]()
+		{
+			std::vector<SlotMapHandle> handles;
+			std::vector<SlotMapHandle> erased_handles;
+			for (size_t iteration = 0; iteration < iteration_count; ++iteration)
+			{
+				for (size_t i = 0; i < batch_size; ++i)
+					handles.emplace_back(map.emplace(thread_idx * batch_size + i));
+
+				for (size_t i = 0; i < batch_size; ++i)
+				{
+					const size_t* element = map.get(handles[i]);
+					if (!element || *element != thread_idx * batch_size + i)
+						++errors;
+				}
+
+				/** Stale handles must stay stale even once their slot is reused by another thread */
+				for (const SlotMapHandle& handle : erased_handles)
+					if (map.contains(handle))
+						++errors;
+
+				erased_handles.clear();
+				for (const SlotMapHandle& handle : handles)
+				{
+					if (!map.erase(handle))
+						++errors;
+					erased_handles.emplace_back(handle);
+				}
+				handles.clear();
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	EXPECT_EQ(errors, 0);
+	EXPECT_TRUE(map.is_empty());
+
+	size_t visited = 0;
+	map.for_each([&](const SlotMapHandle&, size_t&) { ++visited; });
+	EXPECT_EQ(visited, 0);
+}
@@ -0,0 +1,178 @@
+#include "engine/core.hpp"
+#include <gtest/gtest.h>
+#include "engine/containers/small_vector.hpp"
+#include <string>
+
+using namespace ze;
+
+namespace
+{
+
+/** Counts live instances so leaks and double destructions show up */
+struct Tracked
+{
+	static inline int live_count = 0;
+
+	int value;
+
+	Tracked(const int in_value = 0) : value(in_value) { ++live_count; }
+	Tracked(const Tracked& in_other) : value(in_other.value) { ++live_count; }
+	Tracked(Tracked&& in_other) noexcept : value(in_other.value) { in_other.value = -1; ++live_count; }
+	~Tracked() { --live_count; }
+
+	Tracked& operator=(const Tracked&) = default;
+	Tracked& operator=(Tracked&&) noexcept = default;
+
+	bool operator==(const Tracked& in_other) const { return value == in_other.value; }
+};
+
+template<size_t N>
+SmallVector<Tracked, N> make_sequence(const int in_count)
+{
+	SmallVector<Tracked, N> vector;
+	for (int i = 0; i < in_count; ++i)
+		vector.emplace_back(i);
+	return vector;
+}
+
+}
+
+TEST(Core, SmallVectorGrowth)
+{
+	{
+		SmallVector<Tracked, 4> vector;
+		EXPECT_TRUE(vector.empty());
+		EXPECT_TRUE(vector.is_inline());
+		EXPECT_EQ(vector.capacity(), 4);
+
+		for (int i = 0; i < 4; ++i)
+			vector.emplace_back(i);
+		EXPECT_TRUE(vector.is_inline());
+
+		vector.emplace_back(4);
+		EXPECT_FALSE(vector.is_inline());
+		EXPECT_GE(vector.capacity(), 5);
+		for (int i = 0; i < 5; ++i)
+			EXPECT_EQ(vector[i].value, i);
+
+		EXPECT_EQ(Tracked::live_count, 5);
+
+		vector.pop_back();
+		EXPECT_EQ(vector.size(), 4);
+		EXPECT_EQ(vector.back().value, 3);
+		EXPECT_EQ(Tracked::live_count, 4);
+	}
+
+	EXPECT_EQ(Tracked::live_count, 0);
+}
+
+TEST(Core, SmallVectorCopy)
+{
+	{
+		const auto inline_vector = make_sequence<4>(3);
+		const auto heap_vector = make_sequence<4>(10);
+
+		SmallVector<Tracked, 4> inline_copy(inline_vector);
+		EXPECT_TRUE(inline_copy.is_inline());
+		EXPECT_EQ(inline_copy, inline_vector);
+
+		SmallVector<Tracked, 4> heap_copy(heap_vector);
+		EXPECT_FALSE(heap_copy.is_inline());
+		EXPECT_EQ(heap_copy, heap_vector);
+
+		/** Inline to heap and back */
+		inline_copy = heap_vector;
+		EXPECT_EQ(inline_copy, heap_vector);
+		heap_copy = inline_vector;
+		EXPECT_EQ(heap_copy, inline_vector);
+
+		EXPECT_EQ(Tracked::live_count, 3 + 10 + 10 + 3);
+	}
+
+	EXPECT_EQ(Tracked::live_count, 0);
+}
+
+TEST(Core, SmallVectorMove)
+{
+	{
+		/** Heap elements are stolen, the source goes back to its inline storage */
+		auto heap_vector = make_sequence<4>(10);
+		const Tracked* heap_elements = heap_vector.data();
+		SmallVector<Tracked, 4> heap_moved(std::move(heap_vector));
+		EXPECT_EQ(heap_moved.data(), heap_elements);
+		EXPECT_EQ(heap_moved.size(), 10);
+		EXPECT_TRUE(heap_vector.empty());
+		EXPECT_TRUE(heap_vector.is_inline());
+
+		/** Inline elements are moved one by one */
+		auto inline_vector = make_sequence<4>(3);
+		SmallVector<Tracked, 4> inline_moved(std::move(inline_vector));
+		EXPECT_TRUE(inline_moved.is_inline());
+		EXPECT_EQ(inline_moved, make_sequence<4>(3));
+		EXPECT_TRUE(inline_vector.empty());
+
+		/** Move-assigning inline elements into a vector that already has heap storage keeps it */
+		SmallVector<Tracked, 4> target = make_sequence<4>(8);
+		target = std::move(inline_moved);
+		EXPECT_EQ(target, make_sequence<4>(3));
+
+		/** Move-assigning heap elements frees the previous heap storage */
+		target = std::move(heap_moved);
+		EXPECT_EQ(target, make_sequence<4>(10));
+
+		EXPECT_EQ(Tracked::live_count, 10);
+	}
+
+	EXPECT_EQ(Tracked::live_count, 0);
+}
+
+TEST(Core, SmallVectorSelfReferencingEmplace)
+{
+	/** The argument refers to an element that moves when the vector grows */
+	SmallVector<std::string, 2> vector;
+	vector.emplace_back("a string long enough to not fit in the small string buffer");
+	vector.emplace_back("b");
+	vector.emplace_back(vector[0]);
+	vector.push_back(vector[1]);
+
+	ASSERT_EQ(vector.size(), 4);
+	EXPECT_FALSE(vector.is_inline());
+	EXPECT_EQ(vector[2], vector[0]);
+	EXPECT_EQ(vector[3], "b");
+
+	/** Same when resizing with one of the elements as the value */
+	vector.resize(64, vector[0]);
+	EXPECT_EQ(vector[63], vector[0]);
+}
+
+TEST(Core, SmallVectorResize)
+{
+	{
+		SmallVector<Tracked, 4> vector;
+		vector.resize(2, Tracked(7));
+		EXPECT_TRUE(vector.is_inline());
+		EXPECT_EQ(vector.size(), 2);
+		EXPECT_EQ(vector[1].value, 7);
+
+		vector.resize(9);
+		EXPECT_FALSE(vector.is_inline());
+		EXPECT_EQ(vector.size(), 9);
+		EXPECT_EQ(vector[0].value, 7);
+		EXPECT_EQ(vector[8].value, 0);
+		EXPECT_EQ(Tracked::live_count, 9);
+
+		vector.resize(1);
+		EXPECT_EQ(vector.size(), 1);
+		EXPECT_EQ(Tracked::live_count, 1);
+
+		vector.clear();
+		EXPECT_TRUE(vector.empty());
+		EXPECT_EQ(Tracked::live_count, 0);
+
+		vector.reserve(32);
+		EXPECT_GE(vector.capacity(), 32);
+		EXPECT_EQ(Tracked::live_count, 0);
+	}
+
+	EXPECT_EQ(Tracked::live_count, 0);
+}
@@ -1,7 +1,11 @@
 #include "engine/core.hpp"
 #include <gtest/gtest.h>
 #include "engine/containers/sparse_array.hpp"
+#include "engine/containers/dense_sparse_array.hpp"
 #include <robin_hood.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 using namespace ze;
 
@@ -39,3 +43,121 @@ TEST(Core, SparseArray)
 		EXPECT_EQ(pod_int[index_2_new], 2);
 	}
 }
+
+TEST(Core, SparseArrayIteration)
+{
+	SparseArray<int> array;
+	EXPECT_EQ(array.begin(), array.end());
+
+	std::vector<size_t> indices;
+	for (int i = 0; i < 200; ++i)
+		indices.emplace_back(array.emplace(i));
+
+	/** Holes at the start, across a bitset word boundary and at the end */
+	for (const size_t index : { size_t(0), size_t(1), size_t(63), size_t(64), size_t(65), size_t(199) })
+		array.remove(indices[index]);
+
+	std::vector<int> visited;
+	for (auto it = array.begin(); it != array.end(); ++it)
+	{
+		EXPECT_TRUE(array.is_valid(it.get_index()));
+		EXPECT_EQ(*it, static_cast<int>(it.get_index()));
+		visited.emplace_back(*it);
+	}
+
+	EXPECT_EQ(visited.size(), array.get_size());
+	EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+	EXPECT_EQ(visited.front(), 2);
+	EXPECT_EQ(visited.back(), 198);
+
+	/** end() is past every slot of the storage, whatever holes there are */
+	auto it = array.begin();
+	for (size_t i = 0; i < array.get_size(); ++i)
+		++it;
+	EXPECT_EQ(it, array.end());
+
+	const SparseArray<int>& const_array = array;
+	size_t const_count = 0;
+	for (const int& value : const_array)
+	{
+		EXPECT_NE(value, 0);
+		const_count++;
+	}
+	EXPECT_EQ(const_count, array.get_size());
+
+	/** Removing everything leaves an empty range */
+	for (size_t index = 0; index < array.get_capacity(); ++index)
+		if (array.is_valid(index))
+			array.remove(index);
+	EXPECT_TRUE(array.is_empty());
+	EXPECT_EQ(array.begin(), array.end());
+}
+
+TEST(Core, SparseArrayFreeList)
+{
+	SparseArray<std::string> array;
+
+	std::vector<size_t> indices;
+	for (int i = 0; i < 100; ++i)
+		indices.emplace_back(array.emplace(std::to_string(i)));
+	const size_t capacity = array.get_capacity();
+
+	/** Removed indices are reused last removed first, without growing */
+	array.remove(indices[10]);
+	array.remove(indices[50]);
+	array.remove(indices[90]);
+	EXPECT_EQ(array.emplace("a"), indices[90]);
+	EXPECT_EQ(array.emplace("b"), indices[50]);
+	EXPECT_EQ(array.emplace("c"), indices[10]);
+	EXPECT_EQ(array.get_capacity(), capacity);
+
+	/** Once the free list is empty new indices come after the used ones */
+	const size_t new_index = array.emplace("d");
+	EXPECT_EQ(new_index, indices.size());
+
+	/** Growing keeps the elements and the free list of non trivially copyable types */
+	array.remove(indices[20]);
+	array.reserve(capacity * 4);
+	EXPECT_GE(array.get_capacity(), capacity * 4);
+	EXPECT_FALSE(array.is_valid(indices[20]));
+	EXPECT_EQ(array[indices[0]], "0");
+	EXPECT_EQ(array[indices[10]], "c");
+	EXPECT_EQ(array[indices[99]], "99");
+	EXPECT_EQ(array.emplace("e"), indices[20]);
+	EXPECT_EQ(array.get_size(), 101);
+}
+
+TEST(Core, DenseSparseArray)
+{
+	DenseSparseArray<int> array;
+
+	std::vector<size_t> indices;
+	for (int i = 0; i < 10; ++i)
+		indices.emplace_back(array.emplace(i));
+
+	/** Removing swaps the last element in, indices still point to their element */
+	array.remove(indices[2]);
+	EXPECT_FALSE(array.is_valid(indices[2]));
+	EXPECT_EQ(array.get_size(), 9);
+	for (int i = 0; i < 10; ++i)
+		if (i != 2)
+			EXPECT_EQ(array[indices[i]], i);
+
+	for (size_t position = 0; position < array.get_size(); ++position)
+		EXPECT_EQ(array[array.get_index(position)], array.get_elements()[position]);
+
+	/** Iteration visits the packed elements only */
+	int sum = 0;
+	for (const int value : array)
+		sum += value;
+	EXPECT_EQ(sum, 45 - 2);
+
+	/** Free indices are reused */
+	EXPECT_EQ(array.emplace(42), indices[2]);
+	EXPECT_EQ(array[indices[2]], 42);
+
+	for (const size_t index : indices)
+		array.remove(index);
+	EXPECT_TRUE(array.is_empty());
+	EXPECT_EQ(array.begin(), array.end());
+}
@@ -0,0 +1,118 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include "engine/containers/sparse_array.hpp"
+#include "engine/containers/dense_sparse_array.hpp"
+
+using namespace ze;
+
+/**
+ * SparseArray and DenseSparseArray insertion, removal, iteration and random access
+ */
+
+struct Element
+{
+	float position[3];
+	float velocity[3];
+};
+
+std::vector<size_t> make_shuffled_indices(size_t in_count)
+{
+	std::vector<size_t> indices(in_count);
+	for (size_t i = 0; i < in_count; ++i)
+		indices[i] = i;
+
+	std::shuffle(indices.begin(), indices.end(), std::mt19937(1337));
+	return indices;
+}
+
+template<typename Array>
+void fill(Array& in_array, size_t in_count)
+{
+	for (size_t i = 0; i < in_count; ++i)
+		(void)in_array.emplace(Element { { 1.f, 2.f, 3.f }, { 0.1f, 0.2f, 0.3f } });
+}
+
+template<typename Array>
+static void run_insert(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		Array array;
+		fill(array, count);
+		benchmark::DoNotOptimize(array.get_size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Remove every element in random order */
+template<typename Array>
+static void run_remove(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	const std::vector<size_t> indices = make_shuffled_indices(count);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Array array;
+		fill(array, count);
+		state.ResumeTiming();
+
+		for (const size_t index : indices)
+			array.remove(index);
+		benchmark::DoNotOptimize(array.get_size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Iterate with half of the elements removed at random */
+template<typename Array>
+static void run_iterate(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	const std::vector<size_t> indices = make_shuffled_indices(count);
+	Array array;
+	fill(array, count);
+	for (size_t i = 0; i < count / 2; ++i)
+		array.remove(indices[i]);
+
+	for (auto _ : state)
+	{
+		for (Element& element : array)
+		{
+			element.position[0] += element.velocity[0];
+			element.position[1] += element.velocity[1];
+			element.position[2] += element.velocity[2];
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(array.get_size()));
+}
+
+template<typename Array>
+static void run_random_access(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	const std::vector<size_t> indices = make_shuffled_indices(count);
+	Array array;
+	fill(array, count);
+
+	for (auto _ : state)
+	{
+		float sum = 0.f;
+		for (const size_t index : indices)
+			sum += array[index].position[0];
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define ZE_SPARSE_ARRAY_BENCHMARK(Operation, Function) \
+	BENCHMARK_TEMPLATE(Function, SparseArray<Element>)->Name("BM_SparseArray" #Operation)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond); \
+	BENCHMARK_TEMPLATE(Function, DenseSparseArray<Element>)->Name("BM_DenseSparseArray" #Operation)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+
+ZE_SPARSE_ARRAY_BENCHMARK(Insert, run_insert)
+ZE_SPARSE_ARRAY_BENCHMARK(Remove, run_remove)
+ZE_SPARSE_ARRAY_BENCHMARK(Iterate, run_iterate)
+ZE_SPARSE_ARRAY_BENCHMARK(RandomAccess, run_random_access)
@@ -0,0 +1,145 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <unordered_map>
+#include "engine/gfx/gfx_pipeline.hpp"
+#include "engine/gfx/description_key.hpp"
+
+using namespace ze;
+using namespace ze::gfx;
+
+/**
+ * Lookup cost of the pipeline cache (Device::get_or_create_gfx_pipeline) with 10k cached pipelines
+ * The device needs a backend so the lookup path is reproduced here: build the key, then find it
+ * Compared against the previous cache, keyed by the create info with a per-field hash_combine and a deep compare
+ */
+
+static constexpr size_t pipeline_count = 10000;
+
+struct PipelineSet
+{
+	std::vector<std::array<PipelineShaderStage, 2>> stages;
+	std::vector<PipelineColorBlendAttachmentState> blend_attachments;
+	std::vector<GfxPipelineCreateInfo> create_infos;
+
+	PipelineSet() : blend_attachments(1)
+	{
+		stages.reserve(pipeline_count);
+		create_infos.reserve(pipeline_count);
+		for (size_t i = 0; i < pipeline_count; ++i)
+		{
+			stages.push_back({ PipelineShaderStage(ShaderStageFlagBits::Vertex, 1000 + i % 100, "main"),
+				PipelineShaderStage(ShaderStageFlagBits::Fragment, 2000 + i / 100, "main") });
+
+			create_infos.emplace_back(stages.back(),
+				PipelineVertexInputStateCreateInfo({ VertexInputBindingDescription(0, 32, VertexInputRate::Vertex) },
+					{ VertexInputAttributeDescription(0, 0, Format::R32G32B32Sfloat, 0),
+						VertexInputAttributeDescription(1, 0, Format::R32G32B32Sfloat, 12),
+						VertexInputAttributeDescription(2, 0, Format::R32G32Sfloat, 24) }),
+				PipelineInputAssemblyStateCreateInfo(),
+				PipelineRasterizationStateCreateInfo(PolygonMode::Fill, i % 2 ? CullMode::Back : CullMode::None),
+				PipelineMultisamplingStateCreateInfo(),
+				PipelineDepthStencilStateCreateInfo(true, true, CompareOp::Less),
+				PipelineColorBlendStateCreateInfo(false, LogicOp::NoOp, blend_attachments),
+				BackendDeviceResource(1),
+				BackendDeviceResource(1 + i % 4),
+				0);
+		}
+	}
+};
+
+static const PipelineSet& get_pipeline_set()
+{
+	static PipelineSet set;
+	return set;
+}
+
+/** Previous std::hash<GfxPipelineCreateInfo> */
+struct FieldPipelineHash
+{
+	size_t operator()(const GfxPipelineCreateInfo& in_create_info) const noexcept
+	{
+		size_t hash = in_create_info.subpass;
+		for (const auto& stage : in_create_info.shader_stages)
+		{
+			hash_combine(hash, stage.shader_stage);
+			hash_combine(hash, stage.shader);
+			hash_combine(hash, stage.entry_point);
+		}
+
+		for (const auto& binding : in_create_info.vertex_input_state.input_binding_descriptions)
+		{
+			hash_combine(hash, binding.binding);
+			hash_combine(hash, binding.input_rate);
+			hash_combine(hash, binding.stride);
+		}
+
+		for (const auto& attribute : in_create_info.vertex_input_state.input_attribute_descriptions)
+		{
+			hash_combine(hash, attribute.binding);
+			hash_combine(hash, attribute.location);
+			hash_combine(hash, attribute.format);
+			hash_combine(hash, attribute.offset);
+		}
+
+		hash_combine(hash, in_create_info.input_assembly_state.primitive_topology);
+		hash_combine(hash, in_create_info.multisampling_state.samples);
+		hash_combine(hash, in_create_info.rasterization_state.polygon_mode);
+		hash_combine(hash, in_create_info.rasterization_state.cull_mode);
+		hash_combine(hash, in_create_info.depth_stencil_state.enable_depth_test);
+		hash_combine(hash, in_create_info.depth_stencil_state.depth_compare_op);
+		hash_combine(hash, in_create_info.pipeline_layout);
+		hash_combine(hash, in_create_info.render_pass);
+		return hash;
+	}
+};
+
+static void BM_PipelineCacheLookup(benchmark::State& state)
+{
+	const auto& set = get_pipeline_set();
+
+	DescriptionMap<BackendDeviceResource> pipelines;
+	for (size_t i = 0; i < set.create_infos.size(); ++i)
+	{
+		DescriptionKeyBuilder key_builder;
+		pipelines.emplace(DescriptionKey(build_description_key(key_builder, set.create_infos[i])), i);
+	}
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		DescriptionKeyBuilder key_builder;
+		const DescriptionKeyView key = build_description_key(key_builder, set.create_infos[i]);
+		benchmark::DoNotOptimize(pipelines.find(key)->second);
+		i = (i + 7919) % set.create_infos.size();
+	}
+}
+BENCHMARK(BM_PipelineCacheLookup);
+
+static void BM_PipelineCacheLookupFieldHash(benchmark::State& state)
+{
+	const auto& set = get_pipeline_set();
+
+	std::unordered_map<GfxPipelineCreateInfo, BackendDeviceResource, FieldPipelineHash> pipelines;
+	for (size_t i = 0; i < set.create_infos.size(); ++i)
+		pipelines.insert({ set.create_infos[i], i });
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(pipelines.find(set.create_infos[i])->second);
+		i = (i + 7919) % set.create_infos.size();
+	}
+}
+BENCHMARK(BM_PipelineCacheLookupFieldHash);
+
+/** Key building alone */
+static void BM_PipelineKeyBuild(benchmark::State& state)
+{
+	const auto& set = get_pipeline_set();
+	for (auto _ : state)
+	{
+		DescriptionKeyBuilder key_builder;
+		benchmark::DoNotOptimize(build_description_key(key_builder, set.create_infos[0]).hash);
+	}
+}
+BENCHMARK(BM_PipelineKeyBuild);
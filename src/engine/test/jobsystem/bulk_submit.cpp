@@ -0,0 +1,58 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include "engine/jobsystem/job.hpp"
+
+using namespace ze;
+
+/**
+ * Submission latency of many fine-grained jobs, one schedule() per job against Job::schedule_bulk
+ * Only the submission is timed, waiting for the jobs to finish is excluded
+ */
+
+void empty_submit_job(jobsystem::Job&) {}
+
+template<bool Bulk>
+static void run_submit(benchmark::State& state)
+{
+	const size_t job_count = static_cast<size_t>(state.range(0));
+	std::vector<jobsystem::Job*> jobs(job_count);
+	for (auto _ : state)
+	{
+		jobsystem::Counter counter;
+		for (auto& job : jobs)
+		{
+			job = jobsystem::new_job(&empty_submit_job, jobsystem::JobType::Normal);
+			job->signal_on_finish(counter);
+		}
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		if constexpr (Bulk)
+		{
+			jobsystem::Job::schedule_bulk(jobs);
+		}
+		else
+		{
+			for (auto& job : jobs)
+				job->schedule();
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+		state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+		counter.wait();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SubmitSingle(benchmark::State& state)
+{
+	run_submit<false>(state);
+}
+
+static void BM_SubmitBulk(benchmark::State& state)
+{
+	run_submit<true>(state);
+}
+
+BENCHMARK(BM_SubmitSingle)->Arg(1000)->Arg(10000)->Arg(100000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubmitBulk)->Arg(1000)->Arg(10000)->Arg(100000)->UseManualTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/job_group.hpp"
+#include "engine/jobsystem/job_graph.hpp"
+#include <array>
+#include <atomic>
+#include <vector>
+
+using namespace ze::jobsystem;
+
+namespace
+{
+
+/** Spawns the workers for the duration of a test */
+struct ScopedJobSystem
+{
+	ScopedJobSystem() { initialize(); }
+	~ScopedJobSystem() { shutdown(); }
+};
+
+}
+
+TEST(JobSystem, JobDependencies)
+{
+	ScopedJobSystem jobsystem;
+
+	for (size_t iteration = 0; iteration < 200; ++iteration)
+	{
+		std::atomic_uint32_t step = 0;
+		std::atomic_bool out_of_order = false;
+		Counter counter;
+
+		/** Scheduled in reverse order, each job still waits for its predecessor */
+		Job* first = new_job([&](Job&) { out_of_order = out_of_order || step++ != 0; }, JobType::Normal);
+		Job* second = new_job([&](Job&) { out_of_order = out_of_order || step++ != 1; }, JobType::Normal);
+		Job* third = new_job([&](Job&) { out_of_order = out_of_order || step++ != 2; }, JobType::Normal);
+		second->depends_on(*first);
+		third->depends_on(*second);
+		third->signal_on_finish(counter);
+		third->schedule();
+		second->schedule();
+		first->schedule();
+
+		counter.wait();
+		EXPECT_TRUE(counter.is_zero());
+		EXPECT_EQ(step, 3);
+		EXPECT_FALSE(out_of_order);
+	}
+}
+
+TEST(JobSystem, JobGroupSuccessors)
+{
+	static constexpr uint32_t job_count = 64;
+	static constexpr uint32_t successor_count = 32;
+
+	ScopedJobSystem jobsystem;
+
+	for (size_t iteration = 0; iteration < 100; ++iteration)
+	{
+		JobGroup group;
+		Counter successors_counter;
+		std::atomic_uint32_t executed_count = 0;
+		std::atomic_uint32_t early_count = 0;
+
+		for (uint32_t i = 0; i < job_count; ++i)
+			group.add(new_job([&](Job&) { executed_count++; }, JobType::Normal));
+
+		/** Successors are released once, after every job of the group finished */
+		for (uint32_t i = 0; i < successor_count; ++i)
+		{
+			Job* successor = new_job([&](Job&)
+			{
+				if (executed_count != job_count)
+					early_count++;
+			}, JobType::Normal);
+			successor->depends_on(group.get_counter());
+			successor->signal_on_finish(successors_counter);
+			successor->schedule();
+		}
+		EXPECT_EQ(successors_counter.get_value(), successor_count);
+
+		group.schedule_and_wait();
+		successors_counter.wait();
+		EXPECT_EQ(executed_count, job_count);
+		EXPECT_EQ(early_count, 0);
+	}
+}
+
+/** A counter incremented again right as it reaches zero (e.g a reused JobGroup) must hold back its new successors */
+TEST(JobSystem, CounterReuse)
+{
+	static constexpr uint32_t job_count = 8;
+
+	ScopedJobSystem jobsystem;
+
+	Counter counter;
+	for (size_t iteration = 0; iteration < 2000; ++iteration)
+	{
+		Counter successor_counter;
+		std::atomic_uint32_t decremented_count = 0;
+		std::atomic_bool released_early = false;
+
+		counter.increment(job_count);
+		Job* successor = new_job([&](Job&) { released_early = decremented_count != job_count; }, JobType::Normal);
+		successor->depends_on(counter);
+		successor->signal_on_finish(successor_counter);
+		successor->schedule();
+
+		for (uint32_t i = 0; i < job_count; ++i)
+		{
+			new_job([&](Job&)
+			{
+				decremented_count++;
+				counter.decrement();
+			}, JobType::Normal)->schedule();
+		}
+
+		successor_counter.wait();
+		EXPECT_FALSE(released_early);
+	}
+
+	counter.wait();
+	EXPECT_EQ(counter.get_value(), 0);
+}
+
+TEST(JobSystem, JobGraphDiamond)
+{
+	ScopedJobSystem jobsystem;
+
+	JobGraph graph;
+	std::array<std::atomic_uint32_t, 4> order;
+	std::atomic_uint32_t clock = 0;
+	const JobGraph::NodeIndex top = graph.add([&]() { order[0] = clock++; });
+	const JobGraph::NodeIndex left = graph.add([&]() { order[1] = clock++; });
+	const JobGraph::NodeIndex right = graph.add([&]() { order[2] = clock++; });
+	const JobGraph::NodeIndex bottom = graph.add([&]() { order[3] = clock++; });
+	graph.add_dependency(left, top);
+	graph.add_dependency(right, top);
+	graph.add_dependency(bottom, left);
+	graph.add_dependency(bottom, right);
+	EXPECT_EQ(graph.get_node_count(), 4);
+	EXPECT_FALSE(graph.is_running());
+
+	/** Submitted again and again like a frame graph */
+	for (size_t frame = 0; frame < 1000; ++frame)
+	{
+		clock = 0;
+		graph.submit_and_wait();
+		EXPECT_FALSE(graph.is_running());
+		EXPECT_EQ(clock, 4);
+		EXPECT_LT(order[0], order[1]);
+		EXPECT_LT(order[0], order[2]);
+		EXPECT_LT(order[1], order[3]);
+		EXPECT_LT(order[2], order[3]);
+	}
+
+	/** Jobs can wait for the whole graph */
+	std::atomic_bool graph_finished = false;
+	Counter counter;
+	Job* successor = new_job([&](Job&) { graph_finished = clock == 4; }, JobType::Normal);
+	successor->signal_on_finish(counter);
+	clock = 0;
+	graph.submit();
+	successor->depends_on(graph.get_counter());
+	successor->schedule();
+	counter.wait();
+	graph.wait();
+	EXPECT_TRUE(graph_finished);
+}
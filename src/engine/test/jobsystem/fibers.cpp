@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/job_group.hpp"
+#include <atomic>
+
+using namespace ze::jobsystem;
+
+namespace
+{
+
+/** Spawns the workers in fiber mode for the duration of a test */
+struct ScopedFiberJobSystem
+{
+	ScopedFiberJobSystem()
+	{
+		InitializeInfo info;
+		info.execution_mode = ExecutionMode::Fibers;
+		initialize(info);
+	}
+
+	~ScopedFiberJobSystem() { shutdown(); }
+};
+
+/** Every non-leaf job suspends its fiber until both of its children finished */
+void spawn_tree(const uint32_t in_depth, std::atomic_uint32_t& in_leaf_count, Counter& in_counter)
+{
+	Job* job = new_job([in_depth, &in_leaf_count](Job&)
+	{
+		if (in_depth == 0)
+		{
+			in_leaf_count++;
+			return;
+		}
+
+		Counter children;
+		spawn_tree(in_depth - 1, in_leaf_count, children);
+		spawn_tree(in_depth - 1, in_leaf_count, children);
+		children.wait();
+	}, JobType::Normal);
+	job->signal_on_finish(in_counter);
+	job->schedule();
+}
+
+}
+
+TEST(JobSystem, FiberNestedWaits)
+{
+	static constexpr uint32_t depth = 12;
+
+	ScopedFiberJobSystem jobsystem;
+	EXPECT_EQ(get_execution_mode(), ExecutionMode::Fibers);
+
+	for (size_t iteration = 0; iteration < 4; ++iteration)
+	{
+		std::atomic_uint32_t leaf_count = 0;
+		Counter counter;
+		spawn_tree(depth, leaf_count, counter);
+
+		/** Non-worker threads sleep until the counter reaches zero */
+		counter.wait();
+		EXPECT_EQ(leaf_count, 1U << depth);
+	}
+}
+
+/** A job waiting on something only another thread can signal must not keep other jobs from running */
+TEST(JobSystem, FiberWaitOnExternalSignal)
+{
+	static constexpr uint32_t job_count = 256;
+
+	ScopedFiberJobSystem jobsystem;
+
+	Counter external_signal(1);
+	Counter waiting_counter;
+	std::atomic_bool resumed = false;
+	Job* waiting_job = new_job([&](Job&)
+	{
+		external_signal.wait();
+		resumed = true;
+	}, JobType::Normal);
+	waiting_job->signal_on_finish(waiting_counter);
+	waiting_job->schedule();
+
+	JobGroup group;
+	std::atomic_uint32_t executed_count = 0;
+	for (uint32_t i = 0; i < job_count; ++i)
+		group.add(new_job([&](Job&) { executed_count++; }, JobType::Normal));
+	group.schedule_and_wait();
+	EXPECT_EQ(executed_count, job_count);
+	EXPECT_FALSE(resumed);
+
+	external_signal.decrement();
+	waiting_counter.wait();
+	EXPECT_TRUE(resumed);
+}
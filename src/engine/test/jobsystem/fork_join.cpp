@@ -0,0 +1,101 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+
+using namespace ze;
+
+/**
+ * Deep recursive fork/join: fib(n) with one job per call, each job waiting on its two childs
+ * Compares thread mode (waiting workers execute other jobs on top of their stack)
+ * against fiber mode (waiting jobs suspend their fiber)
+ */
+
+struct FibData
+{
+	uint32_t n;
+	uint64_t* result;
+};
+
+uint64_t fib_serial(uint32_t in_n)
+{
+	return in_n < 2 ? in_n : fib_serial(in_n - 1) + fib_serial(in_n - 2);
+}
+
+void fib_job(jobsystem::Job& in_job)
+{
+	const FibData data = *in_job.get_userdata<FibData>();
+	if (data.n < 2)
+	{
+		*data.result = data.n;
+		return;
+	}
+
+	uint64_t left = 0;
+	uint64_t right = 0;
+	jobsystem::Counter counter;
+
+	jobsystem::Job* left_job = jobsystem::new_job<FibData>(&fib_job, jobsystem::JobType::Normal,
+		jobsystem::JobPriority::Normal, data.n - 1, &left);
+	jobsystem::Job* right_job = jobsystem::new_job<FibData>(&fib_job, jobsystem::JobType::Normal,
+		jobsystem::JobPriority::Normal, data.n - 2, &right);
+	left_job->signal_on_finish(counter);
+	right_job->signal_on_finish(counter);
+	left_job->schedule();
+	right_job->schedule();
+
+	counter.wait();
+	*data.result = left + right;
+}
+
+static void BM_FibSerial(benchmark::State& state)
+{
+	for (auto _ : state)
+		benchmark::DoNotOptimize(fib_serial(static_cast<uint32_t>(state.range(0))));
+}
+
+static void run_fib_jobs(benchmark::State& state, jobsystem::ExecutionMode in_mode)
+{
+	/** Restart the job system in the requested mode, restored to the default mode afterwards */
+	jobsystem::shutdown();
+	jobsystem::InitializeInfo info;
+	info.execution_mode = in_mode;
+	jobsystem::initialize(info);
+
+	const uint32_t n = static_cast<uint32_t>(state.range(0));
+	const uint64_t expected = fib_serial(n);
+	for (auto _ : state)
+	{
+		uint64_t result = 0;
+		jobsystem::Counter counter;
+		jobsystem::Job* root = jobsystem::new_job<FibData>(&fib_job, jobsystem::JobType::Normal,
+			jobsystem::JobPriority::Normal, n, &result);
+		root->signal_on_finish(counter);
+		root->schedule();
+		counter.wait();
+
+		if (result != expected)
+			state.SkipWithError("Wrong fib result");
+	}
+
+	/** fib(n) spawns 2 * fib(n + 1) - 1 jobs */
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(2 * fib_serial(n + 1) - 1));
+
+	jobsystem::shutdown();
+	jobsystem::initialize();
+}
+
+static void BM_FibJobsThreads(benchmark::State& state)
+{
+	run_fib_jobs(state, jobsystem::ExecutionMode::Threads);
+}
+
+static void BM_FibJobsFibers(benchmark::State& state)
+{
+	run_fib_jobs(state, jobsystem::ExecutionMode::Fibers);
+}
+
+BENCHMARK(BM_FibSerial)->Arg(20)->Arg(25)->Arg(30)->Unit(benchmark::kMillisecond);
+/** Deeper runs overflow the stack in thread mode, waiting threads nest stolen jobs on top of each other */
+BENCHMARK(BM_FibJobsThreads)->Arg(20)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_FibJobsFibers)->Arg(20)->Arg(25)->Arg(30)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,81 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <array>
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/util/simple_pool.hpp"
+
+using namespace ze;
+
+/**
+ * Job allocation: a global thread-safe SimplePool against per-thread job arenas,
+ * then the whole allocate/schedule/execute/free path through the job system
+ */
+
+static constexpr size_t batch_size = 64;
+
+void empty_job(jobsystem::Job&) {}
+
+struct CounterJobData
+{
+	jobsystem::Counter* counter;
+};
+
+void counter_job(jobsystem::Job& in_job)
+{
+	in_job.get_userdata<CounterJobData>()->counter->decrement();
+}
+
+SimplePool<jobsystem::Job, 256, true> global_job_pool;
+
+static void BM_AllocFreeGlobalPool(benchmark::State& state)
+{
+	std::array<jobsystem::Job*, batch_size> jobs;
+	for (auto _ : state)
+	{
+		for (auto& job : jobs)
+			job = global_job_pool.allocate(&empty_job, jobsystem::JobType::Normal, jobsystem::JobPriority::Normal);
+
+		for (auto& job : jobs)
+			global_job_pool.free(job);
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_AllocFreeJobArena(benchmark::State& state)
+{
+	std::array<jobsystem::Job*, batch_size> jobs;
+	for (auto _ : state)
+	{
+		for (auto& job : jobs)
+			job = jobsystem::new_job(&empty_job, jobsystem::JobType::Normal);
+
+		for (auto& job : jobs)
+			jobsystem::detail::free_job(job);
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+/**
+ * Jobs are allocated by the calling thread and freed by whichever thread executed them
+ * The counter is incremented once for the whole batch, so jobs finishing early can't bring it back to zero
+ */
+static void BM_JobThroughput(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		jobsystem::Counter counter;
+		counter.increment(batch_size);
+		for (size_t i = 0; i < batch_size; ++i)
+		{
+			jobsystem::new_job<CounterJobData>(&counter_job, jobsystem::JobType::Normal,
+				jobsystem::JobPriority::Normal, &counter)->schedule();
+		}
+		counter.wait();
+	}
+	state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_AllocFreeGlobalPool)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_AllocFreeJobArena)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_JobThroughput)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,17 @@
+#include <benchmark/benchmark.h>
+#include "engine/jobsystem/jobsystem.hpp"
+
+int main(int argc, char** argv)
+{
+	/** Arguments are checked first, workers must be shut down before exiting or their static storage never joins */
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	ze::jobsystem::initialize();
+	benchmark::RunSpecifiedBenchmarks();
+	ze::jobsystem::shutdown();
+
+	benchmark::Shutdown();
+	return 0;
+}
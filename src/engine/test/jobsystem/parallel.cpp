@@ -0,0 +1,143 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include "engine/jobsystem/parallel.hpp"
+
+using namespace ze;
+
+/**
+ * parallel_for/parallel_reduce/parallel_sort against a serial loop and a naive one-job-per-element fan-out
+ */
+
+static constexpr size_t grain_size = 1024;
+
+/** Emulate a transform update */
+float process_element(float in_value)
+{
+	return std::sqrt(in_value * in_value + 1.f) * 0.5f;
+}
+
+std::vector<float> make_elements(size_t in_count)
+{
+	std::vector<float> elements(in_count);
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> distribution(0.f, 1000.f);
+	for (auto& element : elements)
+		element = distribution(rng);
+	return elements;
+}
+
+static void BM_ForSerial(benchmark::State& state)
+{
+	auto elements = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		for (auto& element : elements)
+			element = process_element(element);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ForNaiveJobPerElement(benchmark::State& state)
+{
+	auto elements = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		std::atomic_size_t remaining = elements.size();
+		for (auto& element : elements)
+		{
+			float* ptr = &element;
+			std::atomic_size_t* remaining_ptr = &remaining;
+			jobsystem::new_job([ptr, remaining_ptr](jobsystem::Job&)
+			{
+				*ptr = process_element(*ptr);
+				remaining_ptr->fetch_sub(1, std::memory_order_release);
+			}, jobsystem::JobType::Normal)->schedule();
+		}
+
+		while (remaining.load(std::memory_order_acquire) > 0)
+			if (!jobsystem::try_execute_one_job())
+				std::this_thread::yield();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelFor(benchmark::State& state)
+{
+	auto elements = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		jobsystem::parallel_for(0, elements.size(), grain_size, [&](size_t in_index)
+		{
+			elements[in_index] = process_element(elements[in_index]);
+		});
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ReduceSerial(benchmark::State& state)
+{
+	const auto elements = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+		for (const auto& element : elements)
+			sum += process_element(element);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelReduce(benchmark::State& state)
+{
+	const auto elements = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		const double sum = jobsystem::parallel_reduce(0, elements.size(), grain_size, 0.0,
+			[&](const jobsystem::IndexRange& in_range, double in_sum)
+			{
+				for (size_t i = in_range.begin; i < in_range.end; ++i)
+					in_sum += process_element(elements[i]);
+				return in_sum;
+			},
+			[](double in_left, double in_right) { return in_left + in_right; });
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SortSerial(benchmark::State& state)
+{
+	const auto source = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto elements = source;
+		state.ResumeTiming();
+		std::sort(elements.begin(), elements.end());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelSort(benchmark::State& state)
+{
+	const auto source = make_elements(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto elements = source;
+		state.ResumeTiming();
+		jobsystem::parallel_sort(std::span<float>(elements));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ForSerial)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ForNaiveJobPerElement)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_ParallelFor)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_ReduceSerial)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelReduce)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_SortSerial)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelSort)->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "engine/jobsystem/parker.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace ze::jobsystem;
+
+namespace
+{
+
+template<typename Predicate>
+void wait_until(Predicate&& in_predicate)
+{
+	while (!in_predicate())
+		std::this_thread::yield();
+}
+
+}
+
+TEST(JobSystem, ParkerAbort)
+{
+	Parker parker;
+	parker.initialize(1);
+
+	/** Work showing up while parking cancels it */
+	EXPECT_FALSE(parker.park(0, []() { return true; }));
+	EXPECT_EQ(parker.get_stats().parks, 0);
+	EXPECT_EQ(parker.get_stats().wakeups, 0);
+}
+
+TEST(JobSystem, ParkerUnpark)
+{
+	static constexpr size_t worker_count = 4;
+
+	Parker parker;
+	parker.initialize(worker_count);
+
+	std::atomic_size_t woken_count = 0;
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < worker_count; ++i)
+	{
+		workers.emplace_back([&, i]()
+		{
+			if (parker.park(i, []() { return false; }))
+				woken_count++;
+		});
+	}
+	wait_until([&]() { return parker.get_stats().parks == worker_count; });
+
+	/** Only the requested number of workers wake up */
+	parker.unpark(1);
+	wait_until([&]() { return woken_count == 1; });
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_EQ(woken_count, 1);
+
+	parker.unpark(2);
+	wait_until([&]() { return woken_count == 3; });
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_EQ(woken_count, 3);
+
+	parker.unpark(worker_count);
+	for (auto& worker : workers)
+		worker.join();
+
+	EXPECT_EQ(woken_count, worker_count);
+	const ParkingStats stats = parker.get_stats();
+	EXPECT_EQ(stats.parks, worker_count);
+	EXPECT_EQ(stats.wakeups, worker_count);
+}
+
+/** A job published while the worker parks must either abort the park or wake it, otherwise this never finishes */
+TEST(JobSystem, ParkerNoLostWakeup)
+{
+	static constexpr size_t job_count = 20000;
+
+	Parker parker;
+	parker.initialize(1);
+
+	std::atomic_bool has_job = false;
+	std::thread worker([&]()
+	{
+		size_t executed_count = 0;
+		while (executed_count < job_count)
+		{
+			if (has_job.exchange(false))
+				executed_count++;
+			else
+				parker.park(0, [&]() { return has_job.load(); });
+		}
+	});
+
+	for (size_t i = 0; i < job_count; ++i)
+	{
+		wait_until([&]() { return !has_job; });
+		has_job = true;
+		parker.unpark(1);
+	}
+
+	worker.join();
+	EXPECT_LE(parker.get_stats().wakeups, job_count);
+}
@@ -0,0 +1,68 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "engine/hal/thread.hpp"
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/parallel.hpp"
+
+using namespace ze;
+
+/**
+ * Scaling of a cache-sensitive parallel_for with the worker count, with and without pinning workers to cores
+ * Each worker gets a slice sized to stay in its L2, unpinned workers migrating between cores lose it
+ */
+
+static constexpr size_t slice_size = 128 * 1024 / sizeof(float);
+static constexpr size_t passes = 16;
+
+static void run_pinning(benchmark::State& state, const bool in_pin)
+{
+	const size_t worker_count = static_cast<size_t>(state.range(0));
+	if (worker_count > hal::get_logical_core_count())
+	{
+		state.SkipWithError("Not enough cores");
+		return;
+	}
+
+	/**
+	 * Core 0 is reserved for the benchmark thread in both configurations, so the workers get the same cores
+	 * and only pinning differs
+	 */
+	jobsystem::InitializeInfo info;
+	info.worker_count = worker_count;
+	info.pin_workers = in_pin;
+	info.reserved_cores = worker_count < hal::get_logical_core_count() ? 1 : 0;
+
+	jobsystem::shutdown();
+	jobsystem::initialize(info);
+
+	std::vector<float> elements(slice_size * worker_count, 1.f);
+	for (auto _ : state)
+	{
+		jobsystem::parallel_for(0, worker_count, 1, [&](size_t in_slice)
+		{
+			float* slice = elements.data() + in_slice * slice_size;
+			for (size_t pass = 0; pass < passes; ++pass)
+				for (size_t i = 0; i < slice_size; ++i)
+					slice[i] = std::sqrt(slice[i] * slice[i] + 1.f) * 0.5f;
+		});
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(elements.size() * passes));
+
+	jobsystem::shutdown();
+	jobsystem::initialize();
+}
+
+static void BM_ScalingUnpinned(benchmark::State& state)
+{
+	run_pinning(state, false);
+}
+
+static void BM_ScalingPinned(benchmark::State& state)
+{
+	run_pinning(state, true);
+}
+
+BENCHMARK(BM_ScalingUnpinned)->RangeMultiplier(2)->Range(1, 64)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ScalingPinned)->RangeMultiplier(2)->Range(1, 64)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "engine/jobsystem/jobsystem.hpp"
+#include "engine/jobsystem/job.hpp"
+#include "engine/jobsystem/task.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace ze::jobsystem;
+
+namespace
+{
+
+/** Spawns the workers for the duration of a test */
+struct ScopedJobSystem
+{
+	ScopedJobSystem() { initialize(); }
+	~ScopedJobSystem() { shutdown(); }
+};
+
+Task<int> double_on_worker(const int in_value)
+{
+	co_await schedule_on_worker();
+	co_return in_value * 2;
+}
+
+Task<std::unique_ptr<int>> make_unique_int(const int in_value)
+{
+	co_return std::make_unique<int>(in_value);
+}
+
+Task<> increment(std::atomic_uint32_t& in_value)
+{
+	in_value++;
+	co_return;
+}
+
+/** Both halves run in parallel, 2^depth leaves */
+Task<uint32_t> count_leaves(const uint32_t in_depth)
+{
+	if (in_depth == 0)
+		co_return 1;
+
+	Task<uint32_t> left = count_leaves(in_depth - 1);
+	Task<uint32_t> right = count_leaves(in_depth - 1);
+	co_await when_all(left, right);
+	co_return left.get_result() + right.get_result();
+}
+
+}
+
+TEST(JobSystem, TaskAwait)
+{
+	ScopedJobSystem jobsystem;
+
+	const int result = sync_wait([]() -> Task<int>
+	{
+		const int doubled = co_await double_on_worker(21);
+		const std::unique_ptr<int> pointer = co_await make_unique_int(5);
+
+		std::atomic_uint32_t counter = 0;
+		co_await increment(counter);
+		co_await increment(counter);
+		co_return doubled + *pointer + static_cast<int>(counter);
+	}());
+	EXPECT_EQ(result, 49);
+
+	/** Waiting on an lvalue task keeps its result in the task */
+	Task<int> task = double_on_worker(4);
+	EXPECT_FALSE(task.is_done());
+	int& value = sync_wait(task);
+	EXPECT_TRUE(task.is_done());
+	EXPECT_EQ(value, 8);
+	EXPECT_EQ(&value, &task.get_result());
+}
+
+TEST(JobSystem, TaskWhenAll)
+{
+	static constexpr int task_count = 100;
+
+	ScopedJobSystem jobsystem;
+
+	for (size_t iteration = 0; iteration < 20; ++iteration)
+	{
+		EXPECT_EQ(sync_wait(count_leaves(10)), 1024);
+
+		const int sum = sync_wait([]() -> Task<int>
+		{
+			std::vector<Task<int>> tasks;
+			for (int i = 0; i < task_count; ++i)
+				tasks.emplace_back(double_on_worker(i));
+			co_await when_all(tasks);
+
+			int sum = 0;
+			for (auto& task : tasks)
+				sum += task.get_result();
+			co_return sum;
+		}());
+		EXPECT_EQ(sum, task_count * (task_count - 1));
+	}
+}
+
+TEST(JobSystem, TaskWaitUntil)
+{
+	ScopedJobSystem jobsystem;
+
+	std::atomic_bool ready = false;
+	const uint32_t poll_count = sync_wait([](std::atomic_bool& in_ready) -> Task<uint32_t>
+	{
+		/** Polled until a job scheduled by the predicate itself sets the flag */
+		uint32_t poll_count = 0;
+		co_await wait_until([&]()
+		{
+			if (poll_count++ == 3)
+				new_job([&in_ready](Job&) { in_ready = true; }, JobType::Normal)->schedule();
+			return in_ready.load();
+		});
+		co_return poll_count;
+	}(ready));
+	EXPECT_TRUE(ready);
+	EXPECT_GT(poll_count, 3);
+}
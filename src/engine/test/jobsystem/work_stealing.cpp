@@ -0,0 +1,192 @@
+#include "engine/core.hpp"
+#include <benchmark/benchmark.h>
+#include <barrier>
+#include <thread>
+#include <vector>
+#include "concurrentqueue/concurrentqueue.h"
+#include "engine/jobsystem/work_stealing_deque.hpp"
+#include "engine/random.hpp"
+
+using namespace ze;
+
+/**
+ * Compare the previous scheduling policy (one moodycamel queue per worker, a single random steal then yield)
+ * against Chase-Lev deques with round-robin stealing, on a fan-out-heavy workload
+ * Each job of depth D spawns `fan_out` jobs of depth D - 1 on the worker executing it, every root job is spawned on worker 0
+ */
+
+static constexpr uint32_t fan_out = 8;
+static constexpr uint32_t depth = 5;
+static constexpr uint32_t root_jobs = 4;
+
+struct StealStats
+{
+	alignas(std::hardware_destructive_interference_size) std::atomic_uint64_t attempts;
+	std::atomic_uint64_t successes;
+};
+
+uint64_t get_total_job_count()
+{
+	uint64_t total = 0;
+	uint64_t level = root_jobs;
+	for (uint32_t i = 0; i <= depth; ++i)
+	{
+		total += level;
+		level *= fan_out;
+	}
+	return total;
+}
+
+/** Simulate a bit of work so stealing has something to compete with */
+void do_job_work(uint32_t in_depth)
+{
+	uint32_t value = in_depth;
+	for (uint32_t i = 0; i < 64; ++i)
+		benchmark::DoNotOptimize(value = value * 1664525 + 1013904223);
+}
+
+template<typename Queue, typename PushFunc, typename PopFunc, typename StealFunc>
+void run_workload(benchmark::State& state, PushFunc push, PopFunc pop, StealFunc steal)
+{
+	const size_t worker_count = static_cast<size_t>(state.range(0));
+	const uint64_t total_jobs = get_total_job_count();
+
+	uint64_t steal_attempts = 0;
+	uint64_t steal_successes = 0;
+
+	for (auto _ : state)
+	{
+		std::vector<std::unique_ptr<Queue>> queues;
+		for (size_t i = 0; i < worker_count; ++i)
+			queues.emplace_back(std::make_unique<Queue>());
+
+		std::vector<StealStats> stats(worker_count);
+		std::atomic_uint64_t remaining_jobs = total_jobs;
+		std::barrier start_barrier(static_cast<ptrdiff_t>(worker_count + 1));
+		std::vector<std::thread> threads;
+
+		for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx)
+		{
+			threads.emplace_back([&, worker_idx]()
+			{
+				Queue& queue = *queues[worker_idx];
+				if (worker_idx == 0)
+				{
+					for (uint32_t i = 0; i < root_jobs; ++i)
+						push(queue, depth);
+				}
+
+				start_barrier.arrive_and_wait();
+
+				while (remaining_jobs.load(std::memory_order_relaxed) > 0)
+				{
+					uint32_t job_depth = 0;
+					if (!pop(queue, job_depth))
+					{
+						stats[worker_idx].attempts.fetch_add(1, std::memory_order_relaxed);
+						if (!steal(queues, worker_idx, job_depth))
+							continue;
+
+						stats[worker_idx].successes.fetch_add(1, std::memory_order_relaxed);
+					}
+
+					do_job_work(job_depth);
+					if (job_depth > 0)
+					{
+						for (uint32_t i = 0; i < fan_out; ++i)
+							push(queue, job_depth - 1);
+					}
+
+					remaining_jobs.fetch_sub(1, std::memory_order_relaxed);
+				}
+			});
+		}
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		start_barrier.arrive_and_wait();
+		for (auto& thread : threads)
+			thread.join();
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+		for (const auto& stat : stats)
+		{
+			steal_attempts += stat.attempts;
+			steal_successes += stat.successes;
+		}
+	}
+
+	state.counters["jobs"] = benchmark::Counter(static_cast<double>(total_jobs * state.iterations()),
+		benchmark::Counter::kIsRate);
+	state.counters["steal_attempts"] = benchmark::Counter(static_cast<double>(steal_attempts),
+		benchmark::Counter::kAvgIterations);
+	state.counters["steal_success_rate"] = steal_attempts > 0 ?
+		static_cast<double>(steal_successes) / static_cast<double>(steal_attempts) : 0.0;
+}
+
+static void BM_LegacyRandomSteal(benchmark::State& state)
+{
+	using Queue = moodycamel::ConcurrentQueue<uint32_t>;
+
+	run_workload<Queue>(state,
+		[](Queue& queue, uint32_t job) { queue.enqueue(job); },
+		[](Queue& queue, uint32_t& job) { return queue.try_dequeue(job); },
+		[](std::vector<std::unique_ptr<Queue>>& queues, size_t thief_idx, uint32_t& job)
+		{
+			const auto victim_idx = random_SM64<size_t>(0, queues.size() - 1);
+			if (victim_idx != thief_idx && queues[victim_idx]->try_dequeue(job))
+				return true;
+
+			std::this_thread::yield();
+			return false;
+		});
+}
+
+thread_local uint64_t rng_state = 0;
+
+static void BM_ChaseLevRoundRobinSteal(benchmark::State& state)
+{
+	using Queue = jobsystem::WorkStealingDeque<uint32_t>;
+
+	run_workload<Queue>(state,
+		[](Queue& queue, uint32_t job) { queue.push(job); },
+		[](Queue& queue, uint32_t& job)
+		{
+			if (auto popped_job = queue.pop())
+			{
+				job = *popped_job;
+				return true;
+			}
+			return false;
+		},
+		[](std::vector<std::unique_ptr<Queue>>& queues, size_t thief_idx, uint32_t& job)
+		{
+			if (rng_state == 0)
+				rng_state = detail::random_SM64() | 1;
+			rng_state ^= rng_state << 13;
+			rng_state ^= rng_state >> 7;
+			rng_state ^= rng_state << 17;
+
+			const size_t start = rng_state % queues.size();
+			for (size_t i = 0; i < queues.size(); ++i)
+			{
+				const size_t victim_idx = (start + i) % queues.size();
+				if (victim_idx == thief_idx)
+					continue;
+
+				if (auto stolen_job = queues[victim_idx]->steal())
+				{
+					job = *stolen_job;
+					return true;
+				}
+			}
+
+			/** Every victim was empty, the real worker would go to sleep here */
+			std::this_thread::yield();
+			return false;
+		});
+}
+
+BENCHMARK(BM_LegacyRandomSteal)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ChaseLevRoundRobinSteal)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseManualTime()->Unit(benchmark::kMillisecond);
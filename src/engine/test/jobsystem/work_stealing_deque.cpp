@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "engine/jobsystem/work_stealing_deque.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ze::jobsystem;
+
+TEST(JobSystem, WorkStealingDequeOwner)
+{
+	WorkStealingDeque<size_t> deque(4);
+	EXPECT_TRUE(deque.is_empty());
+	EXPECT_FALSE(deque.pop());
+	EXPECT_FALSE(deque.steal());
+
+	/** Pushing past the capacity grows the buffer */
+	for (size_t i = 0; i < 100; ++i)
+		deque.push(i);
+	EXPECT_EQ(deque.get_size(), 100);
+
+	/** The owner pops the newest elements, thieves steal the oldest ones */
+	EXPECT_EQ(deque.pop(), 99);
+	EXPECT_EQ(deque.steal(), 0);
+	EXPECT_EQ(deque.steal(), 1);
+	EXPECT_EQ(deque.pop(), 98);
+	EXPECT_EQ(deque.get_size(), 96);
+
+	for (size_t i = 97; i > 1; --i)
+		EXPECT_EQ(deque.pop(), i);
+	EXPECT_TRUE(deque.is_empty());
+	EXPECT_FALSE(deque.pop());
+	EXPECT_FALSE(deque.steal());
+}
+
+/** The owner pushes and pops while thieves steal, every element must be taken exactly once */
+TEST(JobSystem, WorkStealingDequeConcurrentSteal)
+{
+	static constexpr size_t thief_count = 3;
+	static constexpr size_t element_count = 200000;
+
+	WorkStealingDeque<size_t> deque(16);
+	std::vector<std::atomic_uint32_t> taken(element_count);
+	std::atomic_bool owner_done = false;
+
+	std::vector<std::thread> thieves;
+	for (size_t i = 0; i < thief_count; ++i)
+	{
+		thieves.emplace_back([&]()
+		{
+			while (!owner_done || !deque.is_empty())
+			{
+				if (const auto element = deque.steal())
+					taken[*element]++;
+				else
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	for (size_t i = 0; i < element_count; ++i)
+	{
+		deque.push(i);
+
+		/** Pop one element every other push, so the last element is regularly raced against thieves */
+		if (i % 2)
+			if (const auto element = deque.pop())
+				taken[*element]++;
+	}
+
+	while (const auto element = deque.pop())
+		taken[*element]++;
+	owner_done = true;
+
+	for (auto& thief : thieves)
+		thief.join();
+
+	size_t wrong_count = 0;
+	for (const auto& count : taken)
+		if (count != 1)
+			wrong_count++;
+	EXPECT_EQ(wrong_count, 0);
+}
@@ -3,6 +3,7 @@
 #include "vulkan.hpp"
 #include "vulkan_backend.hpp"
 #include "engine/module/module_manager.hpp"
+#include "engine/logger/deferred.hpp"
 
 namespace ze::gfx
 {
@@ -38,16 +39,20 @@ Result<std::unique_ptr<Backend>, std::string> VulkanBackendModule::create_vulkan
 
 				const auto type = vkb::to_string_message_type(message_type);
 
+				/**
+				 * Validation can report many messages per frame from the rendering threads, they are formatted on the
+				 * logger thread. Errors are logged immediately so they are visible when breaking
+				 */
 				switch (message_severity)
 				{
 				default:
-					logger::verbose(log_vulkan, "[{}] {}", type, callback_data->pMessage);
+					ZE_LOG_DEFERRED(Verbose, log_vulkan, "[{}] {}", type, callback_data->pMessage);
 					break;
 				case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-					logger::info(log_vulkan, "[{}] {}", type, callback_data->pMessage);
+					ZE_LOG_DEFERRED(Info, log_vulkan, "[{}] {}", type, callback_data->pMessage);
 					break;
 				case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-					logger::warn(log_vulkan, "[{}] {}", type, callback_data->pMessage);
+					ZE_LOG_DEFERRED(Warn, log_vulkan, "[{}] {}", type, callback_data->pMessage);
 					break;
 				case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
 					logger::error(log_vulkan, "[{}] {}", type, callback_data->pMessage);
@@ -11,6 +11,7 @@
 #include "vulkan_texture_view.hpp"
 #include "vulkan_sync.hpp"
 #include "vulkan_sampler.hpp"
+#include "engine/memory/frame_arena.hpp"
 
 namespace ze::gfx
 {
@@ -35,7 +36,7 @@ VulkanDevice::VmaAllocatorWrapper::~VmaAllocatorWrapper()
 /** FramebufferManager */
 void VulkanDevice::FramebufferManager::new_frame()
 {
-	std::vector<Framebuffer> expired_framebuffers;
+	FrameVector<Framebuffer> expired_framebuffers(get_frame_memory_resource());
 	for(auto& it : framebuffers)
 	{
 		it.second.unpolled_frames++;
@@ -546,7 +547,7 @@ Result<BackendDeviceResource, GfxResult> VulkanDevice::create_render_pass(const
 			in_dst.layout = convert_texture_layout(in_src.layout);
 		};
 		
-		auto process_attachment_reference_multiple = [](const std::vector<AttachmentReference>& in_src,
+		auto process_attachment_reference_multiple = [](const std::span<const AttachmentReference>& in_src,
 			std::vector<VkAttachmentReference>& in_dst)
 		{
 			in_dst.reserve(in_src.size());
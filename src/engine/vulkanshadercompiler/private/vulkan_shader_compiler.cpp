@@ -30,7 +30,8 @@ public:
 		if (!ppIncludeSource)
 			return E_INVALIDARG;
 
-		auto& filesystem = get_module<filesystem::Module>("FileSystem")->get_filesystem();
+		static constinit ModuleRef<filesystem::Module> filesystem_module("FileSystem");
+		auto& filesystem = filesystem_module->get_filesystem();
 		const std::string file_name = boost::locale::conv::utf_to_utf<char, wchar_t>(pFilename);
 		if(auto file = filesystem.read("assets/shaders/" + file_name))
 		{
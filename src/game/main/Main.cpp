@@ -2,33 +2,85 @@
 #include "engine/logger/logger.hpp"
 #include "engine/logger/sinks/stdout_sink.hpp"
 #include "engine/module/module_manager.hpp"
+#include "engine/module_loading.hpp"
 #include "boost/locale/generator.hpp"
 #include "engine/filesystem/filesystem_module.hpp"
 #include "engine/filesystem/filesystem.hpp"
 #include "engine/filesystem/std_mount_point.hpp"
 #include "engine/hal/thread.hpp"
 #include "engine/jobsystem/jobsystem.hpp"
+#include "engine/profiling/profiler.hpp"
+#include "engine/profiling/boot_timeline.hpp"
+#include <array>
+#include <charconv>
 #include "engine/engine.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
 	using namespace ze;
 
+	boot::begin();
+
 	hal::set_thread_name(std::this_thread::get_id(), "Main Thread");
 
 	logger::set_pattern("[{time}] [{severity}/{thread}] ({category}) {message}");
 	logger::add_sink(std::make_unique<logger::StdoutSink>());
 
+	/** e.g. --log=warn,vulkan=verbose --profile-frames=300 --boot-report=boot.json */
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		if (arg.starts_with("--log=") && !logger::parse_levels(arg.substr(6)))
+			logger::warn("Invalid log levels \"{}\"", arg.substr(6));
+
+		if (arg.starts_with("--profile-frames="))
+		{
+			const std::string_view value = arg.substr(17);
+			uint32_t frame_count = 0;
+			if (std::from_chars(value.data(), value.data() + value.size(), frame_count).ec == std::errc() && frame_count != 0)
+				profiler::request_frame_capture(frame_count);
+			else
+				logger::warn("Invalid profiled frame count \"{}\"", value);
+		}
+
+		if (arg.starts_with("--boot-report="))
+			boot::set_report_path(std::string(arg.substr(14)));
+	}
+
 	const boost::locale::generator generator;
 	const std::locale locale = generator.generate("");
 	std::locale::global(locale);
 
-	auto& filesystem = get_module<filesystem::Module>("FileSystem")->get_filesystem();
-	filesystem.mount(std::make_unique<filesystem::StdMountPoint>(std::filesystem::current_path(), "main"));
+	/** Mounted before loading the other modules, they may read files when constructed */
+	{
+		ZE_BOOT_PHASE("Mount filesystem");
+		auto& filesystem = get_module<filesystem::Module>("FileSystem")->get_filesystem();
+		filesystem.mount(std::make_unique<filesystem::StdMountPoint>(std::filesystem::current_path(), "main"));
+	}
+
+	{
+		ZE_BOOT_PHASE("Initialize job system");
+		jobsystem::initialize();
+	}
 
-	jobsystem::initialize();
+	/**
+	 * Modules that don't depend on each other are loaded in parallel
+	 * GfxUtils creates resources when loaded so it is loaded by the engine once the device is created
+	 */
+	{
+		ZE_BOOT_PHASE("Load modules");
+		const std::array startup_modules =
+		{
+			ModuleDesc { "Application", {} },
+			ModuleDesc { "VulkanShaderCompiler", { "FileSystem" } },
+			ModuleDesc { "VulkanGfx", { "VulkanShaderCompiler" } },
+		};
+
+		if (!load_modules_parallel(startup_modules))
+			logger::error("Failed to load startup modules");
+	}
 
-	load_module("Application");
+	log_module_load_times();
 
 	{
 		Engine engine;
@@ -37,6 +89,7 @@ int main()
 
 	jobsystem::shutdown();
 	unload_all_modules();
+	logger::shutdown();
 
 	return 0;
 }
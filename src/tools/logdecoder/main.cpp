@@ -0,0 +1,173 @@
+#include "engine/logger/logger.hpp"
+#include "engine/logger/binary_log.hpp"
+#include "engine/logger/deferred.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Prints the records of a binary log written by ze::logger::open_binary_log
+ * Usage: logdecoder <file> [pattern]
+ */
+
+using namespace ze;
+
+struct Format
+{
+	logger::SeverityFlagBits severity;
+	std::string category;
+	std::string format;
+	std::vector<logger::DeferredArgType> arg_types;
+};
+
+class Reader
+{
+public:
+	Reader(const std::vector<uint8_t>& in_data) : data(in_data), offset(0) {}
+
+	template<typename T>
+	bool read(T& out_value)
+	{
+		if (data.size() - offset < sizeof(T))
+			return false;
+
+		std::memcpy(&out_value, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	template<typename Size>
+	bool read_string(std::string& out_string)
+	{
+		Size size = 0;
+		if (!read(size) || data.size() - offset < size)
+			return false;
+
+		out_string.assign(reinterpret_cast<const char*>(data.data() + offset), size);
+		offset += size;
+		return true;
+	}
+
+	bool read_bytes(size_t in_size, std::span<const uint8_t>& out_bytes)
+	{
+		if (data.size() - offset < in_size)
+			return false;
+
+		out_bytes = std::span<const uint8_t>(data.data() + offset, in_size);
+		offset += in_size;
+		return true;
+	}
+
+	[[nodiscard]] bool is_at_end() const { return offset == data.size(); }
+	[[nodiscard]] size_t get_offset() const { return offset; }
+private:
+	const std::vector<uint8_t>& data;
+	size_t offset;
+};
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <file> [pattern]\n", argv[0]);
+		return 1;
+	}
+
+	const std::string pattern = argc > 2 ? argv[2] : "[{time}] [{severity}/{thread}] ({category}) {message}";
+
+	std::ifstream file(argv[1], std::ios::binary);
+	if (!file.is_open())
+	{
+		std::fprintf(stderr, "Failed to open %s\n", argv[1]);
+		return 1;
+	}
+
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	Reader reader(data);
+
+	char magic[sizeof(logger::binary_log_magic)];
+	uint32_t version = 0;
+	if (!reader.read(magic) || std::memcmp(magic, logger::binary_log_magic, sizeof(magic)) != 0 ||
+		!reader.read(version) || version != logger::binary_log_version)
+	{
+		std::fprintf(stderr, "%s is not a binary log or has an unsupported version\n", argv[1]);
+		return 1;
+	}
+
+	std::unordered_map<uint32_t, Format> formats;
+	std::unordered_map<uint32_t, std::string> threads;
+	logger::Message message;
+	while (!reader.is_at_end())
+	{
+		const size_t entry_offset = reader.get_offset();
+		logger::BinaryLogEntryKind kind {};
+		uint32_t id = 0;
+		bool valid = reader.read(kind) && reader.read(id);
+
+		switch (kind)
+		{
+		case logger::BinaryLogEntryKind::Format:
+		{
+			Format& format = formats[id];
+			uint8_t arg_count = 0;
+			valid = valid && reader.read(format.severity) && reader.read_string<uint16_t>(format.category) &&
+				reader.read_string<uint32_t>(format.format) && reader.read(arg_count);
+
+			std::span<const uint8_t> arg_types;
+			valid = valid && reader.read_bytes(arg_count, arg_types);
+			if (valid)
+				for (const uint8_t type : arg_types)
+					format.arg_types.emplace_back(static_cast<logger::DeferredArgType>(type));
+			break;
+		}
+		case logger::BinaryLogEntryKind::Thread:
+			valid = valid && reader.read_string<uint16_t>(threads[id]);
+			break;
+		case logger::BinaryLogEntryKind::Record:
+		{
+			uint32_t thread_id = 0;
+			int64_t time_ns = 0;
+			uint32_t size = 0;
+			std::span<const uint8_t> args;
+			valid = valid && reader.read(thread_id) && reader.read(time_ns) && reader.read(size) &&
+				reader.read_bytes(size, args);
+			if (!valid)
+				break;
+
+			auto format = formats.find(id);
+			if (format == formats.end() ||
+				!logger::detail::format_deferred(format->second.format, format->second.arg_types, args, message.message))
+			{
+				std::fprintf(stderr, "Invalid record at offset %zu\n", entry_offset);
+				continue;
+			}
+
+			message.time = std::chrono::system_clock::time_point(
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(time_ns)));
+			message.thread_name = threads[thread_id];
+			message.severity = format->second.severity;
+			message.category = logger::Category(format->second.category);
+
+			const std::string line = logger::detail::format_message(pattern, message);
+			std::fwrite(line.data(), 1, line.size(), stdout);
+			std::fputc('\n', stdout);
+			break;
+		}
+		default:
+			valid = false;
+			break;
+		}
+
+		if (!valid)
+		{
+			/** The last entry may be truncated if the program crashed while writing it */
+			std::fprintf(stderr, "Truncated or corrupted entry at offset %zu\n", entry_offset);
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,53 @@
+#include "engine/profiling/profiler.hpp"
+#include <cstdio>
+
+/**
+ * Prints the zone statistics of a binary capture written by ze::profiler::write_binary_capture
+ * and optionally converts it to a Chrome trace
+ * Usage: profconverter <capture> [trace.json]
+ */
+
+using namespace ze;
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <capture> [trace.json]\n", argv[0]);
+		return 1;
+	}
+
+	const std::optional<profiler::Capture> capture = profiler::read_binary_capture(argv[1]);
+	if (!capture)
+	{
+		std::fprintf(stderr, "Failed to read %s, or it isn't a binary capture of a supported version\n", argv[1]);
+		return 1;
+	}
+
+	std::printf("%.3f ms, %zu frames, %zu threads, %llu zones dropped\n",
+		static_cast<double>(capture->duration_ns) / 1e6,
+		capture->frame_start_ns.size(),
+		capture->threads.size(),
+		static_cast<unsigned long long>(capture->dropped_events));
+
+	std::printf("%-40s %10s %12s %10s %10s %10s %10s\n", "Zone", "Count", "Total (ms)", "Mean", "P50", "P99", "Max");
+	for (const profiler::ZoneStats& stats : profiler::compute_zone_stats(*capture))
+	{
+		std::printf("%-40s %10llu %12.3f %10.4f %10.4f %10.4f %10.4f\n",
+			stats.name.c_str(),
+			static_cast<unsigned long long>(stats.count),
+			stats.total_ms,
+			stats.mean_ms,
+			stats.p50_ms,
+			stats.p99_ms,
+			stats.max_ms);
+	}
+
+	if (argc > 2 && !profiler::write_chrome_trace(*capture, argv[2]))
+	{
+		std::fprintf(stderr, "Failed to write %s\n", argv[2]);
+		return 1;
+	}
+
+	return 0;
+}
@@ -23,3 +23,4 @@ vcpkg install assimp:x64-windows
 vcpkg install directxtex:x64-windows
 vcpkg install tracy:x64-windows
 vcpkg install concurrentqueue:x64-windows
+vcpkg install xxhash:x64-windows